@@ -86,6 +86,8 @@ typedef struct {
 
   // CG gather-scatter info
   hlong *globalIds;
+  int connectNodesRounds[2];   // exchange rounds of the halo and sort global node numbering
+  double connectNodesTime[2];  // and their set up times (0 if not run)
   hlong *maskedGlobalIds;
   void *gsh, *hostGsh; // gslib struct pointer
   ogs_t *ogs; //occa gs pointer
@@ -602,13 +604,20 @@ typedef struct {
 // serial sort
 void mysort(hlong *data, int N, const char *order);
 
-// sort entries in an array in parallel
+// sort entries in an array in parallel (sample sort)
 void parallelSort(int size, int rank, MPI_Comm comm,
 		  int N, void *vv, size_t sz,
 		  int (*compare)(const void *, const void *),
 		  void (*match)(void *, void *)
 		  );
 
+// odd-even merge sort with the same contract, kept for comparison
+void parallelOddEvenSort(int size, int rank, MPI_Comm comm,
+		  int N, void *vv, size_t sz,
+		  int (*compare)(const void *, const void *),
+		  void (*match)(void *, void *)
+		  );
+
 #define mymax(a,b) (((a)>(b))?(a):(b))
 #define mymin(a,b) (((a)<(b))?(a):(b))
 
@@ -624,6 +633,12 @@ void meshParallelConnect(mesh_t *mesh);
 /* build global connectivity in parallel */
 void meshParallelConnectNodes(mesh_t *mesh);
 
+// global node numbering variants: repeated halo exchanges, or one bucketed exchange of node keys
+#define MESH_CONNECT_NODES_HALO 0
+#define MESH_CONNECT_NODES_SORT 1
+void meshParallelConnectNodesHalo(mesh_t *mesh);
+void meshParallelConnectNodesSort(mesh_t *mesh);
+
 void meshHaloSetup(mesh_t *mesh);
 
 /* extract whole elements for the halo exchange */
@@ -649,9 +664,13 @@ void meshPartitionStatistics(mesh_t *mesh);
 // build element-boundary connectivity
 void meshConnectBoundary(mesh_t *mesh);
 
+// read this rank's slice of a native binary (.bmsh) mesh, returns 0 if fileName
+// is not a binary mesh so the caller can fall back to its gmsh parser
+int meshParallelReaderBinary(mesh_t *mesh, char *fileName, int elementType, int faceType);
+
 void meshParallelGatherScatterSetup(mesh_t *mesh,
                                       dlong N,
-                                      dlong *globalIds,
+                                      hlong *globalIds,
                                       MPI_Comm &comm,
                                       int verbose);
 
@@ -701,6 +720,9 @@ extern "C"
 void readDfloatArray(FILE *fp, const char *label, dfloat **A, int *Nrows, int* Ncols);
 void readIntArray   (FILE *fp, const char *label, int **A   , int *Nrows, int* Ncols);
 
+// open a reference node file read once by rank 0 of comm and broadcast (collective on comm)
+FILE *meshOpenReferenceFile(const char *fileName, MPI_Comm comm);
+
 void meshApplyElementMatrix(mesh_t *mesh, dfloat *A, dfloat *q, dfloat *Aq);
 
 void matrixInverse(int N, dfloat *A);
@@ -708,6 +730,14 @@ dfloat matrixConditionNumber(int N, dfloat *A);
 
 void occaDeviceConfig(mesh_t *mesh, setupAide &newOptions);
 
+// two round kernel build: the build ranks compile into the OCCA cache in round 0,
+// the remaining ranks load the cached binaries in round 1
+#define occaKernelBuildRounds 2
+void occaKernelBuildSetup(mesh_t *mesh, setupAide &options);
+int  occaKernelBuildTurn(mesh_t *mesh, int round);
+void occaKernelBuildDone(mesh_t *mesh, int round);
+void occaKernelBuildReport(mesh_t *mesh);
+
 void *occaHostMallocPinned(occa::device &device, size_t size, void *source, occa::memory &mem);
 
 #endif
@@ -79,6 +79,7 @@ void meshSurfaceGeometricFactorsQuad2D(mesh2D *mesh);
 void meshPhysicalNodesTri2D(mesh2D *mesh);
 void meshPhysicalNodesQuad2D(mesh2D *mesh);
 
+// collective on mesh->comm: every rank of mesh->comm loads the same degrees in the same order
 void meshLoadReferenceNodesTri2D(mesh2D *mesh, int N);
 void meshLoadReferenceNodesQuad2D(mesh2D *mesh, int N);
 
@@ -80,6 +80,7 @@ void meshPhysicalNodesQuad3D(mesh3D *mesh);
 void meshPhysicalNodesTet3D(mesh3D *mesh);
 void meshPhysicalNodesHex3D(mesh3D *mesh);
 
+// collective on mesh->comm: every rank of mesh->comm loads the same degrees in the same order
 void meshLoadReferenceNodesTet3D(mesh3D *mesh, int N);
 void meshLoadReferenceNodesHex3D(mesh3D *mesh, int N);
 
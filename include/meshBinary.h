@@ -0,0 +1,75 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Native binary mesh format (.bmsh), written by utilities/meshConverter.
+
+  The file is a fixed header followed by two sections. All integers are
+  int64_t and all coordinates double, in the writer's byte order:
+
+  [meshBinaryHeader_t]
+  [element records]   Nelements x { tag, v[Nverts], xyz[Nverts][3] }
+  [boundary records]  NboundaryFaces x { tag, v[NfaceVertices] }
+
+  Vertex ids are 0-based and kept in gmsh order. Inverted 2D triangles and
+  quadrilaterals are flipped on read, as the gmsh readers do. Each element
+  record carries its own vertex coordinates, so a rank only has to read the
+  contiguous slice of element records it owns plus the (surface sized)
+  boundary section.
+*/
+
+#ifndef MESHBINARY_H
+#define MESHBINARY_H 1
+
+#include <stdint.h>
+
+#define MESH_BINARY_MAGIC   "LPMSHBIN"
+#define MESH_BINARY_VERSION 1
+
+typedef struct {
+  char    magic[8];        // MESH_BINARY_MAGIC, not null terminated
+  int64_t byteOrder;       // 1 in the writer's byte order
+  int64_t version;         // MESH_BINARY_VERSION
+
+  int64_t dim;             // dimension of the vertex coordinates
+  int64_t elementType;     // gmsh element type of the elements
+  int64_t faceType;        // gmsh element type of the boundary faces
+  int64_t Nverts;          // vertices per element
+  int64_t NfaceVertices;   // vertices per boundary face
+
+  int64_t Nnodes;          // number of mesh vertices
+  int64_t Nelements;       // number of element records
+  int64_t NboundaryFaces;  // number of boundary records
+
+  int64_t elementOffset;   // byte offset of the element records
+  int64_t boundaryOffset;  // byte offset of the boundary records
+} meshBinaryHeader_t;
+
+// bytes per element and boundary record
+#define meshBinaryElementBytes(Nverts)  ((1+(Nverts))*sizeof(int64_t) + 3*(Nverts)*sizeof(double))
+#define meshBinaryBoundaryBytes(Nfv)    ((1+(Nfv))*sizeof(int64_t))
+
+#endif
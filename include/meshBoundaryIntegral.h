@@ -0,0 +1,73 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Integrals of a vector field, typically the wall traction, over the faces
+  of selected boundary tags. The local faces of each tag are listed once at
+  set up together with the surface quadrature weight of each face node (the
+  row sums of the face mass matrix times the surface Jacobian), so any
+  polynomial degree is supported. The solver fills o_traction with
+  Ncomponents values per listed face node, e.g. with its own OKL kernel
+  looping over faceElements/faceIds, and meshBoundaryIntegral integrates and
+  sums them per tag on the device before a single small Allreduce.
+*/
+
+#ifndef MESHBOUNDARYINTEGRAL_H
+#define MESHBOUNDARYINTEGRAL_H 1
+
+#include "mesh.h"
+
+typedef struct {
+  mesh_t *mesh;
+
+  int Ntags;
+  int *tags;            // boundary tags integrated over
+  int Ncomponents;      // values per face node, at most 3
+
+  dlong Nfaces;         // local faces on those tags, grouped by tag
+  dlong *tagStarts;     // first listed face of each tag, Ntags+1 entries
+  dlong *faceElements;
+  int *faceIds;
+
+  occa::memory o_tagStarts;
+  occa::memory o_faceElements, o_faceIds;
+  occa::memory o_wsJ;       // quadrature weight of each listed face node
+  occa::memory o_traction;  // Ncomponents per listed face node
+  occa::memory o_integrals; // Ncomponents per tag on this rank
+
+  dfloat *localIntegrals;
+  dfloat *integrals;        // Ncomponents per tag, summed over all ranks
+
+  occa::kernel integrateKernel;
+} meshBoundaryIntegral_t;
+
+meshBoundaryIntegral_t *meshBoundaryIntegralSetup(mesh_t *mesh, int Ntags, const int *tags,
+                                                  int Ncomponents, occa::properties &kernelInfo);
+
+// integrate o_traction over the faces of every tag into bi->integrals
+void meshBoundaryIntegral(meshBoundaryIntegral_t *bi);
+
+#endif
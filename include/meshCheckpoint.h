@@ -0,0 +1,116 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Checkpoint files shared by all ranks. Each element owns one fixed size
+  record in the file, placed by a global element number that depends only
+  on the mesh (its sorted global vertex ids), so a checkpoint written on P
+  ranks can be read back on any other number of ranks.
+
+  Writing stalls the caller only for the device to pinned host copies; a
+  helper thread packs the records and writes them with collective MPI-IO.
+
+  usage per checkpoint:
+    meshCheckpointBegin(cp, fileName, time, dt, frame);  // waits for the previous one
+    meshCheckpointAddField(cp, o_q, ...);                 // one call per field, in record order
+    meshCheckpointWrite(cp);
+  and on restart, with the same sequence of fields:
+    if(meshCheckpointReadBegin(cp, fileName, &time, &dt, &frame)){
+      meshCheckpointReadField(cp, o_q, ...);
+      meshCheckpointReadEnd(cp);
+    }
+*/
+
+#ifndef MESHCHECKPOINT_H
+#define MESHCHECKPOINT_H 1
+
+#include <pthread.h>
+#include "mesh.h"
+
+#define MESH_CHECKPOINT_MAX_FIELDS 32
+
+typedef struct {
+  char magic[8];
+  int dim, Np, dfloatSize;
+  int Nvalues;          // dfloats per element record
+  hlong Nelements;      // global element count
+  dfloat time, dt;
+  int frame;
+} meshCheckpointHeader_t;
+
+typedef struct {
+  int Nblocks;          // blocks of Np values per element
+  dlong blockStride;    // distance between the blocks of an element
+  dlong elementStride;  // distance between the rows of consecutive elements
+  dlong *rows;          // row of each element in the field, -1 if absent (NULL: row e)
+
+  size_t bytes;         // extent staged from the device
+  occa::memory o_staging;
+  dfloat *staging;      // pinned host copy
+} meshCheckpointField_t;
+
+typedef struct {
+  mesh_t *mesh;
+  MPI_Comm comm;        // private communicator for the helper thread
+
+  hlong Nelements;      // global element count
+  hlong *globalIds;     // global number of each local element
+  dlong *order;         // local elements in increasing global number
+
+  int threaded;         // MPI allows a helper thread to do collective I/O
+
+  meshCheckpointHeader_t header;
+  char fileName[BUFSIZ];
+
+  int Nfields;
+  meshCheckpointField_t fields[MESH_CHECKPOINT_MAX_FIELDS];
+
+  dfloat *records;      // Nelements*Nvalues, in global order
+  int recordOffset;     // next unread value while reading
+
+  pthread_t thread;
+  int writing;
+} meshCheckpoint_t;
+
+meshCheckpoint_t *meshCheckpointSetup(mesh_t *mesh);
+
+void meshCheckpointBegin(meshCheckpoint_t *cp, const char *fileName, dfloat time, dfloat dt, int frame);
+
+// stage Nrows rows of o_q: block b of row r is the Np values at
+// r*elementStride + b*blockStride. rows maps mesh elements to rows (NULL: identity)
+void meshCheckpointAddField(meshCheckpoint_t *cp, occa::memory &o_q, int Nblocks,
+                            dlong blockStride, dlong elementStride, dlong Nrows, dlong *rows);
+
+void meshCheckpointWrite(meshCheckpoint_t *cp);
+void meshCheckpointFinish(meshCheckpoint_t *cp);
+
+// returns 0 if there is no usable checkpoint file
+int  meshCheckpointReadBegin(meshCheckpoint_t *cp, const char *fileName, dfloat *time, dfloat *dt, int *frame);
+void meshCheckpointReadField(meshCheckpoint_t *cp, occa::memory &o_q, int Nblocks,
+                             dlong blockStride, dlong elementStride, dlong Nrows, dlong *rows);
+void meshCheckpointReadEnd(meshCheckpoint_t *cp);
+
+#endif
@@ -0,0 +1,100 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Point probes. At set up the probe coordinates are read on rank 0 from a
+  text file (one "x y [z]" per line, '#' comments) and located with a bin
+  index over the bounding boxes of the local elements followed by a Newton
+  inversion of the vertex map, which supports triangles, quadrilaterals,
+  tetrahedra and hexahedra. Each probe is owned by the lowest rank that
+  finds it and keeps one row of Lagrange interpolation weights.
+
+  meshProbeSample interpolates all local probes with a single kernel launch
+  into a device buffer of time samples. Once the buffer holds Nbuffer
+  samples they are gathered on rank 0 and a background thread appends the
+  batch to the output file, one line per sample: time followed by Nfields
+  values per probe in probe file order.
+
+  usage:
+    probe = meshProbeSetup(mesh, "probes.dat", Nfields, Nbuffer, "ProbeData.dat", kernelInfo);
+    meshProbeSample(probe, time, o_q, elementStride, nodeStride, fieldStride); // every sample
+    meshProbeFinish(probe);                                                    // before exit
+  with field f of node n in element e at q[e*elementStride + n*nodeStride + f*fieldStride].
+*/
+
+#ifndef MESHPROBE_H
+#define MESHPROBE_H 1
+
+#include <pthread.h>
+#include "mesh.h"
+
+typedef struct {
+  mesh_t *mesh;
+
+  int Nfields;          // fields sampled per probe
+  int Nbuffer;          // samples buffered before a flush
+
+  dlong Nprobes;        // probes in the probe file
+  dlong Nlocal;         // probes owned by this rank
+  dlong *probeIds;      // probe file index of each local probe
+  dlong *elementIds;    // element containing each local probe
+  dfloat *interp;       // interpolation weights, Np per local probe
+
+  occa::memory o_elementIds, o_interp;
+  occa::memory o_samples; // Nbuffer x Nlocal x Nfields
+
+  occa::kernel interpolateKernel;
+
+  int Nsamples;         // samples in the device buffer
+  dfloat *times;
+  dfloat *localSamples;
+
+  // rank 0: gathered batch written by the background thread
+  int *counts, *displacements;
+  dlong Nfound;
+  dlong *outputRanks, *outputOffsets; // rank and local index of each found probe, in file order
+  int Nbatch;
+  dfloat *batchTimes;
+  dfloat *batchSamples;
+  char fileName[BUFSIZ];
+
+  pthread_t thread;
+  int writing;
+} meshProbe_t;
+
+meshProbe_t *meshProbeSetup(mesh_t *mesh, const char *probeFileName, int Nfields, int Nbuffer,
+                            const char *outputFileName, occa::properties &kernelInfo);
+
+void meshProbeSample(meshProbe_t *probe, dfloat time, occa::memory &o_q,
+                     dlong elementStride, dlong nodeStride, dlong fieldStride);
+
+// gather the buffered samples and hand them to the writer thread
+void meshProbeFlush(meshProbe_t *probe);
+
+// flush the remaining samples and wait for the writer
+void meshProbeFinish(meshProbe_t *probe);
+
+#endif
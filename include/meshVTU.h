@@ -0,0 +1,93 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Binary VTU output. Fields are interpolated to the plot nodes on the device
+  (okl/meshPlotInterp.okl) and copied to host staging buffers. A background
+  thread then writes this rank's piece as appended raw (or base64) data and,
+  on rank 0, the .pvtu index of all pieces, so time stepping continues while
+  the files are written.
+
+  usage per output frame:
+    meshVTUBegin(vtu, outName, frame);       // waits for the previous frame
+    meshVTUAddField(vtu, "Pressure", ...);    // one call per point data array
+    meshVTUWrite(vtu);                        // returns once the data is staged
+  and meshVTUFinish(vtu) before exit.
+*/
+
+#ifndef MESHVTU_H
+#define MESHVTU_H 1
+
+#include <pthread.h>
+#include "mesh.h"
+
+#define MESH_VTU_MAX_FIELDS 16
+
+typedef struct {
+  char name[BUFSIZ];
+  int Ncomponents;      // at most 3
+  float *plotq;         // host staging, Ncomponents per plot node
+} meshVTUField_t;
+
+typedef struct {
+  mesh_t *mesh;
+  int base64;           // appended data encoding, raw by default
+
+  dlong Npoints, Ncells;
+  float *points;        // plot node coordinates, 3 per node
+  int *connectivity, *offsets;
+  unsigned char *types;
+
+  occa::kernel plotInterpKernel;
+  occa::memory o_plotInterp;
+  occa::memory o_plotq;
+
+  int Nfields;
+  meshVTUField_t fields[MESH_VTU_MAX_FIELDS];
+
+  char fileBase[BUFSIZ];
+  int frame;
+
+  pthread_t thread;
+  int writing;
+} meshVTU_t;
+
+meshVTU_t *meshVTUSetup(mesh_t *mesh, setupAide &options, occa::properties &kernelInfo);
+
+void meshVTUBegin(meshVTU_t *vtu, const char *fileBase, int frame);
+
+// add fields firstField..firstField+Ncomponents-1 of o_q, where field c of node n
+// in element e is q[e*elementStride + n*nodeStride + c*fieldStride]. The values are
+// scaled by scale and, if denominator>=0, divided by field denominator of the node.
+void meshVTUAddField(meshVTU_t *vtu, const char *name, occa::memory &o_q,
+                     int firstField, int Ncomponents,
+                     dlong elementStride, dlong nodeStride, dlong fieldStride,
+                     int denominator, dfloat scale);
+
+void meshVTUWrite(meshVTU_t *vtu);
+void meshVTUFinish(meshVTU_t *vtu);
+
+#endif
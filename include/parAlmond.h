@@ -186,6 +186,7 @@ typedef struct agmgLevel_t {
 
   bool gatherLevel;
   bool weightedInnerProds;
+  bool floatPrecision; //vectors of this level are fp32
 
   void **AxArgs;
   void **smoothArgs;
@@ -249,9 +250,17 @@ typedef struct agmgLevel_t {
   dlong numAggregates;
   SmoothType stype;
 
+  //agglomeration: rows of this level are gathered onto the first rank of each group of agglomStride ranks
+  int agglomStride;
+  MPI_Comm agglomComm;
+  dlong agglomNsend;
+  int *agglomCounts;
+  int *agglomOffsets;
+  double agglomAxTime[2]; //Ax time before and after agglomeration
+
 } agmgLevel;
 
-typedef struct {
+typedef struct parAlmond_t {
   agmgLevel **levels;
   int numLevels;
 
@@ -272,6 +281,13 @@ typedef struct {
   dfloat *invCoarseA;
   dfloat *xCoarse, *rhsCoarse;
 
+  //distributed Jacobi-PCG on the coarsest csr (no gathering)
+  csr *coarseA;
+  int coarseMaxIt;
+  dfloat coarseTol;
+  dfloat *coarseDiagInv;
+  dfloat *coarseR, *coarseZ, *coarseP, *coarseAp;
+
   bool nullSpace;
   dfloat nullSpacePenalty;
 
@@ -279,12 +295,19 @@ typedef struct {
   occa::stream defaultStream;
   occa::stream dataStream;  
 
+  mesh_t *mesh; //for the two round kernel build
+
   occa::memory o_x;
   occa::memory o_Ax;
 
   dfloat *rho;
   occa::memory o_rho;
 
+  //fp32 builds of the cycle vector kernels, used on fp32 levels
+  bool floatPrecision;
+  float *floatRho;
+  struct parAlmond_t *floatAlmond;
+
   occa::kernel ellAXPYKernel;
   occa::kernel ellZeqAXPYKernel;
   occa::kernel ellJacobiKernel;
@@ -309,6 +332,8 @@ typedef struct {
 
 } parAlmond_t;
 
+//kernels are built through occaKernelBuildTurn/Done on mesh->comm, so programs
+//using libparALMOND also link src/occaKernelBuild.o
 parAlmond_t *parAlmondInit(mesh_t *mesh, setupAide options);
 
 void parAlmondAgmgSetup(parAlmond_t* parAlmond,
@@ -38,8 +38,8 @@ SOFTWARE.
 #define dfloatString "double"
 #endif
 
-//host index data type
-#if 1
+//host index data type (build with hlong=64 for 64-bit global ids)
+#ifndef HLONG64
 #define hlong int
 #define MPI_HLONG MPI_INT
 #define hlongFormat "%d"
@@ -33,12 +33,6 @@ namespace ogs {
 
   extern int Nrefs;
 
-  extern void* hostBuf;
-  extern size_t hostBufSize;
-
-  extern void* haloBuf;
-  extern occa::memory o_haloBuf;
-
   extern occa::kernel gatherScatterKernel_floatAdd;
   extern occa::kernel gatherScatterKernel_floatMul;
   extern occa::kernel gatherScatterKernel_floatMin;
@@ -185,9 +179,6 @@ namespace ogs {
   extern occa::kernel scatterManyKernel_int;
   extern occa::kernel scatterManyKernel_long;
 
-  extern occa::stream defaultStream;
-  extern occa::stream dataStream;
-
   void initKernels(MPI_Comm comm, occa::device device);
 
   void freeKernels();
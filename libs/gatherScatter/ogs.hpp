@@ -107,6 +107,27 @@ SOFTWARE.
     
   except that all communication is done together.
 
+  Each handle owns its halo buffers and data stream, so Start/Finish pairs on
+  different handles may be interleaved, e.g.
+
+    ogsGatherScatterStart (o_u, ogsDfloat, ogsAdd, ogsU);
+    ogsGatherScatterStart (o_v, ogsDfloat, ogsAdd, ogsV);
+    ...
+    ogsGatherScatterFinish(o_u, ogsDfloat, ogsAdd, ogsU);
+    ogsGatherScatterFinish(o_v, ogsDfloat, ogsAdd, ogsV);
+
+  Only one operation may be in flight on a given handle at a time.
+
+  By default the halo part of the device gatherScatter is exchanged through
+  gslib on the host. A handle can instead use a direct neighbor exchange,
+
+    ogsSetHaloExchange(ogs, ogsHaloPinned);    // MPI on pinned host buffers
+    ogsSetHaloExchange(ogs, ogsHaloGpuAware);  // MPI on device buffers
+
+  which packs per-neighbor messages on the device and never blocks on the 
+  full device queue. The call is collective and the mode must agree on all 
+  ranks. Only ogsGatherScatter/Start/Finish use the neighbor exchange.
+
 */  
 
 #ifndef OGS_HPP
@@ -132,6 +153,10 @@ SOFTWARE.
 #define ogsMax "max"
 #define ogsMin "min"
 
+#define ogsHaloGslib    "gslib"
+#define ogsHaloPinned   "pinned"
+#define ogsHaloGpuAware "gpu-aware"
+
 // OCCA+gslib gather scatter
 typedef struct {
   
@@ -159,6 +184,34 @@ typedef struct {
   void         *hostGsh;          // gslib gather 
   void         *haloGshSym;       // gslib gather 
   void         *haloGshNonSym;    // gslib gather 
+
+  hlong        *haloGatherBaseIds; // global ids of the halo gather nodes
+
+  // halo staging buffers and streams owned by this handle, so that
+  //  Start/Finish pairs on different handles can be in flight together
+  void         *hostBuf;
+  size_t        hostBufSize;
+  void         *haloBuf;
+  occa::memory o_haloBuf;
+  occa::stream defaultStream;
+  occa::stream dataStream;
+
+  // neighbor halo exchange
+  const char   *haloExchange;     // ogsHaloGslib, ogsHaloPinned or ogsHaloGpuAware
+  int           tag;              // fixed, messages are isolated by the handle's own comm
+  int           Nneighbors;
+  int          *neighborRanks;
+  dlong        *neighborOffsets;  // message offsets in the send/recv buffers
+  dlong         Nexchange;        // total number of exchanged entries
+  dlong        *exchangeIds;      // halo gather node packed in each entry
+  occa::memory o_exchangeOffsets;
+  occa::memory o_exchangeIds;
+  occa::memory o_combineOffsets;
+  occa::memory o_combineIds;
+  occa::memory o_exchangeBuf;
+  occa::memory o_sendBuf, o_recvBuf;
+  void         *sendBuf, *recvBuf;
+  MPI_Request  *requests;
   
   //degree vectors
   dfloat *invDegree, *gatherInvDegree;
@@ -173,6 +226,9 @@ ogs_t *ogsSetup(dlong N, hlong *ids, MPI_Comm &comm,
 
 void ogsFree(ogs_t* ogs);
 
+void ogsSetHaloExchange(ogs_t *ogs, const char *mode);
+void ogsHaloExchangeFree(ogs_t *ogs);
+
 // Host array versions
 void ogsGatherScatter    (void  *v, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
 void ogsGatherScatterVec (void  *v, const int k, const char *type, const char *op, ogs_t *ogs); //wrapper for gslib call
@@ -208,6 +264,9 @@ void ogsGatherScatterVecFinish (occa::memory  o_v, const int k, const char *type
 void ogsGatherScatterManyStart (occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
 void ogsGatherScatterManyFinish(occa::memory  o_v, const int k, const dlong stride, const char *type, const char *op, ogs_t *ogs);
 
+void ogsHaloExchangeStart (occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
+void ogsHaloExchangeFinish(occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
+
 void ogsGatherStart     (occa::memory  o_Gv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
 void ogsGatherFinish    (occa::memory  o_Gv, occa::memory  o_v, const char *type, const char *op, ogs_t *ogs);
 void ogsGatherVecStart  (occa::memory  o_Gv, occa::memory  o_v, const int k, const char *type, const char *op, ogs_t *ogs);
@@ -60,21 +60,21 @@ void ogsGatherStart(occa::memory o_gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGather(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGather(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -99,19 +99,19 @@ void ogsGatherFinish(occa::memory o_gv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based gather using libgs
-    ogsHostGather(ogs::haloBuf, type, op, ogs->haloGshNonSym);
+    ogsHostGather(ogs->haloBuf, type, op, ogs->haloGshNonSym);
 
     // copy totally gather halo data back from HOST to DEVICE
     if (ogs->NownedHalo)
-      o_gv.copyFrom(ogs::haloBuf, ogs->NownedHalo*Nbytes, 
+      o_gv.copyFrom(ogs->haloBuf, ogs->NownedHalo*Nbytes, 
                               ogs->NlocalGather*Nbytes, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -131,9 +131,10 @@ void ogsGather(void *gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes;
     }
   }
 
@@ -151,23 +152,23 @@ void ogsGather_add(void *gv, void *v, const size_t Nbytes, const char *type, ogs
 
   if (!strcmp(type, "float")) 
     gather_add<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gather_add<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gather_add<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gather_add<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     // MPI based scatter using gslib
-    ogsHostGather(ogs::hostBuf, type, ogsAdd, ogs->haloGshNonSym);
+    ogsHostGather(ogs->hostBuf, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs->hostBuf, ogs->NownedHalo*Nbytes);
   }
 
   if (!strcmp(type, "float")) 
@@ -188,23 +189,23 @@ void ogsGather_mul(void *gv, void *v, const size_t Nbytes, const char *type, ogs
 
   if (!strcmp(type, "float")) 
     gather_mul<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gather_mul<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gather_mul<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gather_mul<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     // MPI based scatter using gslib
-    ogsHostGather(ogs::hostBuf, type, ogsMul, ogs->haloGshNonSym);
+    ogsHostGather(ogs->hostBuf, type, ogsMul, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs->hostBuf, ogs->NownedHalo*Nbytes);
   }
 
   if (!strcmp(type, "float")) 
@@ -225,23 +226,23 @@ void ogsGather_min(void *gv, void *v, const size_t Nbytes, const char *type, ogs
 
   if (!strcmp(type, "float")) 
     gather_min<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gather_min<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gather_min<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gather_min<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     // MPI based scatter using gslib
-    ogsHostGather(ogs::hostBuf, type, ogsMin, ogs->haloGshNonSym);
+    ogsHostGather(ogs->hostBuf, type, ogsMin, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs->hostBuf, ogs->NownedHalo*Nbytes);
   }
 
   if (!strcmp(type, "float")) 
@@ -262,23 +263,23 @@ void ogsGather_max(void *gv, void *v, const size_t Nbytes, const char *type, ogs
 
   if (!strcmp(type, "float")) 
     gather_max<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gather_max<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gather_max<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gather_max<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     // MPI based scatter using gslib
-    ogsHostGather(ogs::hostBuf, type, ogsMax, ogs->haloGshNonSym);
+    ogsHostGather(ogs->hostBuf, type, ogsMax, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs::hostBuf, ogs->NownedHalo*Nbytes);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes, ogs->hostBuf, ogs->NownedHalo*Nbytes);
   }
 
   if (!strcmp(type, "float")) 
@@ -66,21 +66,21 @@ void ogsGatherManyStart(occa::memory o_gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGatherMany(ogs->NhaloGather, k, stride, ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGatherMany(ogs->NhaloGather, k, stride, ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -108,11 +108,11 @@ void ogsGatherManyFinish(occa::memory o_gv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::haloBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->haloBuf + i*ogs->NhaloGather*Nbytes;
 
     // MPI based gather using libgs
     ogsHostGatherMany(H, k, type, op, ogs->haloGshNonSym);
@@ -120,12 +120,12 @@ void ogsGatherManyFinish(occa::memory o_gv,
     // copy totally gather halo data back from HOST to DEVICE
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
-        o_gv.copyFrom((char*)ogs::haloBuf+ogs->NhaloGather*Nbytes*i, 
+        o_gv.copyFrom((char*)ogs->haloBuf+ogs->NhaloGather*Nbytes*i, 
                       ogs->NownedHalo*Nbytes, 
                       ogs->NlocalGather*Nbytes*i, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -148,9 +148,10 @@ void ogsGatherMany(void *gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes*k;
     }
   }
 
@@ -169,30 +170,30 @@ void ogsGatherMany_add(void *gv, void *v, const int k, const dlong gstride, cons
   if (!strcmp(type, "float")) 
     gatherMany_add<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherMany_add<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherMany_add<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherMany_add<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::hostBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->hostBuf + i*ogs->NhaloGather*Nbytes;
 
     ogsHostGatherMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
         memcpy((char*)gv+ogs->NlocalGather*Nbytes*i, 
-               (char*)ogs::hostBuf+ogs->NhaloGather*Nbytes*i, 
+               (char*)ogs->hostBuf+ogs->NhaloGather*Nbytes*i, 
                ogs->NownedHalo*Nbytes);
   }
 
@@ -219,30 +220,30 @@ void ogsGatherMany_mul(void *gv, void *v, const int k, const dlong gstride, cons
   if (!strcmp(type, "float")) 
     gatherMany_mul<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherMany_mul<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherMany_mul<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherMany_mul<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::hostBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->hostBuf + i*ogs->NhaloGather*Nbytes;
 
     ogsHostGatherMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
         memcpy((char*)gv+ogs->NlocalGather*Nbytes*i, 
-               (char*)ogs::hostBuf+ogs->NhaloGather*Nbytes*i, 
+               (char*)ogs->hostBuf+ogs->NhaloGather*Nbytes*i, 
                ogs->NownedHalo*Nbytes);
   }
 
@@ -269,30 +270,30 @@ void ogsGatherMany_min(void *gv, void *v, const int k, const dlong gstride, cons
   if (!strcmp(type, "float")) 
     gatherMany_min<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherMany_min<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherMany_min<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherMany_min<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::hostBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->hostBuf + i*ogs->NhaloGather*Nbytes;
 
     ogsHostGatherMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
         memcpy((char*)gv+ogs->NlocalGather*Nbytes*i, 
-               (char*)ogs::hostBuf+ogs->NhaloGather*Nbytes*i, 
+               (char*)ogs->hostBuf+ogs->NhaloGather*Nbytes*i, 
                ogs->NownedHalo*Nbytes);
   }
 
@@ -319,30 +320,30 @@ void ogsGatherMany_max(void *gv, void *v, const int k, const dlong gstride, cons
   if (!strcmp(type, "float")) 
     gatherMany_max<float>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherMany_max<double>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherMany_max<int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherMany_max<long long int>(ogs->NhaloGather, k, stride, ogs->NhaloGather, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::hostBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->hostBuf + i*ogs->NhaloGather*Nbytes;
 
     ogsHostGatherMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
         memcpy((char*)gv+ogs->NlocalGather*Nbytes*i, 
-               (char*)ogs::hostBuf+ogs->NhaloGather*Nbytes*i, 
+               (char*)ogs->hostBuf+ogs->NhaloGather*Nbytes*i, 
                ogs->NownedHalo*Nbytes);
   }
 
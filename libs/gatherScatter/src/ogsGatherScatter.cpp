@@ -47,6 +47,12 @@ void ogsGatherScatterStart(occa::memory o_v,
                           const char *type, 
                           const char *op, 
                           ogs_t *ogs){
+
+  if (strcmp(ogs->haloExchange, ogsHaloGslib)) {
+    ogsHaloExchangeStart(o_v, type, op, ogs);
+    return;
+  }
+
   size_t Nbytes;
   if (!strcmp(type, "float")) 
     Nbytes = sizeof(float);
@@ -58,21 +64,21 @@ void ogsGatherScatterStart(occa::memory o_v,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGather(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGather(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -95,20 +101,25 @@ void ogsGatherScatterFinish(occa::memory o_v,
     occaGatherScatter(ogs->NlocalGather, ogs->o_localGatherOffsets, ogs->o_localGatherIds, type, op, o_v);
   }
 
+  if (strcmp(ogs->haloExchange, ogsHaloGslib)) {
+    ogsHaloExchangeFinish(o_v, type, op, ogs);
+    return;
+  }
+
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based gather scatter using libgs
-    ogsHostGatherScatter(ogs::haloBuf, type, op, ogs->haloGshSym);
+    ogsHostGatherScatter(ogs->haloBuf, type, op, ogs->haloGshSym);
 
     // copy totally gather halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
 
     // do scatter back to local nodes
-    occaScatter(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_v);
+    occaScatter(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_v);
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
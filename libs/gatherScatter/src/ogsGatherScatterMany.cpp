@@ -78,21 +78,21 @@ void ogsGatherScatterManyStart(occa::memory o_v,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGatherMany(ogs->NhaloGather, k, stride, ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGatherMany(ogs->NhaloGather, k, stride, ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -119,22 +119,22 @@ void ogsGatherScatterManyFinish(occa::memory o_v,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::haloBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->haloBuf + i*ogs->NhaloGather*Nbytes;
 
     // MPI based gather scatter using libgs
     ogsHostGatherScatterMany(H, k, type, op, ogs->haloGshSym);
 
     // copy totally gather halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
 
     // do scatter back to local nodes
-    occaScatterMany(ogs->NhaloGather, k, ogs->NhaloGather, stride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_v);
+    occaScatterMany(ogs->NhaloGather, k, ogs->NhaloGather, stride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_v);
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
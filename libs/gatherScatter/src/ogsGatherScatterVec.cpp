@@ -61,21 +61,21 @@ void ogsGatherScatterVecStart(occa::memory o_v,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGatherVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGatherVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -101,19 +101,19 @@ void ogsGatherScatterVecFinish(occa::memory o_v,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based gather scatter using libgs
-    ogsHostGatherScatterVec(ogs::haloBuf, k, type, op, ogs->haloGshSym);
+    ogsHostGatherScatterVec(ogs->haloBuf, k, type, op, ogs->haloGshSym);
 
     // copy totally gather halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
 
     // do scatter back to local nodes
-    occaScatterVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_v);
+    occaScatterVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_v);
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
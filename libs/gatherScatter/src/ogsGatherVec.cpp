@@ -62,21 +62,21 @@ void ogsGatherVecStart(occa::memory o_gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
   // gather halo nodes on device
   if (ogs->NhaloGather) {
-    occaGatherVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs::o_haloBuf);
+    occaGatherVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, o_v, ogs->o_haloBuf);
     
     ogs->device.finish();
-    ogs->device.setStream(ogs::dataStream);
-    ogs::o_haloBuf.copyTo(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->dataStream);
+    ogs->o_haloBuf.copyTo(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -102,19 +102,19 @@ void ogsGatherVecFinish(occa::memory o_gv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based gather using libgs
-    ogsHostGatherVec(ogs::haloBuf, k, type, op, ogs->haloGshNonSym);
+    ogsHostGatherVec(ogs->haloBuf, k, type, op, ogs->haloGshNonSym);
 
     // copy totally gather halo data back from HOST to DEVICE
     if (ogs->NownedHalo)
-      o_gv.copyFrom(ogs::haloBuf, ogs->NownedHalo*Nbytes*k, 
+      o_gv.copyFrom(ogs->haloBuf, ogs->NownedHalo*Nbytes*k, 
                               ogs->NlocalGather*Nbytes*k, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -135,9 +135,10 @@ void ogsGatherVec(void *gv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes*k;
     }
   }
 
@@ -155,22 +156,22 @@ void ogsGatherVec_add(void *gv, void *v, const int k, const size_t Nbytes, const
 
   if (!strcmp(type, "float")) 
     gatherVec_add<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherVec_add<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherVec_add<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherVec_add<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
-    ogsHostGatherVec(ogs::hostBuf, k, type, ogsAdd, ogs->haloGshNonSym);
+    ogsHostGatherVec(ogs->hostBuf, k, type, ogsAdd, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs->hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
   if (!strcmp(type, "float")) 
@@ -191,22 +192,22 @@ void ogsGatherVec_mul(void *gv, void *v, const int k, const size_t Nbytes, const
 
   if (!strcmp(type, "float")) 
     gatherVec_mul<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherVec_mul<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherVec_mul<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherVec_mul<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
-    ogsHostGatherVec(ogs::hostBuf, k, type, ogsMul, ogs->haloGshNonSym);
+    ogsHostGatherVec(ogs->hostBuf, k, type, ogsMul, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs->hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
   if (!strcmp(type, "float")) 
@@ -227,22 +228,22 @@ void ogsGatherVec_min(void *gv, void *v, const int k, const size_t Nbytes, const
 
   if (!strcmp(type, "float")) 
     gatherVec_min<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherVec_min<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherVec_min<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherVec_min<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
-    ogsHostGatherVec(ogs::hostBuf, k, type, ogsMin, ogs->haloGshNonSym);
+    ogsHostGatherVec(ogs->hostBuf, k, type, ogsMin, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs->hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
   if (!strcmp(type, "float")) 
@@ -263,22 +264,22 @@ void ogsGatherVec_max(void *gv, void *v, const int k, const size_t Nbytes, const
 
   if (!strcmp(type, "float")) 
     gatherVec_max<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)v, (float*)ogs::hostBuf);
+                      ogs->haloGatherIds, (float*)v, (float*)ogs->hostBuf);
   else if (!strcmp(type, "double")) 
     gatherVec_max<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)v, (double*)ogs::hostBuf);
+                      ogs->haloGatherIds, (double*)v, (double*)ogs->hostBuf);
   else if (!strcmp(type, "int")) 
     gatherVec_max<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)v, (int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (int*)v, (int*)ogs->hostBuf);
   else if (!strcmp(type, "long long int")) 
     gatherVec_max<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs::hostBuf);
+                      ogs->haloGatherIds, (long long int*)v, (long long int*)ogs->hostBuf);
 
   if (ogs->NhaloGather) {
-    ogsHostGatherVec(ogs::hostBuf, k, type, ogsMax, ogs->haloGshNonSym);
+    ogsHostGatherVec(ogs->hostBuf, k, type, ogsMax, ogs->haloGshNonSym);
     
     if (ogs->NownedHalo)
-      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs::hostBuf, ogs->NownedHalo*Nbytes*k);
+      memcpy((char*)gv+ogs->NlocalGather*Nbytes*k, ogs->hostBuf, ogs->NownedHalo*Nbytes*k);
   }
 
   if (!strcmp(type, "float")) 
@@ -31,15 +31,6 @@ namespace ogs {
 
   int Nrefs = 0;
 
-  void* hostBuf;
-  size_t hostBufSize=0;
-
-  void* haloBuf;
-  occa::memory o_haloBuf;
-
-  occa::stream defaultStream;
-  occa::stream dataStream;
-
   occa::kernel gatherScatterKernel_floatAdd;
   occa::kernel gatherScatterKernel_floatMul;
   occa::kernel gatherScatterKernel_floatMin;
@@ -159,9 +150,6 @@ void ogs::initKernels(MPI_Comm comm, occa::device device) {
   MPI_Comm_rank(comm, &rank);
   MPI_Comm_size(comm, &size);
   
-  ogs::defaultStream = device.getStream();
-  ogs::dataStream    = device.createStream();
-
   occa::properties kernelInfo;
   kernelInfo["defines"].asObject();
   kernelInfo["includes"].asArray();
@@ -199,8 +187,9 @@ void ogs::initKernels(MPI_Comm comm, occa::device device) {
 
   if (rank==0) printf("Compiling GatherScatter Kernels \n");
 
-  for (int r=0;r<size;r++) {
-    if (r==rank) {
+  // rank 0 compiles into the OCCA cache first, the other ranks then load the cached binaries
+  for (int r=0;r<2;r++) {
+    if ((r==0 && rank==0) || (r==1 && rank>0)) {
       ogs::gatherScatterKernel_floatAdd = device.buildKernel(DOGS "/okl/gatherScatter.okl", "gatherScatter_floatAdd", kernelInfo);
       ogs::gatherScatterKernel_floatMul = device.buildKernel(DOGS "/okl/gatherScatter.okl", "gatherScatter_floatMul", kernelInfo);
       ogs::gatherScatterKernel_floatMin = device.buildKernel(DOGS "/okl/gatherScatter.okl", "gatherScatter_floatMin", kernelInfo);
@@ -456,8 +445,5 @@ void ogs::freeKernels() {
   ogs::scatterManyKernel_double.free();
   ogs::scatterManyKernel_int.free();
   ogs::scatterManyKernel_long.free();
-
-  ogs::o_haloBuf.free();
-  ogs::haloBuf = NULL;
 }
 
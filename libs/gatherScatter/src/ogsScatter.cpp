@@ -57,10 +57,10 @@ void ogsScatterStart(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
@@ -69,13 +69,13 @@ void ogsScatterStart(occa::memory o_sv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
 
     if (ogs->NownedHalo)
-      o_v.copyTo(ogs::haloBuf, ogs->NownedHalo*Nbytes, 
+      o_v.copyTo(ogs->haloBuf, ogs->NownedHalo*Nbytes, 
                               ogs->NlocalGather*Nbytes, "async: true");
 
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -96,19 +96,19 @@ void ogsScatterFinish(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based scatter using gslib
-    ogsHostScatter(ogs::haloBuf, type, op, ogs->haloGshNonSym);
+    ogsHostScatter(ogs->haloBuf, type, op, ogs->haloGshNonSym);
 
     // copy totally scattered halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes, 0, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
 
-    occaScatter(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_sv);
+    occaScatter(ogs->NhaloGather, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_sv);
   }
 }
 
@@ -129,9 +129,10 @@ void ogsScatter(void *sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes;
     }
   }
 
@@ -155,24 +156,24 @@ void ogsScatter_op(void *sv, void *v, const size_t Nbytes, const char *type, ogs
 
   if (ogs->NhaloGather) {
     if (ogs->NownedHalo)
-      memcpy(ogs::hostBuf, (char*) v+ogs->NlocalGather*Nbytes, ogs->NownedHalo*Nbytes);
+      memcpy(ogs->hostBuf, (char*) v+ogs->NlocalGather*Nbytes, ogs->NownedHalo*Nbytes);
 
     // MPI based scatter using gslib
-    ogsHostScatter(ogs::hostBuf, type, ogsAdd, ogs->haloGshNonSym);
+    ogsHostScatter(ogs->hostBuf, type, ogsAdd, ogs->haloGshNonSym);
   }
 
   if (!strcmp(type, "float")) 
     scatter<float>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
+                      ogs->haloGatherIds, (float*)ogs->hostBuf, (float*)sv);
   else if (!strcmp(type, "double")) 
     scatter<double>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
+                      ogs->haloGatherIds, (double*)ogs->hostBuf, (double*)sv);
   else if (!strcmp(type, "int")) 
     scatter<int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
+                      ogs->haloGatherIds, (int*)ogs->hostBuf, (int*)sv);
   else if (!strcmp(type, "long long int")) 
     scatter<long long int>(ogs->NhaloGather, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
+                      ogs->haloGatherIds, (long long int*)ogs->hostBuf, (long long int*)sv);
 }
 
 
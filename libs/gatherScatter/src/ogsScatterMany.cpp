@@ -69,10 +69,10 @@ void ogsScatterManyStart(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
@@ -81,15 +81,15 @@ void ogsScatterManyStart(occa::memory o_sv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
 
     if (ogs->NownedHalo) {
       for (int i=0;i<k;i++) 
-        o_v.copyTo((char*)ogs::haloBuf+ogs->NhaloGather*Nbytes*i, 
+        o_v.copyTo((char*)ogs->haloBuf+ogs->NhaloGather*Nbytes*i, 
                     ogs->NownedHalo*Nbytes, ogs->NlocalGather*Nbytes*i, "async: true");
     }
 
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -113,22 +113,22 @@ void ogsScatterManyFinish(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::haloBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->haloBuf + i*ogs->NhaloGather*Nbytes;
 
     // MPI based scatter using gslib
     ogsHostScatterMany(H, k, type, op, ogs->haloGshNonSym);
 
     // copy totally scattered halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
 
-    occaScatterMany(ogs->NhaloGather, k, ogs->NhaloGather, sstride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_sv);
+    occaScatterMany(ogs->NhaloGather, k, ogs->NhaloGather, sstride, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_sv);
   }
 }
 
@@ -152,9 +152,10 @@ void ogsScatterMany(void *sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes*k;
     }
   }
 
@@ -189,13 +190,13 @@ void ogsScatterMany_op(void *sv, void *v,
   if (ogs->NhaloGather) {
     if (ogs->NownedHalo)
       for (int i=0;i<k;i++)
-        memcpy((char*)ogs::hostBuf + ogs->NhaloGather*Nbytes*i, 
+        memcpy((char*)ogs->hostBuf + ogs->NhaloGather*Nbytes*i, 
                (char*) v+ogs->NlocalGather*Nbytes*i, 
                ogs->NownedHalo*Nbytes);
 
     
     void* H[k];
-    for (int i=0;i<k;i++) H[i] = (char*)ogs::hostBuf + i*ogs->NhaloGather*Nbytes;
+    for (int i=0;i<k;i++) H[i] = (char*)ogs->hostBuf + i*ogs->NhaloGather*Nbytes;
 
     // MPI based scatter using gslib
     ogsHostScatterMany(H, k, type, ogsAdd, ogs->haloGshNonSym);
@@ -204,19 +205,19 @@ void ogsScatterMany_op(void *sv, void *v,
   if (!strcmp(type, "float")) 
     scatterMany<float>(ogs->NhaloGather, k, ogs->NhaloGather, sstride,
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
+                      ogs->haloGatherIds, (float*)ogs->hostBuf, (float*)sv);
   else if (!strcmp(type, "double")) 
     scatterMany<double>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
+                      ogs->haloGatherIds, (double*)ogs->hostBuf, (double*)sv);
   else if (!strcmp(type, "int")) 
     scatterMany<int>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
+                      ogs->haloGatherIds, (int*)ogs->hostBuf, (int*)sv);
   else if (!strcmp(type, "long long int")) 
     scatterMany<long long int>(ogs->NhaloGather, k, ogs->NhaloGather, sstride, 
                       ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
+                      ogs->haloGatherIds, (long long int*)ogs->hostBuf, (long long int*)sv);
 }
 
 void occaScatterMany(const  dlong Nscatter,
@@ -59,10 +59,10 @@ void ogsScatterVecStart(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::o_haloBuf.size()) ogs::o_haloBuf.free();
-      ogs::o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
-      ogs::haloBuf = ogs::o_haloBuf.getMappedPointer();
+    if (ogs->o_haloBuf.size() < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+      ogs->o_haloBuf = ogs->device.mappedAlloc(ogs->NhaloGather*Nbytes*k);
+      ogs->haloBuf = ogs->o_haloBuf.getMappedPointer();
     }
   }
 
@@ -71,13 +71,13 @@ void ogsScatterVecStart(occa::memory o_sv,
   }
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
 
     if (ogs->NownedHalo)
-      o_v.copyTo(ogs::haloBuf, ogs->NownedHalo*Nbytes*k, 
+      o_v.copyTo(ogs->haloBuf, ogs->NownedHalo*Nbytes*k, 
                               ogs->NlocalGather*Nbytes*k, "async: true");
 
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
   }
 }
 
@@ -99,19 +99,19 @@ void ogsScatterVecFinish(occa::memory o_sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    ogs->device.setStream(ogs::dataStream);
+    ogs->device.setStream(ogs->dataStream);
     ogs->device.finish();
 
     // MPI based scatter using gslib
-    ogsHostScatterVec(ogs::haloBuf, k, type, op, ogs->haloGshNonSym);
+    ogsHostScatterVec(ogs->haloBuf, k, type, op, ogs->haloGshNonSym);
 
     // copy totally scattered halo data back from HOST to DEVICE
-    ogs::o_haloBuf.copyFrom(ogs::haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
+    ogs->o_haloBuf.copyFrom(ogs->haloBuf, ogs->NhaloGather*Nbytes*k, 0, "async: true");
 
     ogs->device.finish();
-    ogs->device.setStream(ogs::defaultStream);
+    ogs->device.setStream(ogs->defaultStream);
 
-    occaScatterVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs::o_haloBuf, o_sv);
+    occaScatterVec(ogs->NhaloGather, k, ogs->o_haloGatherOffsets, ogs->o_haloGatherIds, type, op, ogs->o_haloBuf, o_sv);
   }
 }
 
@@ -133,9 +133,10 @@ void ogsScatterVec(void *sv,
     Nbytes = sizeof(long long int);
 
   if (ogs->NhaloGather) {
-    if (ogs::hostBufSize < ogs->NhaloGather*Nbytes*k) {
-      if (ogs::hostBufSize) free(ogs::hostBuf);
-      ogs::hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+    if (ogs->hostBufSize < ogs->NhaloGather*Nbytes*k) {
+      if (ogs->hostBufSize) free(ogs->hostBuf);
+      ogs->hostBuf = (void *) malloc(ogs->NhaloGather*Nbytes*k);
+      ogs->hostBufSize = ogs->NhaloGather*Nbytes*k;
     }
   }
 
@@ -159,24 +160,24 @@ void ogsScatterVec_op(void *sv, void *v, const int k, const size_t Nbytes, const
 
   if (ogs->NhaloGather) {
     if (ogs->NownedHalo)
-      memcpy(ogs::hostBuf, (char*) v+ogs->NlocalGather*Nbytes*k, ogs->NownedHalo*Nbytes*k);
+      memcpy(ogs->hostBuf, (char*) v+ogs->NlocalGather*Nbytes*k, ogs->NownedHalo*Nbytes*k);
 
     // MPI based scatterVec using gslib
-    ogsHostScatterVec(ogs::hostBuf, k, type, ogsAdd, ogs->haloGshNonSym);
+    ogsHostScatterVec(ogs->hostBuf, k, type, ogsAdd, ogs->haloGshNonSym);
   }
 
   if (!strcmp(type, "float")) 
     scatterVec<float>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (float*)ogs::hostBuf, (float*)sv);
+                      ogs->haloGatherIds, (float*)ogs->hostBuf, (float*)sv);
   else if (!strcmp(type, "double")) 
     scatterVec<double>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (double*)ogs::hostBuf, (double*)sv);
+                      ogs->haloGatherIds, (double*)ogs->hostBuf, (double*)sv);
   else if (!strcmp(type, "int")) 
     scatterVec<int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (int*)ogs::hostBuf, (int*)sv);
+                      ogs->haloGatherIds, (int*)ogs->hostBuf, (int*)sv);
   else if (!strcmp(type, "long long int")) 
     scatterVec<long long int>(ogs->NhaloGather, k, ogs->haloGatherOffsets,
-                      ogs->haloGatherIds, (long long int*)ogs::hostBuf, (long long int*)sv);
+                      ogs->haloGatherIds, (long long int*)ogs->hostBuf, (long long int*)sv);
 }
 
 void occaScatterVec(const  dlong Nscatter,
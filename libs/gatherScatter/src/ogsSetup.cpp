@@ -76,7 +76,15 @@ ogs_t *ogsSetup(dlong N, hlong *ids, MPI_Comm &comm,
   ogs::Nrefs++;
 
   ogs->N = N;
-  ogs->comm = comm;
+
+  //private communicator, so the halo exchange messages of this handle
+  // cannot match other traffic on comm or those of other handles
+  MPI_Comm_dup(comm, &ogs->comm);
+
+  ogs->defaultStream = device.getStream();
+  ogs->dataStream    = device.createStream();
+  ogs->haloExchange = ogsHaloGslib;
+  ogs->tag = 0;
 
   int rank, size;
   MPI_Comm_rank(ogs->comm, &rank); 
@@ -288,7 +296,8 @@ ogs_t *ogsSetup(dlong N, hlong *ids, MPI_Comm &comm,
     ogs->haloGshSym    = ogsHostSetup(comm, ogs->NhaloGather, symIds,    0,0);
     ogs->haloGshNonSym = ogsHostSetup(comm, ogs->NhaloGather, nonSymIds, 0,0);
 
-    free(symIds); free(nonSymIds);
+    ogs->haloGatherBaseIds = symIds;
+    free(nonSymIds);
     free(haloNodes);
   }
   free(minRank); free(maxRank); free(flagIds);
@@ -347,8 +356,17 @@ void ogsFree(ogs_t *ogs) {
     ogs->o_haloGatherIds.free();
     ogsHostFree(ogs->haloGshSym);
     ogsHostFree(ogs->haloGshNonSym);
+    free(ogs->haloGatherBaseIds);
   }
 
+  ogsHaloExchangeFree(ogs);
+
+  if (ogs->o_haloBuf.size()) ogs->o_haloBuf.free();
+  if (ogs->hostBufSize) free(ogs->hostBuf);
+  ogs->dataStream.free();
+
+  MPI_Comm_free(&ogs->comm);
+
   if (ogs->N) {
     free(ogs->invDegree);
     ogs->o_invDegree.free();
@@ -63,6 +63,7 @@ typedef struct{
   occa::kernel rkStageKernel;
   occa::kernel rkUpdateKernel;
   occa::kernel rkErrorEstimateKernel;
+  occa::kernel rkErrorSumKernel;
 
   occa::memory o_q;
   occa::memory o_rhsq;
@@ -70,7 +71,7 @@ typedef struct{
   occa::memory o_saveq;
   
   occa::memory o_rkq, o_rkrhsq, o_rkerr;
-  occa::memory o_errtmp;
+  occa::memory o_errtmp, o_errsum;
   
   //halo data
   dlong haloBytes;
@@ -83,6 +84,9 @@ typedef struct{
   // DOPRI5 RK data
   int advSwitch;
   int Nrk;
+  int fsal;                // 1 if stage 0 of rkrhsq already holds the rhs of q
+  dfloat errLocal, errTotal;
+  MPI_Request errRequest;  // global error sum in flight
   dfloat ATOL, RTOL;
   dfloat factor1, invfactor1;
   dfloat factor2, invfactor2;
@@ -113,7 +117,9 @@ void acousticsDopriStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
 
 void acousticsLserkStep(acoustics_t *acoustics, setupAide &newOoptions, const dfloat time);
 
-dfloat acousticsDopriEstimate(acoustics_t *acoustics);
+void acousticsDopriEstimateStart(acoustics_t *acoustics);
+dfloat acousticsDopriEstimateFinish(acoustics_t *acoustics);
+void acousticsDopriFsal(acoustics_t *acoustics);
 
 #define TRIANGLES 3
 #define QUADRILATERALS 4
@@ -26,11 +26,12 @@ SOFTWARE.
 
 #include "acoustics.h"
 
-dfloat acousticsDopriEstimate(acoustics_t *acoustics){
+// start the DOPRI5 error estimate: reduce to one scalar on the device and
+// start its global sum, so work can proceed until acousticsDopriEstimateFinish
+void acousticsDopriEstimateStart(acoustics_t *acoustics){
   
   mesh_t *mesh = acoustics->mesh;
   
-  // should insert err = acousticsDopriEstimate2D() here
   //Error estimation 
   //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
   //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
@@ -42,17 +43,32 @@ dfloat acousticsDopriEstimate(acoustics_t *acoustics){
 				   acoustics->o_rkq,
 				   acoustics->o_rkerr,
 				   acoustics->o_errtmp);
+
+  acoustics->rkErrorSumKernel(acoustics->Nblock, acoustics->o_errtmp, acoustics->o_errsum);
   
-  acoustics->o_errtmp.copyTo(acoustics->errtmp);
-  dfloat localerr = 0;
-  dfloat err = 0;
-  for(dlong n=0;n<acoustics->Nblock;++n){
-    localerr += acoustics->errtmp[n];
-  }
-  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
-
-  err = sqrt(err/(mesh->Np*acoustics->totalElements*acoustics->Nfields));
+  acoustics->o_errsum.copyTo(&(acoustics->errLocal), sizeof(dfloat));
+
+  MPI_Iallreduce(&(acoustics->errLocal), &(acoustics->errTotal), 1, MPI_DFLOAT, MPI_SUM, mesh->comm, &(acoustics->errRequest));
+}
+
+dfloat acousticsDopriEstimateFinish(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  MPI_Wait(&(acoustics->errRequest), MPI_STATUS_IGNORE);
+
+  dfloat err = sqrt(acoustics->errTotal/(mesh->Np*acoustics->totalElements*acoustics->Nfields));
   
   return err;
 }
-  
+
+// DOPRI5 evaluates its last stage at the new solution, so once the step is
+// accepted that rhs is also the first stage of the next step
+void acousticsDopriFsal(acoustics_t *acoustics){
+
+  mesh_t *mesh = acoustics->mesh;
+
+  size_t stageBytes = mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat);
+
+  acoustics->o_rkrhsq.copyFrom(acoustics->o_rkrhsq + (acoustics->Nrk-1)*stageBytes, stageBytes);
+}
@@ -70,6 +70,8 @@ int main(int argc, char **argv){
   // set up acoustics stuff
   acoustics_t *acoustics = acousticsSetup(mesh, newOptions, boundaryHeaderFileName);
 
+  occaKernelBuildReport(mesh);
+
   // run
   acousticsRun(acoustics, newOptions);
 
@@ -71,11 +71,21 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
 	done = 1;
       }
 
+      // the output mini-step restarts from the first stage of this step
+      int outputStep = (time<nextOutputTime && time+mesh->dt>nextOutputTime);
+
       // try a step with the current time step
       acousticsDopriStep(acoustics, newOptions, time);
 
-      // compute Dopri estimator
-      dfloat err = acousticsDopriEstimate(acoustics);
+      // start Dopri estimator
+      acousticsDopriEstimateStart(acoustics);
+
+      // while it is summed, assume the step is accepted and start the next
+      // one; the first stage is lost and recomputed if it is rejected
+      int speculate = !outputStep;
+      if(speculate) acousticsDopriFsal(acoustics);
+
+      dfloat err = acousticsDopriEstimateFinish(acoustics);
 					 
       // build controller
       dfloat fac1 = pow(err,acoustics->exp1);
@@ -87,7 +97,7 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
       if (err<1.0) { //dt is accepted
 
 	// check for output during this step and do a mini-step
-	if(time<nextOutputTime && time+mesh->dt>nextOutputTime){
+	if(outputStep){
 	  dfloat savedt = mesh->dt;
 	  
 	  // save rkq
@@ -99,7 +109,8 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
 	  // print
 	  printf("Taking output mini step: %g\n", mesh->dt);
 	  
-	  // time step to output
+	  // time step to output, reusing the first stage of this step
+	  acoustics->fsal = 1;
 	  acousticsDopriStep(acoustics, newOptions, time);	  
 
 	  // shift for output
@@ -116,10 +127,14 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
 
 	  // accept saved rkq
 	  acoustics->o_q.copyFrom(acoustics->o_saveq);
+
+	  // the stages now belong to the mini-step
+	  acoustics->fsal = 0;
 	}
 	else{
 	  // accept rkq
 	  acoustics->o_q.copyFrom(acoustics->o_rkq);
+	  acoustics->fsal = 1;
 	}
 
         time += mesh->dt;
@@ -130,6 +145,9 @@ void acousticsRun(acoustics_t *acoustics, setupAide &newOptions){
         tstep++;
       } else {
         dtnew = mesh->dt/(mymax(acoustics->invfactor1,fac1/acoustics->safe));
+
+        // roll back the speculative first stage
+        acoustics->fsal = !speculate;
 	printf("\r time = %g (%d), dt = %g rejected, trying %g", time, allStep, mesh->dt, dtnew);
 
 	done = 0;
@@ -221,6 +221,7 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
       mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), acoustics->rkerr);
   
     acoustics->o_errtmp = mesh->device.malloc(acoustics->Nblock*sizeof(dfloat), acoustics->errtmp);
+    acoustics->o_errsum = mesh->device.malloc(sizeof(dfloat));
 
     acoustics->o_rkA = mesh->device.malloc(acoustics->Nrk*acoustics->Nrk*sizeof(dfloat), acoustics->rkA);
     acoustics->o_rkE = mesh->device.malloc(  acoustics->Nrk*sizeof(dfloat), acoustics->rkE);
@@ -296,46 +297,56 @@ acoustics_t *acousticsSetup(mesh_t *mesh, setupAide &newOptions, char* boundaryH
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  // kernels from volume file
-  sprintf(fileName, DACOUSTICS "/okl/acousticsVolume%s.okl", suffix);
-  sprintf(kernelName, "acousticsVolume%s", suffix);
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      // kernels from volume file
+      sprintf(fileName, DACOUSTICS "/okl/acousticsVolume%s.okl", suffix);
+      sprintf(kernelName, "acousticsVolume%s", suffix);
 
-  printf("fileName=[ %s ] \n", fileName);
-  printf("kernelName=[ %s ] \n", kernelName);
+      printf("fileName=[ %s ] \n", fileName);
+      printf("kernelName=[ %s ] \n", kernelName);
   
-  acoustics->volumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+      acoustics->volumeKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
 
-  // kernels from surface file
-  sprintf(fileName, DACOUSTICS "/okl/acousticsSurface%s.okl", suffix);
-  sprintf(kernelName, "acousticsSurface%s", suffix);
+      // kernels from surface file
+      sprintf(fileName, DACOUSTICS "/okl/acousticsSurface%s.okl", suffix);
+      sprintf(kernelName, "acousticsSurface%s", suffix);
   
-  acoustics->surfaceKernel = mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+      acoustics->surfaceKernel = mesh->device.buildKernel(fileName, kernelName, kernelInfo);
 
-  // kernels from update file
-  acoustics->updateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+      // kernels from update file
+      acoustics->updateKernel =
+        mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsUpdate",
 				       kernelInfo);
 
-  acoustics->rkUpdateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+      acoustics->rkUpdateKernel =
+        mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsRkUpdate",
 				       kernelInfo);
-  acoustics->rkStageKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+      acoustics->rkStageKernel =
+        mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsRkStage",
 				       kernelInfo);
 
-  acoustics->rkErrorEstimateKernel =
-    mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+      acoustics->rkErrorEstimateKernel =
+        mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
 				       "acousticsErrorEstimate",
 				       kernelInfo);
 
-  // fix this later
-  mesh->haloExtractKernel =
-    mesh->device.buildKernel(DHOLMES "/okl/meshHaloExtract3D.okl",
+      acoustics->rkErrorSumKernel =
+        mesh->device.buildKernel(DACOUSTICS "/okl/acousticsUpdate.okl",
+				       "acousticsErrorSum",
+				       kernelInfo);
+
+      // fix this later
+      mesh->haloExtractKernel =
+        mesh->device.buildKernel(DHOLMES "/okl/meshHaloExtract3D.okl",
 				       "meshHaloExtract3D",
 				       kernelInfo);
+    }
+    occaKernelBuildDone(mesh, r);
+  }
 
   return acoustics;
 }
@@ -30,8 +30,8 @@ void acousticsDopriStep(acoustics_t *acoustics, setupAide &newOptions, const dfl
 
   mesh_t *mesh = acoustics->mesh;
   
-  //RK step
-  for(int rk=0;rk<acoustics->Nrk;++rk){
+  //RK step (stage 0 is skipped when it carries over from the last step)
+  for(int rk=acoustics->fsal;rk<acoustics->Nrk;++rk){
     
     // t_rk = t + C_rk*dt
     dfloat currentTime = time + acoustics->rkC[rk]*mesh->dt;
@@ -38,6 +38,10 @@ SOFTWARE.
 // #include "mesh.h"
 #include "mesh2D.h"
 #include "mesh3D.h"
+#include "meshVTU.h"
+#include "meshBoundaryIntegral.h"
+#include "meshProbe.h"
+#include "meshCheckpoint.h"
 
 // Block size of reduction 
 #define blockSize 256
@@ -53,6 +57,9 @@ typedef struct{
 	
   int NrkStages; 
   int frame; 
+  meshVTU_t *vtu; // binary VTU output
+  meshBoundaryIntegral_t *forces; // wall force integrals
+  meshProbe_t *probes; // point probes
   int fixed_dt;
 	
 
@@ -80,6 +87,7 @@ typedef struct{
   int errorFlag;
   int reportFlag;
   int writeRestartFile, readRestartFile; 
+  meshCheckpoint_t *checkpoint; // shared restart file
 
   int pmlFlag;
   int errorStep;   // number of steps between error calculations
@@ -177,6 +185,17 @@ typedef struct{
   occa::memory o_sendBufferPinned;
   occa::memory o_recvBufferPinned;
 
+  // MRSAAB level-aware trace exchange (bnsMRABHaloSetup)
+  int MRABNhaloRanks;               // neighbor ranks
+  int *MRABhaloRanks;
+  dlong *MRABNhaloSend;             // [MRABNlevels+1] send list entries below each level
+  occa::memory o_MRABhaloSendIds;   // halo send elements sorted by level
+  int *MRABhaloCounts;              // [lev*MRABNhaloRanks+n] traces exchanged with neighbor n at levels <= lev
+  MPI_Datatype *MRABhaloSendTypes;  // matching entries of the packed send buffer
+  MPI_Datatype *MRABhaloRecvTypes;  // matching slots of the halo recv buffer
+  int MRABNhaloRequests;
+  MPI_Request *MRABhaloRequests;
+
 
 
   dfloat *fQM; 
@@ -208,6 +227,7 @@ typedef struct{
   occa::kernel pmlTraceUpdateKernel;
 
   occa::kernel vorticityKernel;
+  occa::kernel tractionKernel;
 
   occa::kernel isoSurfaceKernel;
 
@@ -272,6 +292,12 @@ void bnsSAADRKCoefficients(bns_t *bns, setupAide &options);
 void bnsMRSAABStep(bns_t *bns, int tstep, int haloBytes,
 		   dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options);
 
+// MRSAAB trace exchange of the levels active on a tick
+void bnsMRABHaloSetup(bns_t *bns);
+void bnsMRABStartHaloExchange(bns_t *bns, int lev, dfloat *sendBuffer);
+void bnsMRABInterimHaloExchange(bns_t *bns, int lev, dfloat *sendBuffer, dfloat *recvBuffer);
+void bnsMRABEndHaloExchange(bns_t *bns, dfloat *recvBuffer);
+
 void bnsLSERKStep(bns_t *bns, int tstep, int haloBytes,
 		  dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options);
 
@@ -43,46 +43,10 @@ void bnsError(bns_t *bns, dfloat time, setupAide &options){
   //  time = bns->startTime + tstep*bns->dt;
 
  if(bns->probeFlag){
-    //   int rank;
-    //   MPI_Comm_rank(mesh->comm, &rank);
-
-    //   // printf("Rank: %d has %d probes elements\n", rank, mesh->probeN);
-
-    //   if(mesh->probeN){
-
-    //   char fname[BUFSIZ];
-    //   sprintf(fname, "ProbeData_%d_%.f_%05d_%04d_%02d.dat", mesh->N, bns->Re, mesh->Nelements, rank, bns->Ntscale);
-
-    //   FILE *fp; 
-    //   fp = fopen(fname, "a");      
-      
-    //   fprintf(fp, "%2d %.4e %4e ", mesh->N, bns->Re, time); 
-
-    //   for(int p=0; p<mesh->probeN; p++){
-    //      int pid  = mesh->probeIds[p];
-    //      int e    = mesh->probeElementIds[p];        
-    //      dfloat srho = 0.0; 
-    //      dfloat su = 0.0; 
-    //      dfloat sv = 0.0; 
-    //      for(int n=0; n<mesh->Np; n++){
-    //       dfloat rho  = bns->q[bns->Nfields*(n + e*mesh->Np) + 0];
-    //       dfloat um   = bns->q[bns->Nfields*(n + e*mesh->Np) + 1]*bns->sqrtRT/rho;
-    //       dfloat vm   = bns->q[bns->Nfields*(n + e*mesh->Np) + 2]*bns->sqrtRT/rho;
-    //       // srho        += mesh->probeI[p*mesh->Np+n]*rho*bns->RT;
-    //       srho        += mesh->probeI[p*mesh->Np+n]*rho;
-    //       su          += mesh->probeI[p*mesh->Np+n]*um;
-    //       sv          += mesh->probeI[p*mesh->Np+n]*vm;
-    //      }
-
-    //     fprintf(fp, "%02d %04d %.8e %.8e %.8e ",pid, e, srho, su, sv); 
-    //   }
-    // fprintf(fp, "\n"); 
-    // fclose(fp);
-    // }
-
+    // density and momenta, buffered on the device and written in batches
+    meshProbeSample(bns->probes, time, bns->o_q, mesh->Np*bns->Nfields, 1, mesh->Np);
   }
 
-
   if(bns->outputForceStep)
     bnsForces(bns,time,options);
 
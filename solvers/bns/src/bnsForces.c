@@ -26,110 +26,33 @@ SOFTWARE.
 
 #include "bns.h"
 
-
+// integrate the wall traction on the device and append (time, Fx, Fy)
 void bnsForces(bns_t *bns, dfloat time, setupAide &options){
 
+  mesh_t *mesh = bns->mesh;
+  meshBoundaryIntegral_t *forces = bns->forces;
 
-  mesh_t *mesh = bns->mesh; 
-
-  
-  // Hard coded weights i.e. sum(MM1D,1), MM1D = inv(V1)'*V1
-  dfloat W[mesh->Nfp];
-  if(mesh->N==1){
-    W[0] = 1.000000000000000; W[1] = 1.000000000000000; 
-  }
-
-  if(mesh->N==2){
-    W[0] = 0.333333333333333; W[1] = 1.333333333333333;
-    W[2] = 0.333333333333333; 
-  }
-
-  if(mesh->N==3){
-    W[0] = 0.166666666666666; W[1] = 0.833333333333334;
-    W[2] = 0.833333333333334; W[3] = 0.166666666666666;
-  }
-  if(mesh->N==4){
-    W[0] = 0.100000000000000; W[1] = 0.544444444444444;
-    W[2] = 0.711111111111111; W[3] = 0.544444444444444;
-    W[4] = 0.100000000000000; 
-  }
-  if(mesh->N==5){
-    W[0] = 0.066666666666666; W[1] = 0.378474956297847;
-    W[2] = 0.554858377035487; W[3] = 0.554858377035486;
-    W[4] = 0.378474956297847; W[5] = 0.066666666666667;
-  }
-
-  if(mesh->N==6){
-    W[0] = 0.047619047619047; W[1] = 0.276826047361566;
-    W[2] = 0.431745381209863; W[3] = 0.487619047619048;
-    W[4] = 0.431745381209863; W[5] = 0.276826047361566;
-    W[6] = 0.047619047619047;
-  }
-
-   
-
-  dfloat Fx =0. , Fy = 0. ;
-  //
-  for(int e=0;e<mesh->Nelements;++e){
-    int flag = 0; 
-    for(int f=0;f<mesh->Nfaces;++f){
-      int bc = mesh->EToB[e*mesh->Nfaces+f];
-      if(bc == 1){ flag = 1; }
-    }
-    if(flag){
-
-      for(int f=0;f<mesh->Nfaces;++f){
-	int bc = mesh->EToB[e*mesh->Nfaces+f];
-	if(bc==1){
-	  for(int n=0;n<mesh->Nfp; n++){
-	    int sid  = mesh->Nsgeo*(e*mesh->Nfaces+f);
-	    dfloat nx = mesh->sgeo[sid+NXID];
-	    dfloat ny = mesh->sgeo[sid+NYID];
-	    dfloat sJ = mesh->sgeo[sid+SJID];
-	    //
-	    int id   = e*mesh->Nfp*mesh->Nfaces + f*mesh->Nfp + n;
-            int idM  = mesh->vmapM[id];
-
-            const int vidM = idM%mesh->Np;
-            const int qidM = e*mesh->Np*bns->Nfields + vidM;
-            		    	 
-	    dfloat q1  = bns->q[qidM + 0*mesh->Np];
-	    dfloat q2  = bns->q[qidM + 1*mesh->Np];
-	    dfloat q3  = bns->q[qidM + 2*mesh->Np];
-	    dfloat q4  = bns->q[qidM + 3*mesh->Np];
-	    dfloat q5  = bns->q[qidM + 4*mesh->Np];
-	    dfloat q6  = bns->q[qidM + 5*mesh->Np];
-
-	    // Compute Stress Tensor
-	    dfloat s11 = -bns->RT*(sqrt(2.0)*q5 - q2*q2/q1);
-	    dfloat s12 = -bns->RT*(          q4 - q2*q3/q1);
-	    dfloat s22 = -bns->RT*(sqrt(2.0)*q6 - q3*q3/q1);
-
-	    dfloat P   = q1*bns->RT; // rho*RT 
-	    
-            Fx  += W[n]*sJ*(-P*nx  + (s11*nx + s12*ny) );
-            Fy  += W[n]*sJ*(-P*ny  + (s12*nx + s22*ny) );
-          }
-        }
-      }
-    }
-  }
-
+  if(forces->Nfaces)
+    bns->tractionKernel(forces->Nfaces,
+                        forces->o_faceElements,
+                        forces->o_faceIds,
+                        mesh->o_sgeo,
+                        mesh->o_vmapM,
+                        bns->RT,
+                        bns->o_q,
+                        forces->o_traction);
 
-  dfloat gFx = 0., gFy = 0.; 
-  // Add all processors force, 
-  MPI_Allreduce(&Fx, &gFx, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
-  MPI_Allreduce(&Fy, &gFy, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
+  // sum over the walls of all processors
+  meshBoundaryIntegral(forces);
 
-  //
   if(mesh->rank==0){
     char fname[BUFSIZ];
     sprintf(fname, "BNSForceData_N%d.dat", mesh->N);
 
-    FILE *fp; 
-    fp = fopen(fname, "a");  
+    FILE *fp;
+    fp = fopen(fname, "a");
 
-    fprintf(fp, "%.4e %.8e %.8e \n", time, gFx, gFy); 
+    fprintf(fp, "%.4e %.8e %.8e \n", time, forces->integrals[0], forces->integrals[1]);
 
     fclose(fp);
   }
@@ -0,0 +1,220 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "bns.h"
+
+/*
+  Level-aware trace exchange for MRSAAB.
+
+  On a tick where levels < lev take a step, only the traces of elements at
+  level <= lev have changed since the previous exchange: levels below lev
+  were updated and level lev had its trace extrapolated. The rest of the
+  halo traces still hold the values received earlier. So each tick sends
+  only the elements at those levels.
+
+  The send list is the halo element list sorted by level. That way the
+  active elements always form a prefix of it, which one extract kernel
+  call packs. Per neighbor and level, an indexed MPI datatype picks that
+  neighbor's entries from the packed buffer. On the receive side, the
+  matching datatype drops them straight into their slots of the persistent
+  halo recv buffer.
+*/
+void bnsMRABHaloSetup(bns_t *bns){
+
+  mesh_t *mesh = bns->mesh;
+
+  int Nlevels = mesh->MRABNlevels;
+  int Nentries = mesh->Nfp*bns->Nfields*mesh->Nfaces;
+
+  bns->MRABNhaloRanks = 0;
+  if(!mesh->totalHaloPairs) return;
+
+  // make sure the halo copies of the element levels are current
+  int *levelSendBuffer = (int*) calloc(mesh->totalHaloPairs, sizeof(int));
+  meshHaloExchange(mesh, sizeof(int), mesh->MRABlevel, levelSendBuffer, mesh->MRABlevel+mesh->Nelements);
+  free(levelSendBuffer);
+
+  // neighbor ranks in the order used by meshHaloExchange
+  bns->MRABhaloRanks = (int*) calloc(mesh->size, sizeof(int));
+  for(int r=0;r<mesh->size;++r)
+    if(r!=mesh->rank && mesh->NhaloPairs[r])
+      bns->MRABhaloRanks[bns->MRABNhaloRanks++] = r;
+
+  int Nranks = bns->MRABNhaloRanks;
+
+  // sort the send list by level, keeping the halo order within each level
+  bns->MRABNhaloSend = (dlong*) calloc(Nlevels+1, sizeof(dlong));
+  for(dlong i=0;i<mesh->totalHaloPairs;++i)
+    bns->MRABNhaloSend[mesh->MRABlevel[mesh->haloElementList[i]]+1]++;
+  for(int l=0;l<Nlevels;++l)
+    bns->MRABNhaloSend[l+1] += bns->MRABNhaloSend[l];
+
+  dlong *sendIds = (dlong*) calloc(mesh->totalHaloPairs, sizeof(dlong));
+  int   *sendPos = (int*)   calloc(mesh->totalHaloPairs, sizeof(int));
+  dlong *levelCnt = (dlong*) calloc(Nlevels, sizeof(dlong));
+  for(dlong i=0;i<mesh->totalHaloPairs;++i){
+    dlong e = mesh->haloElementList[i];
+    int l = mesh->MRABlevel[e];
+    sendPos[i] = (int) (bns->MRABNhaloSend[l] + levelCnt[l]++);
+    sendIds[sendPos[i]] = e;
+  }
+  bns->o_MRABhaloSendIds = mesh->device.malloc(mesh->totalHaloPairs*sizeof(dlong), sendIds);
+
+  // one element trace
+  MPI_Datatype MPI_TRACE_T;
+  MPI_Type_contiguous(Nentries, MPI_DFLOAT, &MPI_TRACE_T);
+  MPI_Type_commit(&MPI_TRACE_T);
+
+  bns->MRABhaloCounts    = (int*) calloc(Nlevels*Nranks, sizeof(int));
+  bns->MRABhaloSendTypes = (MPI_Datatype*) calloc(Nlevels*Nranks, sizeof(MPI_Datatype));
+  bns->MRABhaloRecvTypes = (MPI_Datatype*) calloc(Nlevels*Nranks, sizeof(MPI_Datatype));
+  bns->MRABhaloRequests  = (MPI_Request*) calloc(2*Nranks, sizeof(MPI_Request));
+
+  int *sendDispls = (int*) calloc(mesh->totalHaloPairs, sizeof(int));
+  int *recvDispls = (int*) calloc(mesh->totalHaloPairs, sizeof(int));
+
+  for(int lev=0;lev<Nlevels;++lev){
+    dlong offset = 0;
+    for(int n=0;n<Nranks;++n){
+      int r = bns->MRABhaloRanks[n];
+
+      // the halo order is the same on both sides, and so are the levels
+      int cnt = 0;
+      for(dlong i=offset;i<offset+mesh->NhaloPairs[r];++i){
+        if(mesh->MRABlevel[mesh->haloElementList[i]]<=lev) sendDispls[cnt++] = sendPos[i];
+      }
+      int rcnt = 0;
+      for(dlong i=offset;i<offset+mesh->NhaloPairs[r];++i){
+        if(mesh->MRABlevel[mesh->Nelements+i]<=lev) recvDispls[rcnt++] = (int) i;
+      }
+
+      if(cnt!=rcnt){
+        printf("bnsMRABHaloSetup: rank %d sends %d traces to rank %d at level %d but expects %d back\n",
+               mesh->rank, cnt, r, lev, rcnt);
+        MPI_Abort(mesh->comm, 1);
+      }
+
+      bns->MRABhaloCounts[lev*Nranks+n] = cnt;
+      MPI_Type_create_indexed_block(cnt, 1, sendDispls, MPI_TRACE_T, bns->MRABhaloSendTypes+lev*Nranks+n);
+      MPI_Type_create_indexed_block(cnt, 1, recvDispls, MPI_TRACE_T, bns->MRABhaloRecvTypes+lev*Nranks+n);
+      MPI_Type_commit(bns->MRABhaloSendTypes+lev*Nranks+n);
+      MPI_Type_commit(bns->MRABhaloRecvTypes+lev*Nranks+n);
+
+      offset += mesh->NhaloPairs[r];
+    }
+  }
+
+  MPI_Type_free(&MPI_TRACE_T);
+
+  // report the traffic of one full cycle against a full halo exchange every tick
+  hlong localTraffic[2] = {0, 0}, traffic[2];
+  for(int Ntick=0;Ntick<(1<<(Nlevels-1));++Ntick){
+    int lev;
+    for(lev=0;lev<Nlevels;++lev)
+      if(Ntick % (1<<lev) != 0) break;
+    localTraffic[0] += bns->MRABNhaloSend[mymin(lev, Nlevels-1)+1];
+    localTraffic[1] += mesh->totalHaloPairs;
+  }
+  MPI_Allreduce(localTraffic, traffic, 2, MPI_HLONG, MPI_SUM, mesh->comm);
+  if(mesh->rank==0 && traffic[1])
+    printf("MRAB halo traffic per cycle: " hlongFormat " of " hlongFormat " element traces (%.1f%%)\n",
+           traffic[0], traffic[1], 100.*traffic[0]/traffic[1]);
+
+  free(sendIds);
+  free(sendPos);
+  free(levelCnt);
+  free(sendDispls);
+  free(recvDispls);
+}
+
+// extract the traces of levels <= lev and queue their copy to the host
+void bnsMRABStartHaloExchange(bns_t *bns, int lev, dfloat *sendBuffer){
+
+  mesh_t *mesh = bns->mesh;
+
+  if(!mesh->totalHaloPairs) return;
+
+  int Nentries = mesh->Nfp*bns->Nfields*mesh->Nfaces;
+  dlong Nsend = bns->MRABNhaloSend[lev+1];
+
+  // make sure the trace update of the previous tick is done
+  mesh->device.finish();
+
+  mesh->device.setStream(mesh->dataStream);
+
+  if(Nsend){
+    mesh->haloExtractKernel(Nsend, Nentries, bns->o_MRABhaloSendIds,
+                            bns->o_fQM, mesh->o_haloBuffer);
+
+    mesh->o_haloBuffer.copyTo(sendBuffer, Nsend*Nentries*sizeof(dfloat), 0, "async: true");
+  }
+
+  mesh->device.setStream(mesh->defaultStream);
+}
+
+// wait for the extracted traces, then post the MPI messages
+void bnsMRABInterimHaloExchange(bns_t *bns, int lev, dfloat *sendBuffer, dfloat *recvBuffer){
+
+  mesh_t *mesh = bns->mesh;
+
+  if(!mesh->totalHaloPairs) return;
+
+  mesh->device.setStream(mesh->dataStream);
+  mesh->device.finish();
+  mesh->device.setStream(mesh->defaultStream);
+
+  int Nranks = bns->MRABNhaloRanks;
+  int tag = 999;
+
+  bns->MRABNhaloRequests = 0;
+  for(int n=0;n<Nranks;++n){
+    if(bns->MRABhaloCounts[lev*Nranks+n]){
+      MPI_Irecv(recvBuffer, 1, bns->MRABhaloRecvTypes[lev*Nranks+n], bns->MRABhaloRanks[n], tag,
+                mesh->comm, bns->MRABhaloRequests+bns->MRABNhaloRequests++);
+      MPI_Isend(sendBuffer, 1, bns->MRABhaloSendTypes[lev*Nranks+n], bns->MRABhaloRanks[n], tag,
+                mesh->comm, bns->MRABhaloRequests+bns->MRABNhaloRequests++);
+    }
+  }
+}
+
+// wait for the messages and copy the halo traces to the device
+void bnsMRABEndHaloExchange(bns_t *bns, dfloat *recvBuffer){
+
+  mesh_t *mesh = bns->mesh;
+
+  if(!mesh->totalHaloPairs) return;
+
+  MPI_Waitall(bns->MRABNhaloRequests, bns->MRABhaloRequests, MPI_STATUSES_IGNORE);
+
+  // untouched halo slots still hold the traces received on earlier ticks
+  size_t haloBytes = mesh->totalHaloPairs*mesh->Nfp*bns->Nfields*mesh->Nfaces*sizeof(dfloat);
+  size_t foffset   = mesh->Nelements*mesh->Nfp*bns->Nfields*mesh->Nfaces*sizeof(dfloat);
+
+  mesh->device.setStream(mesh->dataStream);
+  bns->o_fQM.copyFrom(recvBuffer, haloBytes, foffset, "async: true");
+  mesh->device.finish();
+  mesh->device.setStream(mesh->defaultStream);
+}
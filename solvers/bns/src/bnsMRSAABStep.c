@@ -25,7 +25,6 @@ SOFTWARE.
 */
 
 #include "bns.h"
-#define BNS_ANSYC 0
 
 void bnsMRSAABStep(bns_t *bns, int tstep, int haloBytes,
        dfloat * sendBuffer, dfloat *recvBuffer, setupAide &options){
@@ -55,36 +54,11 @@ const dlong pmloffset = mesh->Np*mesh->pmlNelements*bns->Nfields;
     for (lev=0;lev<mesh->MRABNlevels;lev++)
       if (Ntick % (1<<lev) != 0) break; //find the max lev to compute rhs
     
-      if(mesh->totalHaloPairs>0){
-#if BNS_ASYNC 
-        mesh->device.setStream(dataStream);
-
-
-        int Nentries = mesh->Nfp*bns->Nfields*mesh->Nfaces;
-        mesh->haloExtractKernel(mesh->totalHaloPairs,
-                                Nentries,
-                                mesh->o_haloElementList,
-                                bns->o_fQM,
-                                mesh->o_haloBuffer);
-
-        // copy extracted halo to HOST
-        mesh->o_haloBuffer.copyTo(sendBuffer,"async: true");
-        mesh->device.setStream(defaultStream);
-#else
-        int Nentries = mesh->Nfp*bns->Nfields*mesh->Nfaces;
-        mesh->haloExtractKernel(mesh->totalHaloPairs,
-                                Nentries,
-                                mesh->o_haloElementList,
-                                bns->o_fQM,
-                                mesh->o_haloBuffer);
-
-        mesh->o_haloBuffer.copyTo(sendBuffer);
-        // start halo exchange
-        meshHaloExchangeStart(mesh, mesh->Nfields*mesh->Nfp*mesh->Nfaces*sizeof(dfloat),
-                              sendBuffer, recvBuffer);
-#endif
-      }
+      // only traces of levels <= haloLev changed since the last exchange
+      const int haloLev = mymin(lev, mesh->MRABNlevels-1);
 
+      // extract them on the data stream while the volume kernels run
+      bnsMRABStartHaloExchange(bns, haloLev, sendBuffer);
 
       occaTimerTic(mesh->device, "VolumeKernel");  
 
@@ -154,6 +128,9 @@ const dlong pmloffset = mesh->Np*mesh->pmlNelements*bns->Nfields;
 
     occaTimerToc(mesh->device, "VolumeKernel");   
 
+    // post the level-aware exchange, it overlaps the relaxation kernels
+    bnsMRABInterimHaloExchange(bns, haloLev, sendBuffer, recvBuffer);
+
      
     occaTimerTic(mesh->device, "RelaxationKernel");
     for (int l=0;l<lev;l++) {
@@ -216,36 +193,8 @@ const dlong pmloffset = mesh->Np*mesh->pmlNelements*bns->Nfields;
     occaTimerToc(mesh->device, "RelaxationKernel");
 
 
-    if(mesh->totalHaloPairs>0){
-#if BNS_ASYNC 
-        mesh->device.setStream(dataStream);
-        //make sure the async copy is finished
-        mesh->device.finish();
-
-        // start halo exchange
-        meshHaloExchangeStart(mesh,
-                              mesh->Nfields*mesh->Nfp*mesh->Nfaces*sizeof(dfloat),
-                              sendBuffer,
-                              recvBuffer);
-
-        // wait for halo data to arrive
-        meshHaloExchangeFinish(mesh);
-
-        // copy halo data to DEVICE
-        size_t foffset = mesh->Nfaces*mesh->Nfp*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-        bns->o_fQM.copyFrom(recvBuffer, haloBytes, foffset,"async: true");
-        mesh->device.finish();
-        mesh->device.setStream(defaultStream);
-#else
-        // wait for halo data to arrive
-        meshHaloExchangeFinish(mesh);
-
-        // copy halo data to DEVICE
-        size_t foffset = mesh->Nfaces*mesh->Nfp*bns->Nfields*mesh->Nelements*sizeof(dfloat); // offset for halo data
-        bns->o_fQM.copyFrom(recvBuffer, haloBytes, foffset);
-
-#endif
-    }
+    // wait for the halo traces and move them to the device
+    bnsMRABEndHaloExchange(bns, recvBuffer);
 
 
     // SURFACE KERNELS for boltzmann Nodal DG
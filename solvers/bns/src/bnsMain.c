@@ -28,8 +28,9 @@ SOFTWARE.
 
 int main(int argc, char **argv){
 
-  // start up MPI
-  MPI_Init(&argc, &argv);
+  // start up MPI, checkpoints are written by a helper thread if MPI allows it
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
 
   // Check input
   if(argc!=2){
@@ -65,6 +66,9 @@ int main(int argc, char **argv){
   
 
    bns_t *bns = bnsSetup(mesh,options);
+
+   occaKernelBuildReport(mesh);
+
    if(bns->readRestartFile){
     printf("Reading restart file..."); 
     bnsRestartRead(bns, options);  
@@ -73,6 +77,11 @@ int main(int argc, char **argv){
 
 
    bnsRun(bns,options);
+
+   // wait for the last output frame and checkpoint
+   meshVTUFinish(bns->vtu);
+   if(bns->probes) meshProbeFinish(bns->probes);
+   if(bns->checkpoint) meshCheckpointFinish(bns->checkpoint);
    
   // close down MPI
   MPI_Finalize();
@@ -54,17 +54,29 @@ mesh_t *mesh = bns->mesh;
 
   if(options.compareArgs("OUTPUT FILE FORMAT","VTU")){
 
-    // copy data back to host
-    bns->o_q.copyTo(bns->q);
-    bns->o_Vort.copyTo(bns->Vort);
-    bns->o_VortMag.copyTo(bns->VortMag);
-   
-    //
     char fname[BUFSIZ];
     string outName;
     options.getArgs("OUTPUT FILE NAME", outName);
-    sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, bns->frame++);
-    bnsPlotVTU(bns, fname);
+
+    if(options.compareArgs("OUTPUT VTU FORMAT","ASCII")){
+      // copy data back to host
+      bns->o_q.copyTo(bns->q);
+      bns->o_Vort.copyTo(bns->Vort);
+      bns->o_VortMag.copyTo(bns->VortMag);
+
+      sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, bns->frame++);
+      bnsPlotVTU(bns, fname);
+    } else {
+      const dlong Np = mesh->Np;
+      const dfloat RT = bns->sqrtRT*bns->sqrtRT;
+
+      // pressure is RT*rho and velocity is sqrt(RT)*q/rho
+      meshVTUBegin(bns->vtu, outName.c_str(), bns->frame++);
+      meshVTUAddField(bns->vtu, "Pressure",  bns->o_q,    0, 1, Np*bns->Nfields, 1, Np, -1, RT);
+      meshVTUAddField(bns->vtu, "Velocity",  bns->o_q,    1, bns->dim, Np*bns->Nfields, 1, Np, 0, bns->sqrtRT);
+      meshVTUAddField(bns->vtu, "Vorticity", bns->o_Vort, 0, 3, Np*bns->Nvort, 1, Np, -1, 1.0);
+      meshVTUWrite(bns->vtu);
+    }
   }
 
   if(bns->dim==3){
@@ -234,7 +234,6 @@ void bnsRunEmbedded(bns_t *bns, int haloBytes, dfloat * sendBuffer,
 
       if(bns->outputForceStep){
         if(bns->tstep%bns->outputForceStep){
-          bns->o_q.copyTo(bns->q);
           bnsForces(bns,bns->time,options);
         }
       }
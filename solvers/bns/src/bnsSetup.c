@@ -402,19 +402,6 @@ bns_t *bnsSetup(mesh_t *mesh, setupAide &options){
   }
  
  
-  // SET PROBE DATA
-  if(bns->probeFlag){
-    // mesh->probeNTotal = 3; 
-    // dfloat *pX   = (dfloat *) calloc (mesh->probeNTotal, sizeof(dfloat));
-    // dfloat *pY   = (dfloat *) calloc (mesh->probeNTotal, sizeof(dfloat));
-    // // Fill probe coordinates
-    //  pX[0] = 9.00;  pX[1] = 10.00;  pX[2] = 10.50; //pX[3] = 5;
-    //  pY[0] = 5.00;  pY[1] =  6.00;  pY[2] =  6.50; //pY[3] = 5*tan(M_PI/6.);
-    // meshProbeSetup2D(mesh, pX, pY);
-    // free(pX); free(pY);
-
-  }
-
   occa::properties kernelInfo;
  kernelInfo["defines"].asObject();
  kernelInfo["includes"].asArray();
@@ -572,6 +559,9 @@ if(options.compareArgs("TIME INTEGRATOR","MRSAAB")){
 
   bns->o_fQM = mesh->device.malloc((mesh->Nelements+mesh->totalHaloPairs)*mesh->Nfp*mesh->Nfaces*bns->Nfields*sizeof(dfloat),
                           bns->fQM);
+
+  // per level trace exchange lists
+  bnsMRABHaloSetup(bns);
   mesh->o_mapP = mesh->device.malloc(mesh->Nelements*mesh->Nfp*mesh->Nfaces*sizeof(int), mesh->mapP);
 }
 
@@ -744,9 +734,9 @@ if(options.compareArgs("TIME INTEGRATOR","SARK")){
   kernelInfo["includes"] += (char*)boundaryHeaderFileName.c_str();
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
-  for (int r=0;r<mesh->size;r++){
+  for (int r=0;r<occaKernelBuildRounds;r++) {
 
-    if (r==mesh->rank) {
+    if (occaKernelBuildTurn(mesh, r)) {
 
       // Volume kernels
       sprintf(fileName, DBNS "/okl/bnsVolume%s.okl", suffix);
@@ -871,7 +861,7 @@ if(options.compareArgs("TIME INTEGRATOR","SARK")){
           mesh->device.buildKernel(fileName, kernelName, kernelInfo);        
       }
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
   }
 
 
@@ -883,6 +873,53 @@ if(options.compareArgs("TIME INTEGRATOR","SARK")){
     meshParallelGatherScatterSetup(mesh, Ntotal, mesh->globalIds, mesh->comm, verbose);
   }
 
+  bns->vtu = meshVTUSetup(mesh, options, kernelInfo);
+
+  // point probes, sampled with the error check
+  bns->probes = NULL;
+  if(bns->probeFlag){
+    string probeFileName;
+    if(options.getArgs("PROBE FILE", probeFileName)){
+      int probeBufferSize = 100;
+      options.getArgs("PROBE BUFFER SIZE", probeBufferSize);
+
+      char probeOutName[BUFSIZ];
+      sprintf(probeOutName, "ProbeData_N%d.dat", mesh->N);
+
+      // density and momenta
+      bns->probes = meshProbeSetup(mesh, probeFileName.c_str(), bns->dim+1, probeBufferSize,
+                                   probeOutName, kernelInfo);
+    } else {
+      if(mesh->rank==0) printf("WARNING setup file does not include PROBE FILE\n");
+      bns->probeFlag = 0;
+    }
+  }
+
+  // wall (tag 1) force integrals, the traction is only implemented on triangles
+  bns->forces = NULL;
+  if(bns->outputForceStep){
+    if(bns->elementType==TRIANGLES){
+      int wallTag = 1;
+      bns->forces = meshBoundaryIntegralSetup(mesh, 1, &wallTag, bns->dim, kernelInfo);
+
+      for (int r=0;r<occaKernelBuildRounds;r++) {
+        if (occaKernelBuildTurn(mesh, r)) {
+          bns->tractionKernel =
+            mesh->device.buildKernel(DBNS "/okl/bnsTractionTri2D.okl", "bnsTractionTri2D", kernelInfo);
+        }
+        occaKernelBuildDone(mesh, r);
+      }
+    } else {
+      if(mesh->rank==0) printf("WARNING: force output is only implemented for triangles\n");
+      bns->outputForceStep = 0;
+    }
+  }
+
+  // after MRAB partitioning has settled the elements of each rank
+  bns->checkpoint = NULL;
+  if(bns->readRestartFile || bns->writeRestartFile)
+    bns->checkpoint = meshCheckpointSetup(mesh);
+
   return bns; 
 }
 
@@ -33,6 +33,8 @@ SOFTWARE.
 #include "mesh.h"
 #include "mesh2D.h"
 #include "mesh3D.h"
+#include "meshVTU.h"
+#include "meshBoundaryIntegral.h"
 
 // block size for reduction (hard coded)
 #define blockSize 256
@@ -56,6 +58,8 @@ typedef struct{
   dfloat *rkq, *rkrhsq, *rkerr;
   dfloat *errtmp;
   int frame;
+  meshVTU_t *vtu;  // binary VTU output
+  meshBoundaryIntegral_t *forces; // wall force integrals
 
   dfloat mu;
   dfloat RT;
@@ -78,11 +82,13 @@ typedef struct{
   occa::kernel rkUpdateKernel;
   occa::kernel rkOutputKernel;
   occa::kernel rkErrorEstimateKernel;
+  occa::kernel rkErrorSumKernel;
 
   occa::kernel stressesVolumeKernel;
   occa::kernel stressesSurfaceKernel;
   
   occa::kernel vorticityKernel;
+  occa::kernel tractionKernel;
   
   occa::memory o_q;
   occa::memory o_rhsq;
@@ -92,7 +98,7 @@ typedef struct{
   occa::memory o_saveq;
   
   occa::memory o_rkq, o_rkrhsq, o_rkerr;
-  occa::memory o_errtmp;
+  occa::memory o_errtmp, o_errsum;
 
   
   //halo data
@@ -113,6 +119,9 @@ typedef struct{
   // DOPRI5 RK data
   int advSwitch;
   int Nrk;
+  int fsal;                // 1 if stage 0 of rkrhsq already holds the rhs of q
+  dfloat errLocal, errTotal;
+  MPI_Request errRequest;  // global error sum in flight
   dfloat ATOL, RTOL;
   dfloat factor1, invfactor1;
   dfloat factor2, invfactor2;
@@ -145,7 +154,9 @@ void cnsDopriOutputStep(cns_t *cns, const dfloat time, const dfloat dt, const df
 
 void cnsLserkStep(cns_t *cns, setupAide &newOoptions, const dfloat time);
 
-dfloat cnsDopriEstimate(cns_t *cns);
+void cnsDopriEstimateStart(cns_t *cns);
+dfloat cnsDopriEstimateFinish(cns_t *cns);
+void cnsDopriFsal(cns_t *cns);
 
 void cnsBodyForce(dfloat t, dfloat *fx, dfloat *fy, dfloat *fz,
 		  dfloat *intfx, dfloat *intfy, dfloat *intfz);
@@ -26,11 +26,12 @@ SOFTWARE.
 
 #include "cns.h"
 
-dfloat cnsDopriEstimate(cns_t *cns){
+// start the DOPRI5 error estimate: reduce to one scalar on the device and
+// start its global sum, so work can proceed until cnsDopriEstimateFinish
+void cnsDopriEstimateStart(cns_t *cns){
   
   mesh_t *mesh = cns->mesh;
   
-  // should insert err = cnsDopriEstimate2D() here
   //Error estimation 
   //E. HAIRER, S.P. NORSETT AND G. WANNER, SOLVING ORDINARY
   //      DIFFERENTIAL EQUATIONS I. NONSTIFF PROBLEMS. 2ND EDITION.
@@ -42,17 +43,32 @@ dfloat cnsDopriEstimate(cns_t *cns){
 			     cns->o_rkq,
 			     cns->o_rkerr,
 			     cns->o_errtmp);
+
+  cns->rkErrorSumKernel(cns->Nblock, cns->o_errtmp, cns->o_errsum);
   
-  cns->o_errtmp.copyTo(cns->errtmp);
-  dfloat localerr = 0;
-  dfloat err = 0;
-  for(dlong n=0;n<cns->Nblock;++n){
-    localerr += cns->errtmp[n];
-  }
-  MPI_Allreduce(&localerr, &err, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
-
-  err = sqrt(err/(mesh->Np*cns->totalElements*cns->Nfields));
+  cns->o_errsum.copyTo(&(cns->errLocal), sizeof(dfloat));
+
+  MPI_Iallreduce(&(cns->errLocal), &(cns->errTotal), 1, MPI_DFLOAT, MPI_SUM, mesh->comm, &(cns->errRequest));
+}
+
+dfloat cnsDopriEstimateFinish(cns_t *cns){
+
+  mesh_t *mesh = cns->mesh;
+
+  MPI_Wait(&(cns->errRequest), MPI_STATUS_IGNORE);
+
+  dfloat err = sqrt(cns->errTotal/(mesh->Np*cns->totalElements*cns->Nfields));
   
   return err;
 }
-  
+
+// DOPRI5 evaluates its last stage at the new solution, so once the step is
+// accepted that rhs is also the first stage of the next step
+void cnsDopriFsal(cns_t *cns){
+
+  mesh_t *mesh = cns->mesh;
+
+  size_t stageBytes = mesh->Np*mesh->Nelements*mesh->Nfields*sizeof(dfloat);
+
+  cns->o_rkrhsq.copyFrom(cns->o_rkrhsq + (cns->Nrk-1)*stageBytes, stageBytes);
+}
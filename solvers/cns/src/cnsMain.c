@@ -64,9 +64,14 @@ int main(int argc, char **argv){
   // set up cns stuff
   cns_t *cns = cnsSetup(mesh, options);
 
+  occaKernelBuildReport(mesh);
+
   // run
   cnsRun(cns, options);
 
+  // wait for the last output frame
+  meshVTUFinish(cns->vtu);
+
   // close down MPI
   MPI_Finalize();
 
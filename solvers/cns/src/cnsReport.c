@@ -49,8 +49,19 @@ void cnsReport(cns_t *cns, dfloat time, setupAide &options){
   char fname[BUFSIZ];
   string outName;
   options.getArgs("OUTPUT FILE NAME", outName);
-  sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, cns->frame++);
 
-  cnsPlotVTU(cns, fname);
+  if(options.compareArgs("OUTPUT VTU FORMAT","ASCII")){
+    sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, cns->frame++);
+    cnsPlotVTU(cns, fname);
+  } else {
+    const dlong Np = mesh->Np;
+
+    // velocity is momentum over density at each node
+    meshVTUBegin(cns->vtu, outName.c_str(), cns->frame++);
+    meshVTUAddField(cns->vtu, "Density",   cns->o_q,    0, 1, Np*mesh->Nfields, 1, Np, -1, 1.0);
+    meshVTUAddField(cns->vtu, "Velocity",  cns->o_q,    1, cns->dim, Np*mesh->Nfields, 1, Np, 0, 1.0);
+    meshVTUAddField(cns->vtu, "Vorticity", cns->o_Vort, 0, (cns->dim==2) ? 1 : 3, Np*((cns->dim==2) ? 1 : 3), 1, Np, -1, 1.0);
+    meshVTUWrite(cns->vtu);
+  }
 
 }
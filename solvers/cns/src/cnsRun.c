@@ -76,11 +76,21 @@ void cnsRun(cns_t *cns, setupAide &options){
         done = 1;
       }
 
+      // dense output needs every stage of this step
+      int outputStep = (timeIntervalFlag && time<nextOutputTime && time+mesh->dt>=nextOutputTime);
+
       // try a step with the current time step
       cnsDopriStep(cns, options, time);
 
-      // compute Dopri estimator
-      dfloat err = cnsDopriEstimate(cns);
+      // start Dopri estimator
+      cnsDopriEstimateStart(cns);
+
+      // while it is summed, assume the step is accepted and start the next
+      // one; the first stage is lost and recomputed if it is rejected
+      int speculate = !outputStep;
+      if(speculate) cnsDopriFsal(cns);
+
+      dfloat err = cnsDopriEstimateFinish(cns);
                                          
       // build controller
       dfloat fac1 = pow(err,cns->exp1);
@@ -92,7 +102,7 @@ void cnsRun(cns_t *cns, setupAide &options){
       if (err<1.0) { //dt is accepted
 
         // check for time interval output during this step
-        if(timeIntervalFlag && time<nextOutputTime && time+mesh->dt>=nextOutputTime){
+        if(outputStep){
           cnsDopriOutputStep(cns, time,mesh->dt,nextOutputTime, cns->o_saveq);
 
           cns->o_saveq.copyTo(cns->o_q);
@@ -107,13 +117,14 @@ void cnsRun(cns_t *cns, setupAide &options){
         // accept rkq
         cns->o_q.copyFrom(cns->o_rkq);
 
+        if(!speculate) cnsDopriFsal(cns);
+        cns->fsal = 1;
+
         time += mesh->dt;
         tstep++;
 
 	if(cns->outputForceStep){
 	  if(tstep%cns->outputForceStep){
-	    cns->o_q.copyTo(mesh->q);
-	    cns->mesh->device.finish();
 	    cnsForces(cns,time);
 	    
 	  }
@@ -135,6 +146,9 @@ void cnsRun(cns_t *cns, setupAide &options){
         dtnew = mesh->dt/(mymax(cns->invfactor1,fac1/cns->safe));
         Nregect++;
 
+        // roll back the speculative first stage
+        cns->fsal = !speculate;
+
         done = 0;
       }
 
@@ -284,6 +284,7 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
       mesh->device.malloc(mesh->Np*(mesh->totalHaloPairs+mesh->Nelements)*mesh->Nfields*sizeof(dfloat), cns->rkerr);
   
     cns->o_errtmp = mesh->device.malloc(cns->Nblock*sizeof(dfloat), cns->errtmp);
+    cns->o_errsum = mesh->device.malloc(sizeof(dfloat));
 
     cns->o_rkA = mesh->device.malloc(cns->Nrk*cns->Nrk*sizeof(dfloat), cns->rkA);
     cns->o_rkE = mesh->device.malloc(  cns->Nrk*sizeof(dfloat), cns->rkE);
@@ -393,8 +394,8 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
 
       // kernels from volume file
       sprintf(fileName, DCNS "/okl/cnsVolume%s.okl", suffix);
@@ -460,13 +461,40 @@ cns_t *cnsSetup(mesh_t *mesh, setupAide &options){
                                            "cnsErrorEstimate",
                                            kernelInfo);
 
+      cns->rkErrorSumKernel =
+        mesh->device.buildKernel(DCNS "/okl/cnsUpdate.okl",
+                                           "cnsErrorSum",
+                                           kernelInfo);
+
       // fix this later
       mesh->haloExtractKernel =
         mesh->device.buildKernel(DHOLMES "/okl/meshHaloExtract3D.okl",
                                            "meshHaloExtract3D",
                                            kernelInfo);
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
+  }
+
+  cns->vtu = meshVTUSetup(mesh, options, kernelInfo);
+
+  // wall (tag 1) force integrals, the traction is only implemented on triangles
+  cns->forces = NULL;
+  if(cns->outputForceStep){
+    if(cns->elementType==TRIANGLES){
+      int wallTag = 1;
+      cns->forces = meshBoundaryIntegralSetup(mesh, 1, &wallTag, cns->dim, kernelInfo);
+
+      for (int r=0;r<occaKernelBuildRounds;r++) {
+        if (occaKernelBuildTurn(mesh, r)) {
+          cns->tractionKernel =
+            mesh->device.buildKernel(DCNS "/okl/cnsTractionTri2D.okl", "cnsTractionTri2D", kernelInfo);
+        }
+        occaKernelBuildDone(mesh, r);
+      }
+    } else {
+      if(mesh->rank==0) printf("WARNING: force output is only implemented for triangles\n");
+      cns->outputForceStep = 0;
+    }
   }
 
   return cns;
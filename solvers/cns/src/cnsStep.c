@@ -32,8 +32,8 @@ void cnsDopriStep(cns_t *cns, setupAide &newOptions, const dfloat time){
 
   mesh_t *mesh = cns->mesh;
   
-  //RK step
-  for(int rk=0;rk<cns->Nrk;++rk){
+  //RK step (stage 0 is skipped when it carries over from the last step)
+  for(int rk=cns->fsal;rk<cns->Nrk;++rk){
 
 
     mesh->device.setStream(mesh->defaultStream);
@@ -40,7 +40,27 @@ SOFTWARE.
 // block size for reduction (hard coded)
 #define blockSize 256
 
+// solve-path options, resolved once from the setupAide strings at setup
+typedef enum { ELLIPTIC_CONTINUOUS=0, ELLIPTIC_IPDG } ellipticDiscretization_t;
+typedef enum { ELLIPTIC_NODAL=0, ELLIPTIC_BERN } ellipticBasis_t;
+typedef enum { ELLIPTIC_PRECON_NONE=0, ELLIPTIC_PRECON_JACOBI, ELLIPTIC_PRECON_MASSMATRIX,
+               ELLIPTIC_PRECON_SEMFEM, ELLIPTIC_PRECON_MULTIGRID, ELLIPTIC_PRECON_FULLALMOND } ellipticPrecon_t;
+typedef enum { ELLIPTIC_PCG=0, ELLIPTIC_PCG_FLEXIBLE, ELLIPTIC_PCG_PIPELINED } ellipticKrylov_t;
+typedef enum { ELLIPTIC_ISOPARAMETRIC=0, ELLIPTIC_TRILINEAR } ellipticElementMap_t;
+
 typedef struct {
+  ellipticDiscretization_t discretization;
+  ellipticBasis_t basis;
+  ellipticPrecon_t preconditioner;
+  ellipticKrylov_t krylov;
+  ellipticElementMap_t elementMap; // TRILINEAR only honoured on hexes
+
+  bool continuous; // weighted (invDegree) inner products
+  bool verbose;
+  bool floatMultigrid; // MULTIGRID PRECISION=FLOAT: p-multigrid levels run in fp32
+}ellipticSettings_t;
+
+typedef struct elliptic_t {
 
   int dim;
   int elementType; // number of edges (3=tri, 4=quad, 6=tet, 12=hex)
@@ -49,16 +69,24 @@ typedef struct {
 
   precon_t *precon;
 
+  // set before ellipticSolveSetup to reuse this solver's preconditioner (and AMG
+  // hierarchy) when both discretize the same operator
+  struct elliptic_t *preconSource;
+
   ogs_t *ogs;
 
   setupAide options;
+  ellipticSettings_t settings; // filled by ellipticResolveOptions, read on the solve path
 
   char *type;
 
+  bool floatPrecision; // device data and vectors of this multigrid level are fp32
+
   dlong Nblock;
   dlong Nblock2; // second reduction
 
   dfloat tau;
+  dfloat lambda;
 
   int *BCType;
 
@@ -108,6 +136,12 @@ typedef struct {
   occa::memory o_R;
   occa::memory o_Ry;
 
+  // pipelined PCG: u=M*r, w=A*u, m=M*w, n=A*m, s=A*p, q=M*s, Aq=A*q
+  occa::memory o_u, o_w, o_m, o_n, o_s, o_q, o_Aq;
+  occa::memory o_pcgDots; // block partial sums of [r.r, r.u, w.u]
+  dfloat *pcgDots;
+  dfloat pcgLocalDots[3], pcgGlobalDots[3];
+
   occa::memory o_EXYZ; // element vertices for reconstructing geofacs (trilinear hexes only)
   occa::memory o_gllzw; // GLL nodes and weights
 
@@ -123,6 +157,19 @@ typedef struct {
   occa::kernel dotMultiplyKernel;
   occa::kernel dotDivideKernel;
 
+  occa::kernel updatePCGKernel;
+  occa::kernel innerProductPairKernel;
+
+  occa::kernel pipelinedInnerProductsKernel;
+  occa::kernel pipelinedUpdateKernel;
+
+  occa::kernel chebyshevStartKernel;
+  occa::kernel chebyshevUpdateKernel;
+
+  // fp64 <-> fp32 copies at the entry to the fp32 multigrid preconditioner
+  occa::kernel dfloatToFloatKernel;
+  occa::kernel floatToDfloatKernel;
+
   occa::kernel weightedNorm2Kernel;
   occa::kernel norm2Kernel;
 
@@ -134,6 +181,39 @@ typedef struct {
 
 }elliptic_t;
 
+// most fields advanced together by the block solver
+#define ELLIPTIC_MAX_BLOCK_FIELDS 3
+
+// block PCG over Nfields systems packed as [field][node] with stride offset
+typedef struct {
+
+  int Nfields;
+  dlong offset;
+
+  mesh_t *mesh;
+  elliptic_t **solvers; // one per field, supplies masks and preconditioner
+
+  ogs_t *ogs;
+
+  int jacobi;  // 1: diagonal preconditioner, 0: none
+  int mapType; // 1: trilinear hexes
+  int AxMany;  // 1: fused multi-field Ax kernel available
+
+  dlong Nblock;
+  dfloat *tmp;
+  occa::memory o_tmp;
+
+  occa::memory o_p, o_z, o_Ap;
+  occa::memory o_invDiagA;
+  occa::memory o_alpha, o_beta;
+
+  occa::kernel partialAxManyKernel;
+  occa::kernel innerProductKernel;
+  occa::kernel updatePCGKernel;
+  occa::kernel scaledAddKernel;
+
+}ellipticBlock_t;
+
 elliptic_t *ellipticSetup(mesh2D *mesh, dfloat lambda, occa::properties &kernelInfo, setupAide options);
 
 void ellipticPreconditioner(elliptic_t *elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_z);
@@ -141,6 +221,13 @@ void ellipticPreconditionerSetup(elliptic_t *elliptic, ogs_t *ogs, dfloat lambda
 
 int  ellipticSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol, occa::memory &o_r, occa::memory &o_x);
 void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &kernelInfo);
+void ellipticResolveOptions(elliptic_t *elliptic);
+bool ellipticSameOperator(elliptic_t *elliptic, elliptic_t *other);
+
+ellipticBlock_t *ellipticBlockSolveSetup(elliptic_t **solvers, int Nfields, dlong offset,
+                                         dfloat lambda, occa::properties &kernelInfo);
+int  ellipticBlockSolve(ellipticBlock_t *block, dfloat lambda, dfloat tol,
+                        occa::memory &o_r, occa::memory &o_x, int *Niter);
 
 
 void ellipticStartHaloExchange(elliptic_t *elliptic, occa::memory &o_q, int Nentries, dfloat *sendBuffer, dfloat *recvBuffer);
@@ -149,12 +236,22 @@ void ellipticEndHaloExchange(elliptic_t *elliptic, occa::memory &o_q, int Nentri
 
 //Linear solvers
 int pcg      (elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT);
+int ppcg     (elliptic_t* elliptic, dfloat lambda, occa::memory &o_r, occa::memory &o_x, const dfloat tol, const int MAXIT);
 
 void ellipticScaledAdd(elliptic_t *elliptic, dfloat alpha, occa::memory &o_a, dfloat beta, occa::memory &o_b);
 dfloat ellipticWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a, occa::memory &o_b);
 
 dfloat ellipticCascadingWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a, occa::memory &o_b);
 
+// fused Krylov vector kernels
+dfloat ellipticUpdatePCG(elliptic_t *elliptic, occa::memory &o_w, dfloat alpha,
+                         occa::memory &o_p, occa::memory &o_Ap, occa::memory &o_x, occa::memory &o_r);
+void ellipticBenchmarkVectorKernels(elliptic_t *elliptic);
+void ellipticBenchmarkHostOverhead(elliptic_t *elliptic, dfloat lambda);
+void ellipticCascadingWeightedInnerProductPair(elliptic_t *elliptic, occa::memory &o_w,
+                                               occa::memory &o_a, occa::memory &o_b, occa::memory &o_c,
+                                               dfloat *ac);
+
 void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq, const char *precision);
 
 dfloat ellipticWeightedNorm2(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a);
@@ -175,7 +272,10 @@ void ellipticSetupSmootherDampedJacobi    (elliptic_t *elliptic, precon_t *preco
 void ellipticSetupSmootherLocalPatch(elliptic_t *elliptic, precon_t *precon, agmgLevel *level, dfloat lambda, dfloat rateTolerance);
 
 void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambda);
-elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf);
+elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf, int floatPrecision);
+
+// device copy of host data in the precision of this multigrid level
+occa::memory ellipticLevelMalloc(elliptic_t *elliptic, dlong N, dfloat *a);
 
 void ellipticSEMFEMSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambda);
 
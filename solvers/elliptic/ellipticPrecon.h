@@ -111,6 +111,10 @@ typedef struct {
   void *xxt2;
   parAlmond_t *parAlmond;
 
+  // fp32 rhs and solution of the MULTIGRID PRECISION=FLOAT preconditioner
+  occa::memory o_rFloat;
+  occa::memory o_zFloat;
+
   // block Jacobi precon
   occa::memory o_invMM;
   occa::kernel blockJacobiKernel;
@@ -31,7 +31,7 @@ int pcg(elliptic_t* elliptic, dfloat lambda,
         const dfloat tol, const int MAXIT) {
 
   mesh_t *mesh = elliptic->mesh;
-  setupAide options = elliptic->options;
+  ellipticSettings_t &settings = elliptic->settings;
 
   /*aux variables */
   occa::memory &o_p  = elliptic->o_p;
@@ -64,12 +64,12 @@ int pcg(elliptic_t* elliptic, dfloat lambda,
 
   //sanity check
   if (rdotr0<1E-20) {
-    if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)){
+    if (settings.verbose&&(mesh->rank==0)){
       printf("converged in ZERO iterations. Stopping.\n");}
     return 0;
   } 
 
-  if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)) 
+  if (settings.verbose&&(mesh->rank==0)) 
     printf("CG: initial res norm %12.12f WE NEED TO GET TO %12.12f \n", sqrt(rdotr0), sqrt(TOL));
 
   // Precon^{-1} (b-A*x)
@@ -98,24 +98,16 @@ int pcg(elliptic_t* elliptic, dfloat lambda,
     // alpha = dot(r,z)/dot(p,A*p)
     alpha = rdotz0/pAp;
 
-    // x <= x + alpha*p
-    ellipticScaledAdd(elliptic,  alpha, o_p,  1.f, o_x);
-
     occaTimerTic(mesh->device,"Residual update");
     // [
+    // x <= x + alpha*p
     // r <= r - alpha*A*p
-    ellipticScaledAdd(elliptic, -alpha, o_Ap, 1.f, o_r);
-
     // dot(r,r)
-#if 1
-    rdotr1 = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_r, o_r);
-#else
-    rdotr1 = ellipticWeightedNorm2(elliptic, elliptic->o_invDegree, o_r);
-#endif
+    rdotr1 = ellipticUpdatePCG(elliptic, elliptic->o_invDegree, alpha, o_p, o_Ap, o_x, o_r);
     // ]
     occaTimerToc(mesh->device,"Residual update");
     
-    if (options.compareArgs("VERBOSE", "TRUE")&&(mesh->rank==0)) 
+    if (settings.verbose&&(mesh->rank==0)) 
       printf("CG: it %d r norm %12.12f alpha = %f \n",Niter, sqrt(rdotr1), alpha);
 
     if(rdotr1 < TOL) {
@@ -129,18 +121,20 @@ int pcg(elliptic_t* elliptic, dfloat lambda,
     // z = Precon^{-1} r
     ellipticPreconditioner(elliptic, lambda, o_r, o_z);
 
-    // dot(r,z)
-    rdotz1 = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_r, o_z);
-    // ]
-    
     // flexible pcg beta = (z.(-alpha*Ap))/zdotz0
-    if(options.compareArgs("KRYLOV SOLVER", "PCG+FLEXIBLE") ||
-       options.compareArgs("KRYLOV SOLVER", "PCG,FLEXIBLE")) {
-      dfloat zdotAp = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_z, o_Ap);
+    if(settings.krylov==ELLIPTIC_PCG_FLEXIBLE) {
+      // dot(r,z) and dot(Ap,z) share one pass over z
+      dfloat dots[2];
+      ellipticCascadingWeightedInnerProductPair(elliptic, elliptic->o_invDegree, o_r, o_Ap, o_z, dots);
+      rdotz1 = dots[0];
+      dfloat zdotAp = dots[1];
       beta = -alpha*zdotAp/rdotz0;
     } else {
+      // dot(r,z)
+      rdotz1 = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_r, o_z);
       beta = rdotz1/rdotz0;
     }
+    // ]
 
     // p = z + beta*p
     ellipticScaledAdd(elliptic, 1.f, o_z, beta, o_p);
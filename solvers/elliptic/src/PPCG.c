@@ -0,0 +1,165 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Pipelined PCG (Ghysels & Vanroose, Parallel Computing 40 (2014)).
+// The three inner products of an iteration are reduced with a single
+// MPI_Iallreduce that is overlapped with the preconditioner and operator
+// applications. Requires a fixed (non-flexible) preconditioner.
+
+static void ppcgStartInnerProducts(elliptic_t *elliptic, MPI_Request *request){
+
+  mesh_t *mesh = elliptic->mesh;
+  dlong Nblock = elliptic->Nblock;
+
+  // partial sums were written by the last inner product/update kernel,
+  // which launches no blocks on a rank without elements
+  if(mesh->Nelements)
+    elliptic->o_pcgDots.copyTo(elliptic->pcgDots, 3*Nblock*sizeof(dfloat), 0);
+  else
+    memset(elliptic->pcgDots, 0, 3*Nblock*sizeof(dfloat));
+
+  for(int k=0;k<3;++k){
+    dfloat dot = 0;
+    for(dlong n=0;n<Nblock;++n)
+      dot += elliptic->pcgDots[n+k*Nblock];
+    elliptic->pcgLocalDots[k] = dot;
+  }
+
+  MPI_Iallreduce(elliptic->pcgLocalDots, elliptic->pcgGlobalDots, 3, MPI_DFLOAT, MPI_SUM, mesh->comm, request);
+}
+
+int ppcg(elliptic_t* elliptic, dfloat lambda,
+         occa::memory &o_r, occa::memory &o_x,
+         const dfloat tol, const int MAXIT) {
+
+  mesh_t *mesh = elliptic->mesh;
+  ellipticSettings_t &settings = elliptic->settings;
+
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+  int weighted = settings.continuous ? 1:0;
+
+  /*aux variables */
+  occa::memory &o_Ax = elliptic->o_Ax;
+  occa::memory &o_p  = elliptic->o_p;
+  occa::memory &o_s  = elliptic->o_s;
+  occa::memory &o_q  = elliptic->o_q;
+  occa::memory &o_Aq = elliptic->o_Aq;
+  occa::memory &o_u  = elliptic->o_u;
+  occa::memory &o_w  = elliptic->o_w;
+  occa::memory &o_m  = elliptic->o_m;
+  occa::memory &o_n  = elliptic->o_n;
+
+  /*compute norm b, set the tolerance */
+  dfloat normB = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_r, o_r);
+
+  dfloat TOL =  mymax(tol*tol*normB,tol*tol);
+
+  // compute A*x
+  ellipticOperator(elliptic, lambda, o_x, o_Ax, dfloatString);
+
+  // subtract r = b - A*x
+  ellipticScaledAdd(elliptic, -1.f, o_Ax, 1.f, o_r);
+
+  // skip the preconditioner and operator applications if x already solves the system
+  dfloat rdotr0 = ellipticCascadingWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_r, o_r);
+
+  if(rdotr0<TOL){
+    if (settings.verbose&&(mesh->rank==0))
+      printf("converged in ZERO iterations. Stopping.\n");
+    return 0;
+  }
+
+  // u = Precon^{-1} r, w = A*u
+  ellipticPreconditioner(elliptic, lambda, o_r, o_u);
+  ellipticOperator(elliptic, lambda, o_u, o_w, dfloatString);
+
+  MPI_Request request;
+  MPI_Status  status;
+
+  // [ r.r, r.u, w.u ]
+  elliptic->pipelinedInnerProductsKernel(Ntotal, weighted, elliptic->o_invDegree, o_r, o_u, o_w, elliptic->o_pcgDots);
+  ppcgStartInnerProducts(elliptic, &request);
+
+  dfloat rdotr = 0, gamma = 0, delta = 0, gammaOld = 0;
+  dfloat alpha = 0, beta = 0;
+
+  int Niter = 0;
+  bool pending = true;
+
+  while(Niter<MAXIT) {
+
+    // m = Precon^{-1} w, n = A*m  [ overlaps the reduction in flight ]
+    occaTimerTic(mesh->device,"Preconditioner");
+    ellipticPreconditioner(elliptic, lambda, o_w, o_m);
+    occaTimerToc(mesh->device,"Preconditioner");
+
+    ellipticOperator(elliptic, lambda, o_m, o_n, dfloatString);
+
+    MPI_Wait(&request, &status);
+    pending = false;
+
+    rdotr = elliptic->pcgGlobalDots[0];
+    gamma = elliptic->pcgGlobalDots[1];
+    delta = elliptic->pcgGlobalDots[2];
+
+    if (settings.verbose&&(mesh->rank==0)){
+      if(Niter==0)
+        printf("PPCG: initial res norm %12.12f WE NEED TO GET TO %12.12f \n", sqrt(rdotr), sqrt(TOL));
+      else
+        printf("PPCG: it %d r norm %12.12f alpha = %f \n", Niter, sqrt(rdotr), alpha);
+    }
+
+    if(rdotr<TOL) break;
+
+    if(Niter>0){
+      beta  = gamma/gammaOld;
+      alpha = gamma/(delta - beta*gamma/alpha);
+    } else {
+      beta  = 0;
+      alpha = gamma/delta;
+    }
+
+    // all vector recurrences plus the next partial inner products in one pass
+    occaTimerTic(mesh->device,"Pipelined update");
+    elliptic->pipelinedUpdateKernel(Ntotal, weighted, elliptic->o_invDegree, alpha, beta,
+                                    o_m, o_n, o_p, o_s, o_q, o_Aq, o_x, o_r, o_u, o_w,
+                                    elliptic->o_pcgDots);
+    occaTimerToc(mesh->device,"Pipelined update");
+
+    ppcgStartInnerProducts(elliptic, &request);
+    pending = true;
+
+    gammaOld = gamma;
+
+    ++Niter;
+  }
+
+  if(pending) MPI_Wait(&request, &status);
+
+  return Niter;
+}
@@ -0,0 +1,104 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Host-side cost of option dispatch on the Ax path. Compares the old preamble
+// of ellipticOperator (setupAide copy + compareArgs scans) with the resolved
+// settings, and reports the host enqueue time of a full ellipticOperator call.
+static int ellipticLegacyOperatorLookup(elliptic_t *elliptic){
+
+  setupAide options = elliptic->options;
+
+  int flags = 0;
+  if(options.compareArgs("DISCRETIZATION", "CONTINUOUS")){
+    flags += (elliptic->elementType==HEXAHEDRA &&
+              options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? 1:0;
+  } else if(options.compareArgs("DISCRETIZATION", "IPDG")) {
+    // IPDG checks the basis once per kernel launch
+    for(int launch=0;launch<4;++launch)
+      flags += options.compareArgs("BASIS", "NODAL") ? 2:0;
+  }
+  return flags;
+}
+
+static int ellipticResolvedOperatorLookup(elliptic_t *elliptic){
+
+  ellipticSettings_t &settings = elliptic->settings;
+
+  int flags = 0;
+  if(settings.discretization==ELLIPTIC_CONTINUOUS){
+    flags += (settings.elementMap==ELLIPTIC_TRILINEAR) ? 1:0;
+  } else if(settings.discretization==ELLIPTIC_IPDG) {
+    for(int launch=0;launch<4;++launch)
+      flags += (settings.basis==ELLIPTIC_NODAL) ? 2:0;
+  }
+  return flags;
+}
+
+void ellipticBenchmarkHostOverhead(elliptic_t *elliptic, dfloat lambda){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  int Ntests = 1000;
+  volatile int sink = 0;
+
+  double start, legacy, resolved;
+
+  start = MPI_Wtime();
+  for(int test=0;test<Ntests;++test)
+    sink += ellipticLegacyOperatorLookup(elliptic);
+  legacy = (MPI_Wtime()-start)/Ntests;
+
+  start = MPI_Wtime();
+  for(int test=0;test<Ntests;++test)
+    sink += ellipticResolvedOperatorLookup(elliptic);
+  resolved = (MPI_Wtime()-start)/Ntests;
+
+  // full Ax: host time to enqueue versus device time to complete
+  int NAx = 20;
+  mesh->device.finish();
+
+  occa::streamTag startAx = mesh->device.tagStream();
+  start = MPI_Wtime();
+  for(int test=0;test<NAx;++test)
+    ellipticOperator(elliptic, lambda, elliptic->o_x, elliptic->o_Ax, dfloatString);
+  double enqueue = (MPI_Wtime()-start)/NAx;
+  occa::streamTag stopAx = mesh->device.tagStream();
+
+  mesh->device.finish();
+  double device = mesh->device.timeBetween(startAx, stopAx)/NAx;
+
+  double local[4] = {legacy, resolved, enqueue, device}, global[4];
+  MPI_Allreduce(local, global, 4, MPI_DOUBLE, MPI_MAX, mesh->comm);
+
+  if(mesh->rank==0){
+    printf("option lookup per Ax: setupAide %g us, resolved %g us, saved %g us\n",
+           1.e6*global[0], 1.e6*global[1], 1.e6*(global[0]-global[1]));
+    printf("%d, %d, %g, %g; %%%% N, elements, Ax host enqueue (s), Ax device (s)\n",
+           mesh->N, mesh->Nelements, global[2], global[3]);
+  }
+}
@@ -0,0 +1,120 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// BP-style streaming benchmark of the (fused) Krylov vector kernels.
+// Reports achieved device bandwidth counting each vector read and write once.
+static void ellipticBenchmarkReport(elliptic_t *elliptic, const char *name, 
+                                    occa::streamTag &start, occa::streamTag &stop,
+                                    int Ntests, double NvectorsMoved){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  mesh->device.finish();
+
+  double elapsed = mesh->device.timeBetween(start, stop)/Ntests;
+
+  double gElapsed;
+  MPI_Allreduce(&elapsed, &gElapsed, 1, MPI_DOUBLE, MPI_MAX, mesh->comm);
+
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+  double bytes = NvectorsMoved*Ntotal*sizeof(dfloat);
+
+  if(mesh->rank==0)
+    printf("%-24s %d, %d, %g, %g; %%%% N, dofs, elapsed, GB/s\n", 
+           name, mesh->N, Ntotal, gElapsed, bytes/(1.e9*gElapsed));
+}
+
+void ellipticBenchmarkVectorKernels(elliptic_t *elliptic){
+
+  mesh_t *mesh = elliptic->mesh;
+  setupAide options = elliptic->options;
+
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+  int weighted = options.compareArgs("DISCRETIZATION","CONTINUOUS") ? 1:0;
+
+  int Ntests = 20;
+  dfloat alpha = 0., beta = 1.;
+
+  // scratch vectors allocated once and reused by every kernel timed below,
+  // so the solver's own work vectors are left untouched
+  dfloat *scratch = (dfloat*) calloc(Ntotal+1, sizeof(dfloat));
+  for(dlong n=0;n<Ntotal;++n) scratch[n] = drand48();
+
+  occa::memory &o_w  = elliptic->o_invDegree;
+  occa::memory o_p  = mesh->device.malloc((Ntotal+1)*sizeof(dfloat), scratch);
+  occa::memory o_Ap = mesh->device.malloc((Ntotal+1)*sizeof(dfloat), scratch);
+  occa::memory o_z  = mesh->device.malloc((Ntotal+1)*sizeof(dfloat), scratch);
+  occa::memory o_x  = mesh->device.malloc((Ntotal+1)*sizeof(dfloat), scratch);
+  occa::memory o_r  = mesh->device.malloc((Ntotal+1)*sizeof(dfloat), scratch);
+
+  occa::streamTag start, stop;
+
+  // unfused reference: b = alpha*a + beta*b  [ 2 reads, 1 write ]
+  start = mesh->device.tagStream();
+  for(int test=0;test<Ntests;++test)
+    elliptic->scaledAddKernel(Ntotal, alpha, o_p, beta, o_x);
+  stop = mesh->device.tagStream();
+  ellipticBenchmarkReport(elliptic, "scaledAdd", start, stop, Ntests, 3);
+
+  // unfused reference: w.a.b  [ 3 reads ]
+  start = mesh->device.tagStream();
+  for(int test=0;test<Ntests;++test)
+    elliptic->weightedInnerProduct2Kernel(Ntotal, o_w, o_r, o_r, elliptic->o_tmp);
+  stop = mesh->device.tagStream();
+  ellipticBenchmarkReport(elliptic, "weightedInnerProduct2", start, stop, Ntests, 3);
+
+  // x += alpha*p, r -= alpha*Ap, w.r.r  [ 4(+1) reads, 2 writes; replaces 9(+1) unfused ]
+  start = mesh->device.tagStream();
+  for(int test=0;test<Ntests;++test)
+    elliptic->updatePCGKernel(Ntotal, weighted, o_w, alpha, o_p, o_Ap, o_x, o_r, elliptic->o_tmp);
+  stop = mesh->device.tagStream();
+  ellipticBenchmarkReport(elliptic, "updatePCG", start, stop, Ntests, 6+weighted);
+
+  // w.r.z and w.Ap.z  [ 3(+1) reads; replaces 4(+2) unfused ]
+  start = mesh->device.tagStream();
+  for(int test=0;test<Ntests;++test)
+    elliptic->innerProductPairKernel(Ntotal, weighted, o_w, o_r, o_Ap, o_z, elliptic->o_tmp);
+  stop = mesh->device.tagStream();
+  ellipticBenchmarkReport(elliptic, "innerProductPair", start, stop, Ntests, 3+weighted);
+
+  if(options.compareArgs("KRYLOV SOLVER", "PIPELINED")){
+    // eight recurrences + three partial dots [ 10(+1) reads, 8 writes ]
+    // (the pipelined work vectors are reinitialised at the start of every solve)
+    start = mesh->device.tagStream();
+    for(int test=0;test<Ntests;++test)
+      elliptic->pipelinedUpdateKernel(Ntotal, weighted, o_w, alpha, beta,
+                                      elliptic->o_m, elliptic->o_n, o_p, elliptic->o_s,
+                                      elliptic->o_q, elliptic->o_Aq, o_x, o_r,
+                                      elliptic->o_u, elliptic->o_w, elliptic->o_pcgDots);
+    stop = mesh->device.tagStream();
+    ellipticBenchmarkReport(elliptic, "ellipticPipelinedCGUpdate", start, stop, Ntests, 18+weighted);
+  }
+
+  free(scratch);
+  o_p.free(); o_Ap.free(); o_z.free(); o_x.free(); o_r.free();
+}
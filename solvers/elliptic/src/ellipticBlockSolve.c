@@ -0,0 +1,316 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "elliptic.h"
+
+// Block PCG for Nfields systems that share a mesh, lambda and operator (for
+// example the velocity components of a Helmholtz solve). Vectors are packed
+// as [field][node] with stride offset, so one Ax launch, one gatherScatterMany
+// and one Allreduce cover every field.
+
+ellipticBlock_t *ellipticBlockSolveSetup(elliptic_t **solvers, int Nfields, dlong offset,
+                                         dfloat lambda, occa::properties &kernelInfo){
+
+  elliptic_t *elliptic = solvers[0];
+  mesh_t *mesh = elliptic->mesh;
+  setupAide options = elliptic->options;
+
+  // the block path covers the plain continuous PCG with a diagonal preconditioner
+  int supported = options.compareArgs("DISCRETIZATION", "CONTINUOUS")
+               && options.compareArgs("BASIS", "NODAL")
+               && options.compareArgs("KRYLOV SOLVER", "PCG")
+               && !options.compareArgs("KRYLOV SOLVER", "FLEXIBLE")
+               && !options.compareArgs("KRYLOV SOLVER", "PIPELINED")
+               && (options.compareArgs("PRECONDITIONER", "JACOBI")
+                   || options.compareArgs("PRECONDITIONER", "NONE"));
+
+  for(int fld=0;fld<Nfields;++fld)
+    if(solvers[fld]->allNeumann) supported = 0;
+
+  if(Nfields>ELLIPTIC_MAX_BLOCK_FIELDS) supported = 0;
+
+  if(!supported){
+    if(mesh->rank==0)
+      printf("WARNING: block solve needs CONTINUOUS NODAL PCG with JACOBI or NONE, solving fields separately\n");
+    return NULL;
+  }
+
+  ellipticBlock_t *block = (ellipticBlock_t*) calloc(1, sizeof(ellipticBlock_t));
+
+  block->Nfields = Nfields;
+  block->offset = offset;
+  block->mesh = mesh;
+  block->solvers = (elliptic_t**) calloc(Nfields, sizeof(elliptic_t*));
+  for(int fld=0;fld<Nfields;++fld) block->solvers[fld] = solvers[fld];
+
+  // the unmasked handle serves all fields, each field is masked afterwards
+  block->ogs = mesh->ogs;
+  block->jacobi = options.compareArgs("PRECONDITIONER", "JACOBI") ? 1:0;
+  block->mapType = (elliptic->elementType==HEXAHEDRA &&
+                    options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? 1:0;
+
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+  block->Nblock = (Ntotal+blockSize-1)/blockSize;
+
+  block->tmp   = (dfloat*) calloc(2*Nfields*block->Nblock, sizeof(dfloat));
+  block->o_tmp = mesh->device.malloc(2*Nfields*block->Nblock*sizeof(dfloat), block->tmp);
+
+  block->o_p  = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+  block->o_z  = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+  block->o_Ap = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+
+  block->o_alpha = mesh->device.malloc(Nfields*sizeof(dfloat));
+  block->o_beta  = mesh->device.malloc(Nfields*sizeof(dfloat));
+
+  if(block->jacobi){
+    block->o_invDiagA = mesh->device.malloc(Nfields*offset*sizeof(dfloat));
+    for(int fld=0;fld<Nfields;++fld)
+      block->o_invDiagA.copyFrom(solvers[fld]->precon->o_invDiagA, Ntotal*sizeof(dfloat), fld*offset*sizeof(dfloat), 0);
+  } else {
+    block->o_invDiagA = mesh->device.malloc(sizeof(dfloat)); // unused placeholder
+  }
+
+  occa::properties blockKernelInfo = kernelInfo;
+  blockKernelInfo["defines/" "p_Nfields"]= Nfields;
+  blockKernelInfo["defines/" "p_blockSize"]= blockSize;
+  blockKernelInfo["defines/" "pfloat"]= dfloatString;
+
+  // tensor product elements with an affine map get a fused multi-field Ax,
+  //  the rest apply the single-field kernel to each field
+  block->AxMany = (block->mapType==0) && (elliptic->elementType==QUADRILATERALS ||
+                                         elliptic->elementType==HEXAHEDRA);
+
+  char fileName[BUFSIZ], kernelName[BUFSIZ];
+  const char *suffix = (elliptic->elementType==QUADRILATERALS) ? "Quad2D" : "Hex3D";
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      if(block->AxMany){
+        sprintf(fileName,   DELLIPTIC "/okl/ellipticAxMany%s.okl", suffix);
+        sprintf(kernelName, "ellipticPartialAxMany%s", suffix);
+        block->partialAxManyKernel = mesh->device.buildKernel(fileName, kernelName, blockKernelInfo);
+      }
+
+      block->innerProductKernel =
+        mesh->device.buildKernel(DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                                 "ellipticBlockWeightedInnerProduct",
+                                 blockKernelInfo);
+
+      block->updatePCGKernel =
+        mesh->device.buildKernel(DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                                 "ellipticBlockUpdatePCG",
+                                 blockKernelInfo);
+
+      block->scaledAddKernel =
+        mesh->device.buildKernel(DELLIPTIC "/okl/ellipticBlockPCG.okl",
+                                 "ellipticBlockScaledAdd",
+                                 blockKernelInfo);
+    }
+    occaKernelBuildDone(mesh, r);
+  }
+
+  return block;
+}
+
+static void ellipticBlockPartialAx(ellipticBlock_t *block, dfloat lambda, dlong Nelements,
+                                   occa::memory &o_elementList, occa::memory &o_q, occa::memory &o_Aq){
+
+  mesh_t *mesh = block->mesh;
+  elliptic_t *elliptic = block->solvers[0];
+
+  if(block->AxMany){
+    block->partialAxManyKernel(Nelements, o_elementList, mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices,
+                               mesh->o_MM, lambda, block->offset, o_q, o_Aq);
+    return;
+  }
+
+  for(int fld=0;fld<block->Nfields;++fld){
+    occa::memory o_qf  = o_q  + fld*block->offset*sizeof(dfloat);
+    occa::memory o_Aqf = o_Aq + fld*block->offset*sizeof(dfloat);
+
+    if(block->mapType==0)
+      elliptic->partialAxKernel(Nelements, o_elementList, mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices,
+                                mesh->o_MM, lambda, o_qf, o_Aqf);
+    else
+      elliptic->partialAxKernel(Nelements, o_elementList, elliptic->o_EXYZ, elliptic->o_gllzw, mesh->o_Dmatrices,
+                                mesh->o_Smatrices, mesh->o_MM, lambda, o_qf, o_Aqf);
+  }
+}
+
+// Aq = A*q for all fields
+static void ellipticBlockOperator(ellipticBlock_t *block, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq){
+
+  mesh_t *mesh = block->mesh;
+
+  occaTimerTic(mesh->device,"blockAxKernel");
+
+  if(mesh->NglobalGatherElements)
+    ellipticBlockPartialAx(block, lambda, mesh->NglobalGatherElements, mesh->o_globalGatherElementList, o_q, o_Aq);
+
+  ogsGatherScatterManyStart(o_Aq, block->Nfields, block->offset, ogsDfloat, ogsAdd, block->ogs);
+
+  if(mesh->NlocalGatherElements)
+    ellipticBlockPartialAx(block, lambda, mesh->NlocalGatherElements, mesh->o_localGatherElementList, o_q, o_Aq);
+
+  ogsGatherScatterManyFinish(o_Aq, block->Nfields, block->offset, ogsDfloat, ogsAdd, block->ogs);
+
+  //post-mask
+  for(int fld=0;fld<block->Nfields;++fld){
+    elliptic_t *elliptic = block->solvers[fld];
+    if (elliptic->Nmasked){
+      occa::memory o_Aqf = o_Aq + fld*block->offset*sizeof(dfloat);
+      mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Aqf);
+    }
+  }
+
+  occaTimerToc(mesh->device,"blockAxKernel");
+}
+
+// reduce Nsums block partial sums per field with a single Allreduce
+static void ellipticBlockReduce(ellipticBlock_t *block, int Nsums, dfloat *result){
+
+  mesh_t *mesh = block->mesh;
+  dlong Nblock = block->Nblock;
+  dfloat local[2*ELLIPTIC_MAX_BLOCK_FIELDS];
+
+  block->o_tmp.copyTo(block->tmp, Nsums*Nblock*sizeof(dfloat));
+
+  for(int s=0;s<Nsums;++s){
+    local[s] = 0;
+    for(dlong n=0;n<Nblock;++n)
+      local[s] += block->tmp[s*Nblock+n];
+  }
+
+  MPI_Allreduce(local, result, Nsums, MPI_DFLOAT, MPI_SUM, mesh->comm);
+}
+
+static void ellipticBlockInnerProduct(ellipticBlock_t *block, occa::memory &o_a, occa::memory &o_b, dfloat *ab){
+
+  mesh_t *mesh = block->mesh;
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+
+  block->innerProductKernel(Ntotal, block->offset, block->ogs->o_invDegree, o_a, o_b, block->o_tmp);
+
+  ellipticBlockReduce(block, block->Nfields, ab);
+}
+
+int ellipticBlockSolve(ellipticBlock_t *block, dfloat lambda, dfloat tol,
+                       occa::memory &o_r, occa::memory &o_x, int *Niter){
+
+  mesh_t *mesh = block->mesh;
+  ellipticSettings_t &settings = block->solvers[0]->settings;
+
+  const int Nfields = block->Nfields;
+  const int maxIter = 5000;
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+
+  occa::memory &o_p  = block->o_p;
+  occa::memory &o_z  = block->o_z;
+  occa::memory &o_Ap = block->o_Ap;
+
+  dfloat normB[ELLIPTIC_MAX_BLOCK_FIELDS], TOL[ELLIPTIC_MAX_BLOCK_FIELDS];
+  dfloat rdotz0[ELLIPTIC_MAX_BLOCK_FIELDS], pAp[ELLIPTIC_MAX_BLOCK_FIELDS];
+  dfloat alpha[ELLIPTIC_MAX_BLOCK_FIELDS], beta[ELLIPTIC_MAX_BLOCK_FIELDS];
+  dfloat dots[2*ELLIPTIC_MAX_BLOCK_FIELDS];
+  int active[ELLIPTIC_MAX_BLOCK_FIELDS];
+
+  occaTimerTic(mesh->device,"Block Linear Solve");
+
+  /*compute norm b, set the tolerance */
+  ellipticBlockInnerProduct(block, o_r, o_r, normB);
+  for(int fld=0;fld<Nfields;++fld)
+    TOL[fld] = mymax(tol*tol*normB[fld],tol*tol);
+
+  // r = b - A*x
+  ellipticBlockOperator(block, lambda, o_x, o_Ap);
+  block->solvers[0]->scaledAddKernel(Nfields*block->offset, -1.f, o_Ap, 1.f, o_r);
+
+  // z = Precon^{-1} r, with dot(r,z) and dot(r,r)
+  for(int fld=0;fld<Nfields;++fld) alpha[fld] = 0;
+  block->o_alpha.copyFrom(alpha);
+  block->updatePCGKernel(Ntotal, block->offset, block->jacobi, block->ogs->o_invDegree, block->o_invDiagA,
+                         block->o_alpha, o_p, o_Ap, o_x, o_r, o_z, block->o_tmp);
+  ellipticBlockReduce(block, 2*Nfields, dots);
+
+  int Nactive = 0;
+  for(int fld=0;fld<Nfields;++fld){
+    rdotz0[fld] = dots[fld];
+    Niter[fld] = 0;
+    active[fld] = (dots[Nfields+fld]>=1E-20);
+    Nactive += active[fld];
+  }
+
+  // p = z
+  o_p.copyFrom(o_z, Nfields*block->offset*sizeof(dfloat));
+
+  int it = 0;
+  while(Nactive && it<maxIter) {
+
+    // A*p and dot(p,A*p) for every field
+    ellipticBlockOperator(block, lambda, o_p, o_Ap);
+    ellipticBlockInnerProduct(block, o_p, o_Ap, pAp);
+
+    // converged fields are frozen with alpha = 0
+    for(int fld=0;fld<Nfields;++fld)
+      alpha[fld] = active[fld] ? rdotz0[fld]/pAp[fld] : 0;
+    block->o_alpha.copyFrom(alpha);
+
+    // x <= x + alpha*p, r <= r - alpha*A*p, z = Precon^{-1} r
+    block->updatePCGKernel(Ntotal, block->offset, block->jacobi, block->ogs->o_invDegree, block->o_invDiagA,
+                           block->o_alpha, o_p, o_Ap, o_x, o_r, o_z, block->o_tmp);
+    ellipticBlockReduce(block, 2*Nfields, dots);
+
+    ++it;
+
+    for(int fld=0;fld<Nfields;++fld){
+      if(!active[fld]) { beta[fld] = 0; continue; }
+
+      Niter[fld] = it;
+
+      if (settings.verbose&&(mesh->rank==0))
+        printf("Block CG: field %d it %d r norm %12.12f alpha = %f \n", fld, it, sqrt(dots[Nfields+fld]), alpha[fld]);
+
+      if(dots[Nfields+fld] < TOL[fld]){
+        active[fld] = 0;
+        --Nactive;
+        beta[fld] = 0;
+      } else {
+        beta[fld] = dots[fld]/rdotz0[fld];
+        rdotz0[fld] = dots[fld];
+      }
+    }
+
+    // p = z + beta*p
+    if(Nactive){
+      block->o_beta.copyFrom(beta);
+      block->scaledAddKernel(Ntotal, block->offset, block->o_beta, o_z, o_p);
+    }
+  }
+
+  occaTimerToc(mesh->device,"Block Linear Solve");
+
+  return it;
+}
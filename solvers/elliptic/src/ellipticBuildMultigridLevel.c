@@ -26,8 +26,37 @@ SOFTWARE.
 
 #include "elliptic.h"
 
+occa::memory ellipticLevelMalloc(elliptic_t *elliptic, dlong N, dfloat *a){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  if (!elliptic->floatPrecision || sizeof(dfloat)==sizeof(float))
+    return mesh->device.malloc(N*sizeof(dfloat), a);
+
+  float *fa = (float*) calloc(N, sizeof(float));
+  for (dlong n=0;n<N;n++) fa[n] = (float) a[n];
+
+  occa::memory o_fa = mesh->device.malloc(N*sizeof(float), fa);
+  free(fa);
+
+  return o_fa;
+}
+
+// replace a dfloat device array by a copy in the precision of this level
+static void ellipticLevelConvert(elliptic_t *elliptic, occa::memory &o_a, bool owned){
+
+  dlong N = o_a.size()/sizeof(dfloat);
+  dfloat *a = (dfloat*) calloc(N, sizeof(dfloat));
+  o_a.copyTo(a);
+
+  if (owned) o_a.free();
+  o_a = ellipticLevelMalloc(elliptic, N, a);
+
+  free(a);
+}
+
 // create elliptic and mesh structs for multigrid levels
-elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf){
+elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf, int floatPrecision){
 
   elliptic_t *elliptic = (elliptic_t*) calloc(1, sizeof(elliptic_t));
 
@@ -38,6 +67,7 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   elliptic->dim = baseElliptic->dim;
   elliptic->elementType = baseElliptic->elementType;
   elliptic->options = baseElliptic->options;
+  elliptic->settings = baseElliptic->settings;
   elliptic->tau = baseElliptic->tau;
   elliptic->BCType = baseElliptic->BCType;
   elliptic->allNeumann = baseElliptic->allNeumann;
@@ -65,7 +95,11 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   elliptic->scaledAddKernel = baseElliptic->scaledAddKernel;
   elliptic->dotMultiplyKernel = baseElliptic->dotMultiplyKernel;
   elliptic->dotDivideKernel = baseElliptic->dotDivideKernel;
+  elliptic->chebyshevStartKernel = baseElliptic->chebyshevStartKernel;
+  elliptic->chebyshevUpdateKernel = baseElliptic->chebyshevUpdateKernel;
 #endif
+
+  elliptic->floatPrecision = floatPrecision;
     
   //populate the mini-mesh using the mesh struct
   mesh_t *mesh = (mesh_t*) calloc(1,sizeof(mesh_t));
@@ -693,6 +727,12 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   //use the masked ids to make another gs handle
   elliptic->ogs = ogsSetup(Ntotal, mesh->maskedGlobalIds, mesh->comm, verbose, mesh->device);
   elliptic->o_invDegree = elliptic->ogs->o_invDegree;
+
+  //exchange the gatherScatter halo directly between neighbors instead of through gslib
+  if(options.compareArgs("HALO EXCHANGE", "GPU-AWARE"))
+    ogsSetHaloExchange(elliptic->ogs, ogsHaloGpuAware);
+  else if(options.compareArgs("HALO EXCHANGE", "PINNED"))
+    ogsSetHaloExchange(elliptic->ogs, ogsHaloPinned);
   
 
 
@@ -730,12 +770,12 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
   kernelInfo["defines/" "p_intNfp"]= mesh->intNfp;
   kernelInfo["defines/" "p_intNfpNfaces"]= mesh->intNfp*mesh->Nfaces;
 
-  if(sizeof(dfloat)==4){
+  if(sizeof(dfloat)==4 || elliptic->floatPrecision){
     kernelInfo["defines/" "dfloat"]="float";
     kernelInfo["defines/" "dfloat4"]="float4";
     kernelInfo["defines/" "dfloat8"]="float8";
   }
-  if(sizeof(dfloat)==8){
+  else if(sizeof(dfloat)==8){
     kernelInfo["defines/" "dfloat"]="double";
     kernelInfo["defines/" "dfloat4"]="double4";
     kernelInfo["defines/" "dfloat8"]="double8";
@@ -801,8 +841,8 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
       kernelInfo["defines/" "p_blockSize"]= blockSize;
 
       // add custom defines
@@ -843,7 +883,7 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
       occa::properties dfloatKernelInfo = kernelInfo;
       occa::properties floatKernelInfo = kernelInfo;
       floatKernelInfo["defines/" "pfloat"]= "float";
-      dfloatKernelInfo["defines/" "pfloat"]= dfloatString;
+      dfloatKernelInfo["defines/" "pfloat"]= elliptic->floatPrecision ? "float" : dfloatString;
       
       sprintf(fileName, DELLIPTIC "/okl/ellipticAx%s.okl", suffix);
       sprintf(kernelName, "ellipticAx%s", suffix);
@@ -901,15 +941,47 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
         sprintf(kernelName, "ellipticPartialAxIpdg%s", suffix);
         elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
       }
+
+      if (elliptic->floatPrecision) {
+        // fp32 builds of the vector kernels used on this level
+        mesh->addScalarKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/addScalar.okl", "addScalar", kernelInfo);
+
+        mesh->maskKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/mask.okl", "mask", kernelInfo);
+
+        mesh->sumKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/sum.okl", "sum", kernelInfo);
+
+        elliptic->weightedInnerProduct2Kernel =
+          mesh->device.buildKernel(DHOLMES "/okl/weightedInnerProduct2.okl", "weightedInnerProduct2", kernelInfo);
+
+        elliptic->innerProductKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/innerProduct.okl", "innerProduct", kernelInfo);
+
+        elliptic->scaledAddKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/scaledAdd.okl", "scaledAdd", kernelInfo);
+
+        elliptic->dotMultiplyKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/dotMultiply.okl", "dotMultiply", kernelInfo);
+
+        if (options.compareArgs("MULTIGRID SMOOTHER", "CHEBYSHEV")) {
+          elliptic->chebyshevStartKernel =
+            mesh->device.buildKernel(DELLIPTIC "/okl/ellipticChebyshev.okl", "ellipticChebyshevStart", kernelInfo);
+
+          elliptic->chebyshevUpdateKernel =
+            mesh->device.buildKernel(DELLIPTIC "/okl/ellipticChebyshev.okl", "ellipticChebyshevUpdate", kernelInfo);
+        }
+      }
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
   }
 
   //new precon struct
   elliptic->precon = (precon_t *) calloc(1,sizeof(precon_t));
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
       sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
       sprintf(kernelName, "ellipticBlockJacobiPrecon");
       elliptic->precon->blockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
@@ -954,6 +1026,9 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
       kernelInfo["defines/" "p_NblockVFine"]= NblockVFine;
       kernelInfo["defines/" "p_NblockVCoarse"]= NblockVCoarse;
 
+      // every finer level is a p-level, fp32 under MULTIGRID PRECISION=FLOAT
+      kernelInfo["defines/" "fineFloat"]= elliptic->settings.floatMultigrid ? "float" : dfloatString;
+
       sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
       sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
       elliptic->precon->coarsenKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
@@ -962,7 +1037,7 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
       sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
       elliptic->precon->prolongateKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
   }
 
   if(elliptic->elementType==HEXAHEDRA){
@@ -984,6 +1059,24 @@ elliptic_t *ellipticBuildMultigridLevel(elliptic_t *baseElliptic, int Nc, int Nf
     }
   }
 
+  if (elliptic->floatPrecision) {
+    // fp32 copies of the data read by the continuous Ax, smoothers and coarsening
+    bool ownsGeo = (elliptic->elementType==QUADRILATERALS || elliptic->elementType==HEXAHEDRA);
+
+    ellipticLevelConvert(elliptic, mesh->o_ggeo, ownsGeo);
+    ellipticLevelConvert(elliptic, mesh->o_Dmatrices, true);
+    ellipticLevelConvert(elliptic, mesh->o_Smatrices, true);
+    ellipticLevelConvert(elliptic, mesh->o_MM, true);
+
+    if (elliptic->settings.elementMap==ELLIPTIC_TRILINEAR) {
+      ellipticLevelConvert(elliptic, elliptic->o_EXYZ, false);
+      ellipticLevelConvert(elliptic, elliptic->o_gllzw, true);
+    }
+
+    ellipticLevelConvert(elliptic, mesh->ogs->o_invDegree, true);
+    ellipticLevelConvert(elliptic, elliptic->ogs->o_invDegree, true);
+    elliptic->o_invDegree = elliptic->ogs->o_invDegree;
+  }
   
   return elliptic;
 }
@@ -79,7 +79,17 @@ int main(int argc, char **argv){
 
   elliptic_t *elliptic = ellipticSetup(mesh, lambda, kernelInfo, options);
 
-  if(options.compareArgs("BENCHMARK", "BK5") ||
+  occaKernelBuildReport(mesh);
+
+  if(options.compareArgs("BENCHMARK", "HOST")){
+    // host overhead of option dispatch and enqueue per Ax
+    ellipticBenchmarkHostOverhead(elliptic, lambda);
+  }
+  else if(options.compareArgs("BENCHMARK", "VECTORS")){
+    // bandwidth of the (fused) Krylov vector kernels
+    ellipticBenchmarkVectorKernels(elliptic);
+  }
+  else if(options.compareArgs("BENCHMARK", "BK5") ||
      options.compareArgs("BENCHMARK", "BP5")){
     
     // test Ax throughput
@@ -31,27 +31,26 @@ void ellipticMultigridAx(void **args, occa::memory &o_x, occa::memory &o_Ax) {
   elliptic_t *elliptic = (elliptic_t *) args[0];
   dfloat *lambda = (dfloat *) args[1];
 
-  ellipticOperator(elliptic,*lambda,o_x,o_Ax, dfloatString); // "float" ); // hard coded for testing (should make an option)
+  ellipticOperator(elliptic,*lambda,o_x,o_Ax, elliptic->floatPrecision ? "float" : dfloatString);
 }
 
 void ellipticMultigridCoarsen(void **args, occa::memory &o_x, occa::memory &o_Rx) {
 
   elliptic_t *elliptic = (elliptic_t *) args[0];
   elliptic_t *Felliptic = (elliptic_t *) args[1];
-  setupAide options = elliptic->options;
 
   mesh_t *mesh = elliptic->mesh;
   mesh_t *Fmesh = Felliptic->mesh;
   precon_t *precon = elliptic->precon;
   occa::memory o_R = elliptic->o_R;
 
-  if (options.compareArgs("DISCRETIZATION","CONTINUOUS"))
+  if (elliptic->settings.continuous)
     Felliptic->dotMultiplyKernel(Fmesh->Nelements*Fmesh->Np, Fmesh->ogs->o_invDegree, o_x, o_x);
 
   precon->coarsenKernel(mesh->Nelements, o_R, o_x, o_Rx);
 
-  if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
-    ogsGatherScatter(o_Rx, ogsDfloat, ogsAdd, mesh->ogs);  
+  if (elliptic->settings.continuous) {
+    ogsGatherScatter(o_Rx, elliptic->floatPrecision ? ogsFloat : ogsDfloat, ogsAdd, mesh->ogs);  
     if (elliptic->Nmasked) mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Rx);
   }
 }
@@ -73,7 +72,6 @@ void ellipticGather(void **args, occa::memory &o_x, occa::memory &o_Gx) {
   occa::memory *o_s= (occa::memory *) args[2];
   
   mesh_t *mesh      = elliptic->mesh;
-  setupAide options = elliptic->options;
 
   ogsGather(o_Gx, o_x, ogsDfloat, ogsAdd, ogs);
   elliptic->dotMultiplyKernel(ogs->Ngather, ogs->o_gatherInvDegree, o_Gx, o_Gx);
@@ -86,7 +84,6 @@ void ellipticScatter(void **args, occa::memory &o_x, occa::memory &o_Sx) {
   occa::memory *o_s= (occa::memory *) args[2];
   
   mesh_t *mesh      = elliptic->mesh;
-  setupAide options = elliptic->options;
 
   ogsScatter(o_Sx, o_x, ogsDfloat, ogsAdd, ogs);
 }
@@ -105,6 +102,7 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
     meshLevels[n] = (mesh_t *) calloc(1,sizeof(mesh_t));
     meshLevels[n]->Nverts = mesh->Nverts;
     meshLevels[n]->Nfaces = mesh->Nfaces;
+    meshLevels[n]->comm = mesh->comm;
     
     switch(elliptic->elementType){
     case TRIANGLES:
@@ -168,14 +166,21 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
   precon->parAlmond = parAlmondInit(mesh, elliptic->options);
   agmgLevel **levels = precon->parAlmond->levels;
 
+  //a degree 1 problem goes straight to AMG in double precision
+  bool floatMultigrid = elliptic->settings.floatMultigrid && (numLevels>1);
+  elliptic->settings.floatMultigrid = floatMultigrid;
+
   //build a elliptic struct for every degree
   elliptic_t **ellipticsN = (elliptic_t**) calloc(mesh->N+1,sizeof(elliptic_t*));
   ellipticsN[mesh->N] = elliptic; //top level
+  if (floatMultigrid) //fp32 copy of the top level for the preconditioner
+    ellipticsN[mesh->N] = ellipticBuildMultigridLevel(elliptic,mesh->N,mesh->N,1);
   for (int n=1;n<numLevels;n++) {  //build elliptic for this degree
     int Nf = levelDegree[n-1];
     int Nc = levelDegree[n];
     printf("=============BUILDING MULTIGRID LEVEL OF DEGREE %d==================\n", Nc);
-    ellipticsN[Nc] = ellipticBuildMultigridLevel(elliptic,Nc,Nf);
+    //all levels above the degree 1 AMG level run in fp32 when requested
+    ellipticsN[Nc] = ellipticBuildMultigridLevel(elliptic,Nc,Nf,floatMultigrid && (n<numLevels-1));
   }
 
   // set multigrid operators for fine levels
@@ -187,6 +192,7 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
     precon->parAlmond->numLevels++;
     levels[n] = (agmgLevel *) calloc(1,sizeof(agmgLevel));
     levels[n]->gatherLevel = false;   //dont gather this level
+    levels[n]->floatPrecision = ellipticL->floatPrecision;
     if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {//use weighted inner products
       precon->parAlmond->levels[n]->weightedInnerProds = true;
       precon->parAlmond->levels[n]->o_weight = ellipticL->o_invDegree;
@@ -206,6 +212,8 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
     levels[n]->Nrows = mesh->Nelements*ellipticL->mesh->Np;
     levels[n]->Ncols = (mesh->Nelements+mesh->totalHaloPairs)*ellipticL->mesh->Np;
 
+    size_t NcolsBytes = levels[n]->Ncols*(ellipticL->floatPrecision ? sizeof(float) : sizeof(dfloat));
+
     if (options.compareArgs("MULTIGRID SMOOTHER","CHEBYSHEV")) {
       if (!options.getArgs("MULTIGRID CHEBYSHEV DEGREE", levels[n]->ChebyshevIterations))
         levels[n]->ChebyshevIterations = 2; //default to degree 2
@@ -215,14 +223,14 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
       levels[n]->smootherResidual = (dfloat *) calloc(levels[n]->Ncols,sizeof(dfloat));
 
       // extra storage for smoothing op
-      levels[n]->o_smootherResidual = mesh->device.malloc(levels[n]->Ncols*sizeof(dfloat),levels[n]->smootherResidual);
-      levels[n]->o_smootherResidual2 = mesh->device.malloc(levels[n]->Ncols*sizeof(dfloat),levels[n]->smootherResidual);
-      levels[n]->o_smootherUpdate = mesh->device.malloc(levels[n]->Ncols*sizeof(dfloat),levels[n]->smootherResidual);
+      levels[n]->o_smootherResidual = mesh->device.malloc(NcolsBytes,levels[n]->smootherResidual);
+      levels[n]->o_smootherResidual2 = mesh->device.malloc(NcolsBytes,levels[n]->smootherResidual);
+      levels[n]->o_smootherUpdate = mesh->device.malloc(NcolsBytes,levels[n]->smootherResidual);
     } else {
       levels[n]->device_smooth = ellipticMultigridSmooth;
 
       // extra storage for smoothing op
-      levels[n]->o_smootherResidual = mesh->device.malloc(levels[n]->Ncols*sizeof(dfloat));
+      levels[n]->o_smootherResidual = mesh->device.malloc(NcolsBytes);
     }
 
     levels[n]->smootherArgs = (void **) calloc(2,sizeof(void*));
@@ -370,6 +378,12 @@ void ellipticMultiGridSetup(elliptic_t *elliptic, precon_t* precon, dfloat lambd
     levels[n]->device_prolongate = ellipticMultigridProlongate;
   }
 
+  //fp32 rhs and solution handed to parAlmond by the fp64 Krylov solver
+  if (floatMultigrid) {
+    precon->o_rFloat = mesh->device.malloc(mesh->Nelements*mesh->Np*sizeof(float));
+    precon->o_zFloat = mesh->device.malloc(mesh->Nelements*mesh->Np*sizeof(float));
+  }
+
   for (int n=1;n<mesh->N+1;n++) free(meshLevels[n]);
   free(meshLevels);
 }
@@ -432,7 +446,7 @@ void buildCoarsenerTriTet(elliptic_t* elliptic, mesh_t **meshLevels, int Nf, int
       elliptic->R[i*NpFine+j] = P[j*NpCoarse+i];
     }
   }
-  elliptic->o_R = elliptic->mesh->device.malloc(NpFine*NpCoarse*sizeof(dfloat), elliptic->R);
+  elliptic->o_R = ellipticLevelMalloc(elliptic, NpFine*NpCoarse, elliptic->R);
 
   free(P); free(Ptmp);
 }
@@ -473,7 +487,7 @@ void buildCoarsenerQuadHex(elliptic_t* elliptic, mesh_t **meshLevels, int Nf, in
       elliptic->R[i*NqFine+j] = P[j*NqCoarse+i];
     }
   }
-  elliptic->o_R = elliptic->mesh->device.malloc(NqFine*NqCoarse*sizeof(dfloat), elliptic->R);
+  elliptic->o_R = ellipticLevelMalloc(elliptic, NqFine*NqCoarse, elliptic->R);
 
   free(P); free(Ptmp);
 }
@@ -26,10 +26,33 @@ SOFTWARE.
 
 #include "elliptic.h"
 
+// continuous Ax on a list of elements, lambda passed in the precision of the level
+static void ellipticPartialAx(elliptic_t *elliptic, occa::kernel &partialAxKernel, dlong Nelements,
+                              occa::memory &o_elementList, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  if(elliptic->settings.elementMap==ELLIPTIC_TRILINEAR){
+    if(elliptic->floatPrecision)
+      partialAxKernel(Nelements, o_elementList,
+                      elliptic->o_EXYZ, elliptic->o_gllzw, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, (float) lambda, o_q, o_Aq);
+    else
+      partialAxKernel(Nelements, o_elementList,
+                      elliptic->o_EXYZ, elliptic->o_gllzw, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
+  } else {
+    if(elliptic->floatPrecision)
+      partialAxKernel(Nelements, o_elementList,
+                      mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, (float) lambda, o_q, o_Aq);
+    else
+      partialAxKernel(Nelements, o_elementList,
+                      mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
+  }
+}
+
 void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, occa::memory &o_Aq, const char *precision){
 
   mesh_t *mesh = elliptic->mesh;
-  setupAide options = elliptic->options;
+  ellipticSettings_t &settings = elliptic->settings;
 
   occaTimerTic(mesh->device,"AxKernel");
 
@@ -44,56 +67,53 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
   occa::memory &o_tmp = elliptic->o_tmp;
   
 
-  if(options.compareArgs("DISCRETIZATION", "CONTINUOUS")){
+  if(settings.discretization==ELLIPTIC_CONTINUOUS){
     ogs_t *ogs = elliptic->ogs;
 
-    int mapType = (elliptic->elementType==HEXAHEDRA &&
-                   options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? 1:0;
+    // fp32 multigrid levels keep their vectors in float
+    const char *ogsType = (elliptic->floatPrecision) ? ogsFloat : ogsDfloat;
 
     occa::kernel &partialAxKernel = (strstr(precision, "float")) ? elliptic->partialFloatAxKernel : elliptic->partialAxKernel;
     
-    if(mesh->NglobalGatherElements) {
-      if(mapType==0)
-        partialAxKernel(mesh->NglobalGatherElements, mesh->o_globalGatherElementList,
-                        mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
-      else
-        partialAxKernel(mesh->NglobalGatherElements, mesh->o_globalGatherElementList,
-                        elliptic->o_EXYZ, elliptic->o_gllzw, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
-    }
+    if(mesh->NglobalGatherElements)
+      ellipticPartialAx(elliptic, partialAxKernel, mesh->NglobalGatherElements,
+                        mesh->o_globalGatherElementList, lambda, o_q, o_Aq);
 
-    ogsGatherScatterStart(o_Aq, ogsDfloat, ogsAdd, ogs);
+    ogsGatherScatterStart(o_Aq, ogsType, ogsAdd, ogs);
 
-    if(mesh->NlocalGatherElements){
-      if(mapType==0)
-        partialAxKernel(mesh->NlocalGatherElements, mesh->o_localGatherElementList,
-                                  mesh->o_ggeo, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
-      else
-        partialAxKernel(mesh->NlocalGatherElements, mesh->o_localGatherElementList,
-                        elliptic->o_EXYZ, elliptic->o_gllzw, mesh->o_Dmatrices, mesh->o_Smatrices, mesh->o_MM, lambda, o_q, o_Aq);
-    }
+    if(mesh->NlocalGatherElements)
+      ellipticPartialAx(elliptic, partialAxKernel, mesh->NlocalGatherElements,
+                        mesh->o_localGatherElementList, lambda, o_q, o_Aq);
     
     // finalize gather using local and global contributions
-    ogsGatherScatterFinish(o_Aq, ogsDfloat, ogsAdd, ogs);
+    ogsGatherScatterFinish(o_Aq, ogsType, ogsAdd, ogs);
 
     if(elliptic->allNeumann) {
       // mesh->sumKernel(mesh->Nelements*mesh->Np, o_q, o_tmp);
       elliptic->innerProductKernel(mesh->Nelements*mesh->Np, elliptic->o_invDegree, o_q, o_tmp);
       o_tmp.copyTo(tmp);
 
-      for(dlong n=0;n<Nblock;++n)
-        alpha += tmp[n];
+      if(elliptic->floatPrecision)
+        for(dlong n=0;n<Nblock;++n)
+          alpha += ((float*) tmp)[n];
+      else
+        for(dlong n=0;n<Nblock;++n)
+          alpha += tmp[n];
 
       MPI_Allreduce(&alpha, &alphaG, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
       alphaG *= elliptic->allNeumannPenalty*elliptic->allNeumannScale*elliptic->allNeumannScale;
 
-      mesh->addScalarKernel(mesh->Nelements*mesh->Np, alphaG, o_Aq);
+      if(elliptic->floatPrecision)
+        mesh->addScalarKernel(mesh->Nelements*mesh->Np, (float) alphaG, o_Aq);
+      else
+        mesh->addScalarKernel(mesh->Nelements*mesh->Np, alphaG, o_Aq);
     }
 
     //post-mask
     if (elliptic->Nmasked) 
       mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_Aq);
 
-  } else if(options.compareArgs("DISCRETIZATION", "IPDG")) {
+  } else if(settings.discretization==ELLIPTIC_IPDG) {
     dlong offset = 0;
     dfloat alpha = 0., alphaG =0.;
     dlong Nblock = elliptic->Nblock;
@@ -102,14 +122,14 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
 
     ellipticStartHaloExchange(elliptic, o_q, mesh->Np, sendBuffer, recvBuffer);
 
-    if(options.compareArgs("BASIS", "NODAL")) {
+    if(settings.basis==ELLIPTIC_NODAL) {
       elliptic->partialGradientKernel(mesh->Nelements,
           offset,
           mesh->o_vgeo,
           mesh->o_Dmatrices,
           o_q,
           elliptic->o_grad);
-    } else if(options.compareArgs("BASIS", "BERN")) {
+    } else if(settings.basis==ELLIPTIC_BERN) {
       elliptic->partialGradientKernel(mesh->Nelements,
           offset,
           mesh->o_vgeo,
@@ -129,7 +149,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
       mesh->sumKernel(mesh->Nelements*mesh->Np, o_q, o_tmp);
 
     if(mesh->NinternalElements) {
-      if(options.compareArgs("BASIS", "NODAL")) {
+      if(settings.basis==ELLIPTIC_NODAL) {
         elliptic->partialIpdgKernel(mesh->NinternalElements,
             mesh->o_internalElementIds,
             mesh->o_vmapM,
@@ -144,7 +164,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
             mesh->o_MM,
             elliptic->o_grad,
             o_Aq);
-      } else if(options.compareArgs("BASIS", "BERN")) {
+      } else if(settings.basis==ELLIPTIC_BERN) {
         elliptic->partialIpdgKernel(mesh->NinternalElements,
             mesh->o_internalElementIds,
             mesh->o_vmapM,
@@ -181,14 +201,14 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
 
     if(mesh->totalHaloPairs){
       offset = mesh->Nelements;
-      if(options.compareArgs("BASIS", "NODAL")) {
+      if(settings.basis==ELLIPTIC_NODAL) {
         elliptic->partialGradientKernel(mesh->totalHaloPairs,
             offset,
             mesh->o_vgeo,
             mesh->o_Dmatrices,
             o_q,
             elliptic->o_grad);
-      } else if(options.compareArgs("BASIS", "BERN")) {
+      } else if(settings.basis==ELLIPTIC_BERN) {
         elliptic->partialGradientKernel(mesh->totalHaloPairs,
             offset,
             mesh->o_vgeo,
@@ -202,7 +222,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
     }
 
     if(mesh->NnotInternalElements) {
-      if(options.compareArgs("BASIS", "NODAL")) {
+      if(settings.basis==ELLIPTIC_NODAL) {
         elliptic->partialIpdgKernel(mesh->NnotInternalElements,
             mesh->o_notInternalElementIds,
             mesh->o_vmapM,
@@ -217,7 +237,7 @@ void ellipticOperator(elliptic_t *elliptic, dfloat lambda, occa::memory &o_q, oc
             mesh->o_MM,
             elliptic->o_grad,
             o_Aq);
-      } else if(options.compareArgs("BASIS", "BERN")) {
+      } else if(settings.basis==ELLIPTIC_BERN) {
         elliptic->partialIpdgKernel(mesh->NnotInternalElements,
             mesh->o_notInternalElementIds,
             mesh->o_vmapM,
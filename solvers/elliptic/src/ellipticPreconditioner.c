@@ -31,24 +31,35 @@ void ellipticPreconditioner(elliptic_t *elliptic, dfloat lambda,
 
   mesh_t *mesh = elliptic->mesh;
   precon_t *precon = elliptic->precon;
-  setupAide options = elliptic->options;
+  ellipticSettings_t &settings = elliptic->settings;
   
-  if (   options.compareArgs("PRECONDITIONER", "FULLALMOND")
-      || options.compareArgs("PRECONDITIONER", "MULTIGRID")) {
+  if (settings.floatMultigrid) {
+
+    dlong Ntotal = mesh->Np*mesh->Nelements;
+
+    // fp32 p-multigrid cycle between fp64 copies of r and z
+    occaTimerTic(mesh->device,"parALMOND");
+    elliptic->dfloatToFloatKernel(Ntotal, o_r, precon->o_rFloat);
+    parAlmondPrecon(precon->parAlmond, precon->o_zFloat, precon->o_rFloat);
+    elliptic->floatToDfloatKernel(Ntotal, precon->o_zFloat, o_z);
+    occaTimerToc(mesh->device,"parALMOND");
+
+  } else if (   settings.preconditioner==ELLIPTIC_PRECON_FULLALMOND
+             || settings.preconditioner==ELLIPTIC_PRECON_MULTIGRID) {
 
     occaTimerTic(mesh->device,"parALMOND");
     parAlmondPrecon(precon->parAlmond, o_z, o_r);
     occaTimerToc(mesh->device,"parALMOND");
 
-  } else if(options.compareArgs("PRECONDITIONER", "MASSMATRIX")){
+  } else if(settings.preconditioner==ELLIPTIC_PRECON_MASSMATRIX){
 
     dfloat invLambda = 1./lambda;
 
-    if (options.compareArgs("DISCRETIZATION", "IPDG")) {
+    if (settings.discretization==ELLIPTIC_IPDG) {
       occaTimerTic(mesh->device,"blockJacobiKernel");
       precon->blockJacobiKernel(mesh->Nelements, invLambda, mesh->o_vgeo, precon->o_invMM, o_r, o_z);
       occaTimerToc(mesh->device,"blockJacobiKernel");
-    } else if (options.compareArgs("DISCRETIZATION", "CONTINUOUS")) {
+    } else if (settings.discretization==ELLIPTIC_CONTINUOUS) {
       ogs_t *ogs = elliptic->ogs;
 
       elliptic->dotMultiplyKernel(mesh->Nelements*mesh->Np, ogs->o_invDegree, o_r, elliptic->o_rtmp);
@@ -73,7 +84,7 @@ void ellipticPreconditioner(elliptic_t *elliptic, dfloat lambda,
       if (elliptic->Nmasked) mesh->maskKernel(elliptic->Nmasked, elliptic->o_maskIds, o_z);
     }
 
-  } else if (options.compareArgs("PRECONDITIONER", "SEMFEM")) {
+  } else if (settings.preconditioner==ELLIPTIC_PRECON_SEMFEM) {
 
     if (elliptic->elementType==TRIANGLES||elliptic->elementType==TETRAHEDRA) {
       o_z.copyFrom(o_r);
@@ -95,7 +106,7 @@ void ellipticPreconditioner(elliptic_t *elliptic, dfloat lambda,
       occaTimerToc(mesh->device,"parALMOND");
     }
 
-  } else if(options.compareArgs("PRECONDITIONER", "JACOBI")){
+  } else if(settings.preconditioner==ELLIPTIC_PRECON_JACOBI){
 
     dlong Ntotal = mesh->Np*mesh->Nelements;
     // Jacobi preconditioner
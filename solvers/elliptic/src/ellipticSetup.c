@@ -155,14 +155,14 @@ elliptic_t *ellipticSetup(mesh_t *mesh, dfloat lambda, occa::properties &kernelI
 
   //add boundary condition contribution to rhs
   if (options.compareArgs("DISCRETIZATION","IPDG")) {
-    for(int r=0;r<mesh->size;++r){
-      if(r==mesh->rank){
+    for (int r=0;r<occaKernelBuildRounds;r++) {
+      if (occaKernelBuildTurn(mesh, r)) {
 	sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBCIpdg%s.okl", suffix);
 	sprintf(kernelName, "ellipticRhsBCIpdg%s", suffix);
 	
 	elliptic->rhsBCIpdgKernel = mesh->device.buildKernel(fileName,kernelName, kernelInfo);
       }
-      MPI_Barrier(mesh->comm);
+      occaKernelBuildDone(mesh, r);
     }
     dfloat zero = 0.f;
     elliptic->rhsBCIpdgKernel(mesh->Nelements,
@@ -182,8 +182,8 @@ elliptic_t *ellipticSetup(mesh_t *mesh, dfloat lambda, occa::properties &kernelI
   }
 
   if (options.compareArgs("DISCRETIZATION","CONTINUOUS")) {
-    for(int r=0;r<mesh->size;++r){
-      if(r==mesh->rank){
+    for (int r=0;r<occaKernelBuildRounds;r++) {
+      if (occaKernelBuildTurn(mesh, r)) {
 	sprintf(fileName, DELLIPTIC "/okl/ellipticRhsBC%s.okl", suffix);
 	sprintf(kernelName, "ellipticRhsBC%s", suffix);
 	
@@ -194,7 +194,7 @@ elliptic_t *ellipticSetup(mesh_t *mesh, dfloat lambda, occa::properties &kernelI
 	
 	elliptic->addBCKernel = mesh->device.buildKernel(fileName,kernelName, kernelInfo);
       }
-      MPI_Barrier(mesh->comm);
+      occaKernelBuildDone(mesh, r);
     }
     
     dfloat zero = 0.f;
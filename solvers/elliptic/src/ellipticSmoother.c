@@ -42,11 +42,11 @@ void ellipticMultigridSmooth(void **args, occa::memory &o_r, occa::memory &o_x,
 
   //res = r-Ax
   level->device_Ax(level->AxArgs,o_x,o_res);
-  elliptic->scaledAddKernel(level->Nrows,one, o_r, mone, o_res);
+  ellipticScaledAdd(elliptic, one, o_r, mone, o_res);
 
   //smooth the fine problem x = x + S(r-Ax)
   level->device_smoother(level->smootherArgs, o_res, o_res);
-  elliptic->scaledAddKernel(level->Nrows,one, o_res, one, o_x);
+  ellipticScaledAdd(elliptic, one, o_res, one, o_x);
 }
 
 void ellipticMultigridSmoothChebyshev(void **args, occa::memory &o_r, occa::memory &o_x, bool xIsZero) {
@@ -70,44 +70,64 @@ void ellipticMultigridSmoothChebyshev(void **args, occa::memory &o_r, occa::memo
   occa::memory o_Ad  = level->o_smootherResidual2;
   occa::memory o_d   = level->o_smootherUpdate;
 
-  if(xIsZero){ //skip the Ax if x is zero
-    //res = Sr
-    level->device_smoother(level->smootherArgs, o_r, o_res);
+  // damped Jacobi is applied inside the fused Chebyshev kernels; otherwise
+  // invDiagA is not read and stands in with the read-only Ad, not a written array
+  int jacobi = (level->device_smoother==dampedJacobi);
+  occa::memory o_invDiagA = jacobi ? elliptic->precon->o_invDiagA : o_Ad;
 
-    //d = invTheta*res
-    elliptic->scaledAddKernel(level->Nrows, invTheta, o_res, zero, o_d);
+  if (jacobi) {
+    //res = S(r-Ax) in place, d = invTheta*res, skipping the Ax if x is zero
+    if (!xIsZero)
+      level->device_Ax(level->AxArgs,o_x,o_res);
+
+    if (elliptic->floatPrecision)
+      elliptic->chebyshevStartKernel(level->Nrows, (int) xIsZero, (float) invTheta,
+                                     o_invDiagA, o_r, o_res, o_d);
+    else
+      elliptic->chebyshevStartKernel(level->Nrows, (int) xIsZero, invTheta,
+                                     o_invDiagA, o_r, o_res, o_d);
   } else {
-    //res = S(r-Ax)
-    level->device_Ax(level->AxArgs,o_x,o_res);
-    elliptic->scaledAddKernel(level->Nrows, one, o_r, mone, o_res);
-    level->device_smoother(level->smootherArgs, o_res, o_res);
+    if(xIsZero){ //skip the Ax if x is zero
+      //res = Sr
+      level->device_smoother(level->smootherArgs, o_r, o_res);
+    } else {
+      //res = S(r-Ax)
+      level->device_Ax(level->AxArgs,o_x,o_res);
+      ellipticScaledAdd(elliptic, one, o_r, mone, o_res);
+      level->device_smoother(level->smootherArgs, o_res, o_res);
+    }
 
     //d = invTheta*res
-    elliptic->scaledAddKernel(level->Nrows, invTheta, o_res, zero, o_d);
+    ellipticScaledAdd(elliptic, invTheta, o_res, zero, o_d);
   }
 
   for (int k=0;k<level->ChebyshevIterations;k++) {
-    //x_k+1 = x_k + d_k
-    if (xIsZero&&(k==0))
-      elliptic->scaledAddKernel(level->Nrows, one, o_d, zero, o_x);
-    else
-      elliptic->scaledAddKernel(level->Nrows, one, o_d, one, o_x);
-
-    //r_k+1 = r_k - SAd_k
+    //Ad_k = S*A*d_k, S applied in the update for damped Jacobi
     level->device_Ax(level->AxArgs,o_d,o_Ad);
-    level->device_smoother(level->smootherArgs, o_Ad, o_Ad);
-    elliptic->scaledAddKernel(level->Nrows, mone, o_Ad, one, o_res);
+    if (!jacobi)
+      level->device_smoother(level->smootherArgs, o_Ad, o_Ad);
 
     rho_np1 = 1.0/(2.*sigma-rho_n);
     dfloat rhoDivDelta = 2.0*rho_np1/delta;
 
+    //r_k+1 = r_k - SAd_k, x_k+1 = x_k + d_k,
     //d_k+1 = rho_k+1*rho_k*d_k  + 2*rho_k+1*r_k+1/delta
-    elliptic->scaledAddKernel(level->Nrows, rhoDivDelta, o_res, rho_np1*rho_n, o_d);
+    if (elliptic->floatPrecision)
+      elliptic->chebyshevUpdateKernel(level->Nrows, jacobi, (int) (xIsZero&&(k==0)),
+                                      (float) rhoDivDelta, (float) (rho_np1*rho_n),
+                                      o_invDiagA, o_Ad, o_res, o_d, o_x);
+    else
+      elliptic->chebyshevUpdateKernel(level->Nrows, jacobi, (int) (xIsZero&&(k==0)),
+                                      rhoDivDelta, rho_np1*rho_n,
+                                      o_invDiagA, o_Ad, o_res, o_d, o_x);
 
     rho_n = rho_np1;
   }
   //x_k+1 = x_k + d_k
-  elliptic->scaledAddKernel(level->Nrows, one, o_d, one, o_x);
+  if (xIsZero&&(level->ChebyshevIterations==0))
+    ellipticScaledAdd(elliptic, one, o_d, zero, o_x);
+  else
+    ellipticScaledAdd(elliptic, one, o_d, one, o_x);
 
 }
 
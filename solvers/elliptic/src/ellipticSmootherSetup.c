@@ -61,14 +61,14 @@ void ellipticSetupSmootherLocalPatch(elliptic_t *elliptic, precon_t *precon,
   //initialize the full inverse operators on each 4 element patch
   ellipticBuildLocalPatches(elliptic, lambda, rateTolerance, &Npatches, &patchesIndex, &invAP);
 
-  precon->o_invAP = mesh->device.malloc(Npatches*NpP*NpP*sizeof(dfloat),invAP);
+  precon->o_invAP = ellipticLevelMalloc(elliptic, Npatches*NpP*NpP, invAP);
   precon->o_patchesIndex = mesh->device.malloc(mesh->Nelements*sizeof(dlong), patchesIndex);
 
   dfloat *invDegree = (dfloat*) calloc(mesh->Nelements,sizeof(dfloat));
   for (dlong e=0;e<mesh->Nelements;e++) {
     invDegree[e] = 1.0;
   }
-  precon->o_invDegreeAP = mesh->device.malloc(mesh->Nelements*sizeof(dfloat),invDegree);
+  precon->o_invDegreeAP = ellipticLevelMalloc(elliptic, mesh->Nelements, invDegree);
 
   level->device_smoother = LocalPatch;
 
@@ -91,7 +91,8 @@ void ellipticSetupSmootherLocalPatch(elliptic_t *elliptic, precon_t *precon,
       invDegree[e] *= weight;
 
     //update with weight
-    precon->o_invDegreeAP.copyFrom(invDegree);
+    precon->o_invDegreeAP.free();
+    precon->o_invDegreeAP = ellipticLevelMalloc(elliptic, mesh->Nelements, invDegree);
   }
   free(invDegree);
 }
@@ -105,7 +106,7 @@ void ellipticSetupSmootherDampedJacobi(elliptic_t *elliptic, precon_t *precon,
 
   ellipticBuildJacobi(elliptic,lambda, &invDiagA);
 
-  precon->o_invDiagA = mesh->device.malloc(mesh->Np*mesh->Nelements*sizeof(dfloat), invDiagA);
+  precon->o_invDiagA = ellipticLevelMalloc(elliptic, mesh->Np*mesh->Nelements, invDiagA);
     
   level->device_smoother = dampedJacobi;
 
@@ -128,7 +129,8 @@ void ellipticSetupSmootherDampedJacobi(elliptic_t *elliptic, precon_t *precon,
       invDiagA[n] *= weight;
 
     //update diagonal with weight
-    precon->o_invDiagA.copyFrom(invDiagA);
+    precon->o_invDiagA.free();
+    precon->o_invDiagA = ellipticLevelMalloc(elliptic, mesh->Np*mesh->Nelements, invDiagA);
   }
 
   free(invDiagA);
@@ -184,11 +186,11 @@ dfloat maxEigSmoothAx(elliptic_t* elliptic, agmgLevel *level){
   dfloat *Vx = (dfloat*) calloc(M, sizeof(dfloat));
   occa::memory *o_V = (occa::memory *) calloc(k+1, sizeof(occa::memory));
   
-  occa::memory o_Vx  = mesh->device.malloc(M*sizeof(dfloat),Vx);
-  occa::memory o_AVx = mesh->device.malloc(M*sizeof(dfloat),Vx);
+  // basis is kept in the precision of the level
+  occa::memory o_AVx = ellipticLevelMalloc(elliptic, M, Vx);
 
   for(int i=0; i<=k; i++)
-    o_V[i] = mesh->device.malloc(M*sizeof(dfloat),Vx);
+    o_V[i] = ellipticLevelMalloc(elliptic, M, Vx);
 
   // generate a random vector for initial basis vector
   for (dlong i=0;i<N;i++) Vx[i] = (dfloat) drand48(); 
@@ -200,7 +202,7 @@ dfloat maxEigSmoothAx(elliptic_t* elliptic, agmgLevel *level){
     for (dlong i=0;i<elliptic->Nmasked;i++) Vx[elliptic->maskIds[i]] = 0.;
   }
 
-  o_Vx.copyFrom(Vx); //copy to device
+  occa::memory o_Vx = ellipticLevelMalloc(elliptic, M, Vx); //copy to device
   dfloat norm_vo = ellipticWeightedInnerProduct(elliptic, elliptic->o_invDegree, o_Vx, o_Vx);
   norm_vo = sqrt(norm_vo);
 
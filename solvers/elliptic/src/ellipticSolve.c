@@ -30,23 +30,26 @@ int ellipticSolve(elliptic_t *elliptic, dfloat lambda, dfloat tol,
                   occa::memory &o_r, occa::memory &o_x){
 
   mesh_t *mesh = elliptic->mesh;
-  setupAide options = elliptic->options;
+  ellipticSettings_t &settings = elliptic->settings;
 
   int Niter = 0;
   int maxIter = 5000; 
 
   double start = 0.0, end =0.0;
 
-  if(options.compareArgs("VERBOSE","TRUE")){
+  if(settings.verbose){
     mesh->device.finish();
     start = MPI_Wtime(); 
   }
 
   occaTimerTic(mesh->device,"Linear Solve");
-  Niter = pcg (elliptic, lambda, o_r, o_x, tol, maxIter);
+  if(settings.krylov==ELLIPTIC_PCG_PIPELINED)
+    Niter = ppcg(elliptic, lambda, o_r, o_x, tol, maxIter);
+  else
+    Niter = pcg (elliptic, lambda, o_r, o_x, tol, maxIter);
   occaTimerToc(mesh->device,"Linear Solve");
 
-  if(options.compareArgs("VERBOSE","TRUE")){
+  if(settings.verbose){
     mesh->device.finish();
     end = MPI_Wtime();
     double localElapsed = end-start;
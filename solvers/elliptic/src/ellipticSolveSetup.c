@@ -27,11 +27,99 @@ SOFTWARE.
 #include "elliptic.h"
 
 
+// resolve the string options once so the solve path never copies or scans setupAide
+void ellipticResolveOptions(elliptic_t *elliptic){
+
+  setupAide &options = elliptic->options;
+  ellipticSettings_t &settings = elliptic->settings;
+
+  settings.discretization = options.compareArgs("DISCRETIZATION", "IPDG") ? ELLIPTIC_IPDG : ELLIPTIC_CONTINUOUS;
+  settings.basis = options.compareArgs("BASIS", "BERN") ? ELLIPTIC_BERN : ELLIPTIC_NODAL;
+
+  if (options.compareArgs("PRECONDITIONER", "FULLALMOND"))
+    settings.preconditioner = ELLIPTIC_PRECON_FULLALMOND;
+  else if (options.compareArgs("PRECONDITIONER", "MULTIGRID"))
+    settings.preconditioner = ELLIPTIC_PRECON_MULTIGRID;
+  else if (options.compareArgs("PRECONDITIONER", "MASSMATRIX"))
+    settings.preconditioner = ELLIPTIC_PRECON_MASSMATRIX;
+  else if (options.compareArgs("PRECONDITIONER", "SEMFEM"))
+    settings.preconditioner = ELLIPTIC_PRECON_SEMFEM;
+  else if (options.compareArgs("PRECONDITIONER", "JACOBI"))
+    settings.preconditioner = ELLIPTIC_PRECON_JACOBI;
+  else
+    settings.preconditioner = ELLIPTIC_PRECON_NONE;
+
+  if (options.compareArgs("KRYLOV SOLVER", "PIPELINED"))
+    settings.krylov = ELLIPTIC_PCG_PIPELINED;
+  else if (options.compareArgs("KRYLOV SOLVER", "PCG+FLEXIBLE") ||
+           options.compareArgs("KRYLOV SOLVER", "PCG,FLEXIBLE"))
+    settings.krylov = ELLIPTIC_PCG_FLEXIBLE;
+  else
+    settings.krylov = ELLIPTIC_PCG;
+
+  settings.elementMap = (elliptic->elementType==HEXAHEDRA &&
+                         options.compareArgs("ELEMENT MAP", "TRILINEAR")) ? ELLIPTIC_TRILINEAR : ELLIPTIC_ISOPARAMETRIC;
+
+  settings.continuous = (settings.discretization==ELLIPTIC_CONTINUOUS);
+  settings.verbose = options.compareArgs("VERBOSE", "TRUE");
+
+  settings.floatMultigrid = (settings.preconditioner==ELLIPTIC_PRECON_MULTIGRID)
+                         && options.compareArgs("MULTIGRID PRECISION", "FLOAT");
+
+  if (settings.floatMultigrid && (!settings.continuous
+                                  || options.compareArgs("PARALMOND CYCLE", "HOST")
+                                  || options.compareArgs("PARALMOND CYCLE", "EXACT"))) {
+    if (elliptic->mesh->rank==0)
+      printf("WARNING: MULTIGRID PRECISION FLOAT needs a CONTINUOUS discretization and a device KCYCLE or VCYCLE, using DOUBLE\n");
+    settings.floatMultigrid = false;
+  }
+
+  // the fp32 preconditioner is not exactly linear in fp64, so keep the outer PCG flexible
+  if (settings.floatMultigrid && settings.krylov==ELLIPTIC_PCG_PIPELINED) {
+    if (elliptic->mesh->rank==0)
+      printf("WARNING: PIPELINED PCG requires a fixed preconditioner, using flexible PCG with MULTIGRID PRECISION FLOAT\n");
+    settings.krylov = ELLIPTIC_PCG_FLEXIBLE;
+  }
+  if (settings.floatMultigrid && settings.krylov==ELLIPTIC_PCG)
+    settings.krylov = ELLIPTIC_PCG_FLEXIBLE;
+}
+
+// true on all ranks if both solvers discretize the same operator: same mesh,
+// options and lambda, and the same boundary condition on every tagged face
+bool ellipticSameOperator(elliptic_t *elliptic, elliptic_t *other){
+
+  mesh_t *mesh = elliptic->mesh;
+
+  int same = (mesh==other->mesh)
+          && (elliptic->lambda==other->lambda)
+          && (elliptic->options.getKeyword()==other->options.getKeyword())
+          && (elliptic->options.getData()==other->options.getData());
+
+  if (same) {
+    for (dlong n=0;n<mesh->Nelements*mesh->Nfaces;n++) {
+      int bc = mesh->EToB[n];
+      if (bc>0 && elliptic->BCType[bc]!=other->BCType[bc]) {
+        same = 0;
+        break;
+      }
+    }
+  }
+
+  int allSame = 0;
+  MPI_Allreduce(&same, &allSame, 1, MPI_INT, MPI_MIN, mesh->comm);
+
+  return (allSame==1);
+}
+
 void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &kernelInfo){
 
   mesh_t *mesh = elliptic->mesh;
   setupAide options = elliptic->options;
 
+  ellipticResolveOptions(elliptic);
+
+  elliptic->lambda = lambda;
+
   //sanity checking
   if (options.compareArgs("BASIS","BERN") && elliptic->elementType!=TRIANGLES) {
     printf("ERROR: BERN basis is only available for triangular elements\n");
@@ -49,6 +137,11 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
     MPI_Finalize();
     exit(-1);
   }
+  if (options.compareArgs("KRYLOV SOLVER","PIPELINED") && options.compareArgs("KRYLOV SOLVER","FLEXIBLE")) {
+    printf("ERROR: PIPELINED PCG requires a fixed preconditioner and cannot be FLEXIBLE. \n");
+    MPI_Finalize();
+    exit(-1);
+  }
 
   dlong Ntotal = mesh->Np*mesh->Nelements;
   dlong Nblock = mymax(1,(Ntotal+blockSize-1)/blockSize);
@@ -67,7 +160,7 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   elliptic->z   = (dfloat*) calloc(Nall,   sizeof(dfloat));
   elliptic->Ax  = (dfloat*) calloc(Nall,   sizeof(dfloat));
   elliptic->Ap  = (dfloat*) calloc(Nall,   sizeof(dfloat));
-  elliptic->tmp = (dfloat*) calloc(Nblock, sizeof(dfloat));
+  elliptic->tmp = (dfloat*) calloc(2*Nblock, sizeof(dfloat)); // room for paired reductions
 
   elliptic->grad = (dfloat*) calloc(Nall*4, sizeof(dfloat));
 
@@ -79,11 +172,24 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   elliptic->o_Sres = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
   elliptic->o_Ax  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->p);
   elliptic->o_Ap  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->Ap);
-  elliptic->o_tmp = mesh->device.malloc(Nblock*sizeof(dfloat), elliptic->tmp);
+  elliptic->o_tmp = mesh->device.malloc(2*Nblock*sizeof(dfloat), elliptic->tmp);
   elliptic->o_tmp2 = mesh->device.malloc(Nblock2*sizeof(dfloat), elliptic->tmp);
 
   elliptic->o_grad  = mesh->device.malloc(Nall*4*sizeof(dfloat), elliptic->grad);
 
+  if(options.compareArgs("KRYLOV SOLVER", "PIPELINED")){
+    elliptic->o_u  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_w  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_m  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_n  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_s  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_q  = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+    elliptic->o_Aq = mesh->device.malloc(Nall*sizeof(dfloat), elliptic->z);
+
+    // three partial inner products per block, staged through pinned memory
+    elliptic->pcgDots = (dfloat*) occaHostMallocPinned(mesh->device, 3*Nblock*sizeof(dfloat), NULL, elliptic->o_pcgDots);
+  }
+
   //setup async halo stream
   elliptic->defaultStream = mesh->defaultStream;
   elliptic->dataStream = mesh->dataStream;
@@ -258,9 +364,20 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   //use the masked ids to make another gs handle
   elliptic->ogs = ogsSetup(Ntotal, mesh->maskedGlobalIds, mesh->comm, verbose, mesh->device);
   elliptic->o_invDegree = elliptic->ogs->o_invDegree;
+
+  //exchange the gatherScatter halo directly between neighbors instead of through gslib
+  if(options.compareArgs("HALO EXCHANGE", "GPU-AWARE"))
+    ogsSetHaloExchange(elliptic->ogs, ogsHaloGpuAware);
+  else if(options.compareArgs("HALO EXCHANGE", "PINNED"))
+    ogsSetHaloExchange(elliptic->ogs, ogsHaloPinned);
   
-  /*preconditioner setup */
-  elliptic->precon = (precon_t*) calloc(1, sizeof(precon_t));
+  /*preconditioner setup, reusing the one of a solver with the same operator */
+  bool sharePrecon = elliptic->preconSource && ellipticSameOperator(elliptic, elliptic->preconSource);
+
+  if (sharePrecon)
+    elliptic->precon = elliptic->preconSource->precon;
+  else
+    elliptic->precon = (precon_t*) calloc(1, sizeof(precon_t));
   
   kernelInfo["parser/" "automate-add-barriers"] =  "disabled";
 
@@ -286,8 +403,8 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
 
       //mesh kernels 
       mesh->haloExtractKernel =
@@ -354,6 +471,52 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
           mesh->device.buildKernel(DHOLMES "/okl/dotDivide.okl",
                                          "dotDivide",
                                          kernelInfo);
+
+      elliptic->updatePCGKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/updatePCG.okl",
+                                         "updatePCG",
+                                         kernelInfo);
+
+      elliptic->innerProductPairKernel =
+          mesh->device.buildKernel(DHOLMES "/okl/innerProductPair.okl",
+                                         "innerProductPair",
+                                         kernelInfo);
+
+      if(options.compareArgs("KRYLOV SOLVER", "PIPELINED")){
+        elliptic->pipelinedInnerProductsKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticPipelinedCG.okl",
+                                         "ellipticPipelinedCGInnerProducts",
+                                         kernelInfo);
+
+        elliptic->pipelinedUpdateKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticPipelinedCG.okl",
+                                         "ellipticPipelinedCGUpdate",
+                                         kernelInfo);
+      }
+
+      if(elliptic->settings.floatMultigrid){
+        elliptic->dfloatToFloatKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticPrecision.okl",
+                                         "ellipticDfloatToFloat",
+                                         kernelInfo);
+
+        elliptic->floatToDfloatKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticPrecision.okl",
+                                         "ellipticFloatToDfloat",
+                                         kernelInfo);
+      }
+
+      if(options.compareArgs("MULTIGRID SMOOTHER", "CHEBYSHEV")){
+        elliptic->chebyshevStartKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticChebyshev.okl",
+                                         "ellipticChebyshevStart",
+                                         kernelInfo);
+
+        elliptic->chebyshevUpdateKernel =
+          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticChebyshev.okl",
+                                         "ellipticChebyshevUpdate",
+                                         kernelInfo);
+      }
       
       // add custom defines
       kernelInfo["defines/" "p_NpP"]= (mesh->Np+mesh->Nfp*mesh->Nfaces);
@@ -463,39 +626,49 @@ void ellipticSolveSetup(elliptic_t *elliptic, dfloat lambda, occa::properties &k
         elliptic->partialIpdgKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
       }
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
-      elliptic->precon->coarsenKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+      if (!sharePrecon) {
+        // fine vectors of the coarsen/prolongate kernels share this level's precision
+        kernelInfo["defines/" "fineFloat"]= dfloatString;
+
+        sprintf(fileName, DELLIPTIC "/okl/ellipticPreconCoarsen%s.okl", suffix);
+        sprintf(kernelName, "ellipticPreconCoarsen%s", suffix);
+        elliptic->precon->coarsenKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
-      sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
-      elliptic->precon->prolongateKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+        sprintf(fileName, DELLIPTIC "/okl/ellipticPreconProlongate%s.okl", suffix);
+        sprintf(kernelName, "ellipticPreconProlongate%s", suffix);
+        elliptic->precon->prolongateKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
-      sprintf(kernelName, "ellipticBlockJacobiPrecon");
-      elliptic->precon->blockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+        sprintf(fileName, DELLIPTIC "/okl/ellipticBlockJacobiPrecon.okl");
+        sprintf(kernelName, "ellipticBlockJacobiPrecon");
+        elliptic->precon->blockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
-      elliptic->precon->partialblockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+        sprintf(kernelName, "ellipticPartialBlockJacobiPrecon");
+        elliptic->precon->partialblockJacobiKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
-      sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
-      elliptic->precon->approxBlockJacobiSolverKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
+        sprintf(fileName, DELLIPTIC "/okl/ellipticPatchSolver.okl");
+        sprintf(kernelName, "ellipticApproxBlockJacobiSolver");
+        elliptic->precon->approxBlockJacobiSolverKernel = mesh->device.buildKernel(fileName,kernelName,kernelInfo);
 
-      if (   elliptic->elementType == TRIANGLES 
-          || elliptic->elementType == TETRAHEDRA) {
-        elliptic->precon->SEMFEMInterpKernel =
-          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
-                     "ellipticSEMFEMInterp",
-                     kernelInfo);
+        if (   elliptic->elementType == TRIANGLES 
+            || elliptic->elementType == TETRAHEDRA) {
+          elliptic->precon->SEMFEMInterpKernel =
+            mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMInterp.okl",
+                       "ellipticSEMFEMInterp",
+                       kernelInfo);
 
-        elliptic->precon->SEMFEMAnterpKernel =
-          mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
-                     "ellipticSEMFEMAnterp",
-                     kernelInfo);
+          elliptic->precon->SEMFEMAnterpKernel =
+            mesh->device.buildKernel(DELLIPTIC "/okl/ellipticSEMFEMAnterp.okl",
+                       "ellipticSEMFEMAnterp",
+                       kernelInfo);
+        }
       }
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
+  }
+
+  if (sharePrecon) {
+    if (mesh->rank==0) printf("Sharing preconditioner with a solver of the same operator\n");
+    return;
   }
 
   long long int pre = mesh->device.memoryAllocated();
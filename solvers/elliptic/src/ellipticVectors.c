@@ -34,7 +34,10 @@ void ellipticScaledAdd(elliptic_t *elliptic, dfloat alpha, occa::memory &o_a, df
 
   // b[n] = alpha*a[n] + beta*b[n] n\in [0,Ntotal)
   occaTimerTic(mesh->device,"scaledAddKernel");
-  elliptic->scaledAddKernel(Ntotal, alpha, o_a, beta, o_b);
+  if(elliptic->floatPrecision)
+    elliptic->scaledAddKernel(Ntotal, (float) alpha, o_a, (float) beta, o_b);
+  else
+    elliptic->scaledAddKernel(Ntotal, alpha, o_a, beta, o_b);
   occaTimerToc(mesh->device,"scaledAddKernel");
 }
 
@@ -50,7 +53,7 @@ dfloat ellipticWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occ
   occa::memory &o_tmp2 = elliptic->o_tmp2;
 
   occaTimerTic(mesh->device,"weighted inner product2");
-  if(elliptic->options.compareArgs("DISCRETIZATION","CONTINUOUS"))
+  if(elliptic->settings.continuous)
     elliptic->weightedInnerProduct2Kernel(Ntotal, o_w, o_a, o_b, o_tmp);
   else
     elliptic->innerProductKernel(Ntotal, o_a, o_b, o_tmp);
@@ -77,8 +80,16 @@ dfloat ellipticWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occ
   }    
 
   dfloat wab = 0;
-  for(dlong n=0;n<Nfinal;++n){
-    wab += tmp[n];
+  if(elliptic->floatPrecision){
+    // partial sums of an fp32 multigrid level
+    for(dlong n=0;n<Nfinal;++n){
+      wab += ((float*) tmp)[n];
+    }
+  }
+  else{
+    for(dlong n=0;n<Nfinal;++n){
+      wab += tmp[n];
+    }
   }
 
   dfloat globalwab = 0;
@@ -92,16 +103,45 @@ typedef union intorfloat {
   float w;
 } ierw_t;
 
-dfloat ellipticCascadingWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a, occa::memory &o_b){
+// finish Nsums block-partial reductions (stored consecutively in tmp) with one MPI_Allreduce
+static void ellipticCascadingReduce(mesh_t *mesh, const int Nsums, const dlong Nblock, dfloat *tmp, dfloat *result){
 
   // use bin sorting by exponent to make the end reduction more robust
   // [ assumes that the partial reduction is ok in FP32 ]
   int Naccumulators = 256;
   int Nmantissa = 23;
 
-  double *accumulators   = (double*) calloc(Naccumulators, sizeof(double));
-  double *g_accumulators = (double*) calloc(Naccumulators, sizeof(double));
+  double *accumulators   = (double*) calloc(Nsums*Naccumulators, sizeof(double));
+  double *g_accumulators = (double*) calloc(Nsums*Naccumulators, sizeof(double));
+
+  for(int s=0;s<Nsums;++s){
+    for(dlong n=0;n<Nblock;++n){
+      const dfloat ftmpn = tmp[n+s*Nblock];
+
+      ierw_t ierw;
+      ierw.w = fabs(ftmpn);
+    
+      int iexp = ierw.ier>>Nmantissa; // strip mantissa
+      accumulators[iexp+s*Naccumulators] += (double)ftmpn;
+    }
+  }
   
+  MPI_Allreduce(accumulators, g_accumulators, Nsums*Naccumulators, MPI_DOUBLE, MPI_SUM, mesh->comm);
+  
+  for(int s=0;s<Nsums;++s){
+    double wab = 0.0;
+    for(int n=0;n<Naccumulators;++n){ 
+      wab += g_accumulators[Naccumulators-1-n+s*Naccumulators]; // reverse order is important here (dominant first)
+    }
+    result[s] = wab;
+  }
+  
+  free(accumulators);
+  free(g_accumulators);
+}
+
+dfloat ellipticCascadingWeightedInnerProduct(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a, occa::memory &o_b){
+
   mesh_t *mesh = elliptic->mesh;
   dfloat *tmp = elliptic->tmp;
 
@@ -112,38 +152,71 @@ dfloat ellipticCascadingWeightedInnerProduct(elliptic_t *elliptic, occa::memory
   
   occaTimerTic(mesh->device,"weighted inner product2");
 
-  if(elliptic->options.compareArgs("DISCRETIZATION","CONTINUOUS"))
+  if(elliptic->settings.continuous)
     elliptic->weightedInnerProduct2Kernel(Ntotal, o_w, o_a, o_b, o_tmp);
   else
     elliptic->innerProductKernel(Ntotal, o_a, o_b, o_tmp);
   
   occaTimerToc(mesh->device,"weighted inner product2");
   
-  o_tmp.copyTo(tmp);
-  
-  for(int n=0;n<Nblock;++n){
-    const dfloat ftmpn = tmp[n];
+  o_tmp.copyTo(tmp, Nblock*sizeof(dfloat), 0);
 
-    ierw_t ierw;
-    ierw.w = fabs(ftmpn);
-    
-    int iexp = ierw.ier>>Nmantissa; // strip mantissa
-    accumulators[iexp] += (double)ftmpn;
-  }
-  
-  MPI_Allreduce(accumulators, g_accumulators, Naccumulators, MPI_DOUBLE, MPI_SUM, mesh->comm);
-  
-  double wab = 0.0;
-  for(int n=0;n<Naccumulators;++n){ 
-    wab += g_accumulators[Naccumulators-1-n]; // reverse order is important here (dominant first)
-  }
-  
-  free(accumulators);
-  free(g_accumulators);
+  dfloat wab = 0;
+  ellipticCascadingReduce(mesh, 1, Nblock, tmp, &wab);
   
   return wab;
 }
 
+// x <= x + alpha*p, r <= r - alpha*Ap in one pass, returns (weighted) r.r
+dfloat ellipticUpdatePCG(elliptic_t *elliptic, occa::memory &o_w, dfloat alpha,
+                         occa::memory &o_p, occa::memory &o_Ap, occa::memory &o_x, occa::memory &o_r){
+
+  mesh_t *mesh = elliptic->mesh;
+  dfloat *tmp = elliptic->tmp;
+
+  dlong Nblock = elliptic->Nblock;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  int weighted = elliptic->settings.continuous ? 1:0;
+
+  occa::memory &o_tmp = elliptic->o_tmp;
+
+  occaTimerTic(mesh->device,"updatePCGKernel");
+  elliptic->updatePCGKernel(Ntotal, weighted, o_w, alpha, o_p, o_Ap, o_x, o_r, o_tmp);
+  occaTimerToc(mesh->device,"updatePCGKernel");
+
+  o_tmp.copyTo(tmp, Nblock*sizeof(dfloat), 0);
+
+  dfloat rdotr = 0;
+  ellipticCascadingReduce(mesh, 1, Nblock, tmp, &rdotr);
+
+  return rdotr;
+}
+
+// (w.a.c, w.b.c) with one pass over the vectors and one global reduction
+void ellipticCascadingWeightedInnerProductPair(elliptic_t *elliptic, occa::memory &o_w,
+                                               occa::memory &o_a, occa::memory &o_b, occa::memory &o_c,
+                                               dfloat *ac){
+
+  mesh_t *mesh = elliptic->mesh;
+  dfloat *tmp = elliptic->tmp;
+
+  dlong Nblock = elliptic->Nblock;
+  dlong Ntotal = mesh->Nelements*mesh->Np;
+
+  int weighted = elliptic->settings.continuous ? 1:0;
+
+  occa::memory &o_tmp = elliptic->o_tmp;
+
+  occaTimerTic(mesh->device,"innerProductPairKernel");
+  elliptic->innerProductPairKernel(Ntotal, weighted, o_w, o_a, o_b, o_c, o_tmp);
+  occaTimerToc(mesh->device,"innerProductPairKernel");
+
+  o_tmp.copyTo(tmp, 2*Nblock*sizeof(dfloat), 0);
+
+  ellipticCascadingReduce(mesh, 2, Nblock, tmp, ac);
+}
+
 
 
 dfloat ellipticWeightedNorm2(elliptic_t *elliptic, occa::memory &o_w, occa::memory &o_a){
@@ -158,7 +231,7 @@ dfloat ellipticWeightedNorm2(elliptic_t *elliptic, occa::memory &o_w, occa::memo
   occa::memory &o_tmp2 = elliptic->o_tmp2;
 
   occaTimerTic(mesh->device,"weighted inner product2");
-  if(elliptic->options.compareArgs("DISCRETIZATION","CONTINUOUS"))
+  if(elliptic->settings.continuous)
     elliptic->weightedNorm2Kernel(Ntotal, o_w, o_a, o_tmp);
   else
     elliptic->norm2Kernel(Ntotal, o_a, o_tmp);
@@ -64,6 +64,8 @@ int main(int argc, char **argv){
   // set up gradient stuff
   gradient_t *gradient = gradientSetup(mesh, options);
 
+  occaKernelBuildReport(mesh);
+
   // populate q
   for(int n=0;n<mesh->Nelements*mesh->Np;++n){
     dfloat x = mesh->x[n];
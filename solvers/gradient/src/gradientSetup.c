@@ -172,10 +172,8 @@ gradient_t *gradientSetup(mesh_t *mesh, setupAide &options){
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-
-    MPI_Barrier(mesh->comm);
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
 
       // kernels from volume file
       if(mesh->dim==3){
@@ -204,6 +202,7 @@ gradient_t *gradientSetup(mesh_t *mesh, setupAide &options){
 					   kernelInfo);
 #endif
     }
+    occaKernelBuildDone(mesh, r);
   }
 
   return gradient;
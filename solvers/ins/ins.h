@@ -32,6 +32,9 @@ SOFTWARE.
 #include "mesh2D.h"
 #include "mesh3D.h"
 #include "elliptic.h"
+#include "meshVTU.h"
+#include "meshBoundaryIntegral.h"
+#include "meshCheckpoint.h"
 
 typedef struct {
 
@@ -43,6 +46,8 @@ typedef struct {
   elliptic_t *wSolver;
   elliptic_t *pSolver;
 
+  ellipticBlock_t *velocityBlock; // all velocity components in one solve (NULL if off)
+
   setupAide options;
   setupAide vOptions, pOptions; 	
 
@@ -59,6 +64,8 @@ typedef struct {
   dfloat dtMIN;         
   dfloat time;
   int tstep, frame;
+  meshVTU_t *vtu;              // binary VTU output
+  meshBoundaryIntegral_t *forces; // wall force integrals
   dfloat g0, ig0, lambda;      // helmhotz solver -lap(u) + lamda u
   dfloat startTime;   
   dfloat finalTime;   
@@ -106,6 +113,9 @@ typedef struct {
   dfloat *extbdfA, *extbdfB, *extbdfC;
   dfloat *extC;
 
+  //EXTBDF history ring: stage s (0 newest) of U, P, NU and GP lives in slot insHistorySlot(ins,s)
+  int histHead;
+
   int *VmapB, *PmapB;
   occa::memory o_VmapB, o_PmapB;
 
@@ -143,6 +153,7 @@ typedef struct {
 
 
   int readRestartFile,writeRestartFile, restartedFromFile;
+  meshCheckpoint_t *checkpoint;  // shared restart file
 
 
 
@@ -162,15 +173,18 @@ typedef struct {
 
   occa::memory o_U, o_P;
   occa::memory o_rhsU, o_rhsV, o_rhsW, o_rhsP; 
+  occa::memory o_rhsUVW; // o_rhsU, o_rhsV, o_rhsW packed with stride fieldOffset
 
   occa::memory o_NU, o_LU, o_GP;
   occa::memory o_GU;
 
   occa::memory o_UH, o_VH, o_WH;
+  occa::memory o_UVWH; // o_UH, o_VH, o_WH packed with stride fieldOffset
   occa::memory o_rkU, o_rkP, o_PI;
   occa::memory o_rkNU, o_rkLU, o_rkGP;
 
   occa::memory o_Vort, o_Div;
+  occa::memory o_cfl, o_cflMax; // per element and global inverse CFL time step
 
   occa::memory o_vHaloBuffer, o_pHaloBuffer; 
   occa::memory o_velocityHaloGatherTmp;
@@ -182,7 +196,8 @@ typedef struct {
   occa::memory o_erkE, o_irkE, o_prkE;
 
   //EXTBDF data
-  occa::memory o_extbdfA, o_extbdfB, o_extbdfC;
+  occa::memory o_extbdfA, o_extbdfB, o_extbdfC; //views into o_extbdfTable for the current histHead
+  occa::memory o_extbdfTable;
   occa::memory o_extC;
 
   occa::kernel velocityHaloExtractKernel;
@@ -224,13 +239,28 @@ typedef struct {
   occa::kernel vorticityKernel;
   occa::kernel isoSurfaceKernel;
 
+  occa::kernel cflKernel;
+  occa::kernel cflMaxKernel;
+
+  occa::kernel tractionKernel;
+
 
 }ins_t;
 
+// slot of history stage s in the U, P, NU and GP arrays
+#define insHistorySlot(ins, s) (((ins)->histHead + (s))%(ins)->Nstages)
+
+// device views of history stage s
+#define insHistoryU(ins, s)  ((ins)->o_U  + insHistorySlot(ins,s)*(ins)->NVfields*(ins)->Ntotal*sizeof(dfloat))
+#define insHistoryP(ins, s)  ((ins)->o_P  + insHistorySlot(ins,s)*(ins)->Ntotal*sizeof(dfloat))
+#define insHistoryNU(ins, s) ((ins)->o_NU + insHistorySlot(ins,s)*(ins)->NVfields*(ins)->Ntotal*sizeof(dfloat))
+#define insHistoryGP(ins, s) ((ins)->o_GP + insHistorySlot(ins,s)*(ins)->NVfields*(ins)->Ntotal*sizeof(dfloat))
+
 ins_t *insSetup(mesh_t *mesh, setupAide options);
 
 void insRunARK(ins_t *ins);
 void insRunEXTBDF(ins_t *ins);
+void insSetHistoryHead(ins_t *ins, int head);
 
 void insPlotVTU(ins_t *ins, char *fileNameBase);
 void insReport(ins_t *ins, dfloat time,  int tstep);
@@ -245,7 +275,7 @@ void insDivergence(ins_t *ins,dfloat time, occa::memory o_U, occa::memory o_DU);
 void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::memory o_NU);
 
 void insVelocityRhs  (ins_t *ins, dfloat time, int stage, occa::memory o_rhsU, occa::memory o_rhsV, occa::memory o_rhsW);
-void insVelocitySolve(ins_t *ins, dfloat time, int stage, occa::memory o_rhsU, occa::memory o_rhsV, occa::memory o_rhsW, occa::memory o_rkU);
+void insVelocitySolve(ins_t *ins, dfloat time, int stage, occa::memory o_rkU);
 void insVelocityUpdate(ins_t *ins, dfloat time, int stage, occa::memory o_rkGP, occa::memory o_rkU);
 
 void insPressureRhs  (ins_t *ins, dfloat time, int stage);
@@ -26,135 +26,37 @@ SOFTWARE.
 
 #include "ins.h"
 
-
+// integrate the wall traction on the device and append (time, Fx, Fy)
 void insForces(ins_t *ins, dfloat time){
 
+  mesh_t *mesh = ins->mesh;
+  meshBoundaryIntegral_t *forces = ins->forces;
+
+  if(forces->Nfaces)
+    ins->tractionKernel(forces->Nfaces,
+                        forces->o_faceElements,
+                        forces->o_faceIds,
+                        mesh->o_vgeo,
+                        mesh->o_sgeo,
+                        mesh->o_Dmatrices,
+                        mesh->o_vmapM,
+                        ins->fieldOffset,
+                        insHistoryU(ins,0),
+                        insHistoryP(ins,0),
+                        forces->o_traction);
+
+  // sum over the walls of all processors
+  meshBoundaryIntegral(forces);
 
-  mesh_t *mesh = ins->mesh; 
-  // Hard coded weights i.e. sum(MM1D,1), MM1D = inv(V1)'*V1
-  dfloat W[mesh->Nfp];
-  if(mesh->N==1){
-    W[0] = 1.000000000000000; W[1] = 1.000000000000000; 
-  }
-
- if(mesh->N==2){
-    W[0] = 0.333333333333333; W[1] = 1.333333333333333;
-    W[2] = 0.333333333333333; 
-  }
-
-  if(mesh->N==3){
-    W[0] = 0.166666666666666; W[1] = 0.833333333333334;
-    W[2] = 0.833333333333334; W[3] = 0.166666666666666;
-  }
-  if(mesh->N==4){
-    W[0] = 0.100000000000000; W[1] = 0.544444444444444;
-    W[2] = 0.711111111111111; W[3] = 0.544444444444444;
-    W[4] = 0.100000000000000; 
-  }
-  if(mesh->N==5){
-    W[0] = 0.066666666666666; W[1] = 0.378474956297847;
-    W[2] = 0.554858377035487; W[3] = 0.554858377035486;
-    W[4] = 0.378474956297847; W[5] = 0.066666666666667;
-  }
-
-  if(mesh->N==6){
-    W[0] = 0.047619047619047; W[1] = 0.276826047361566;
-    W[2] = 0.431745381209863; W[3] = 0.487619047619048;
-    W[4] = 0.431745381209863; W[5] = 0.276826047361566;
-    W[6] = 0.047619047619047;
-  }
-
-   
-
-  dfloat Fx =0. , Fy = 0. ;
-  dfloat *dUdx = (dfloat*) calloc(mesh->Np,sizeof(dfloat));
-  dfloat *dUdy = (dfloat*) calloc(mesh->Np,sizeof(dfloat));
-  dfloat *dVdx = (dfloat*) calloc(mesh->Np,sizeof(dfloat));
-  dfloat *dVdy = (dfloat*) calloc(mesh->Np,sizeof(dfloat));
-  dlong offset = mesh->Np*(mesh->Nelements+mesh->totalHaloPairs);
-
-  //
-   for(int e=0;e<mesh->Nelements;++e){
-     int flag = 0; 
-    for(int f=0;f<mesh->Nfaces;++f){
-      int bc = mesh->EToB[e*mesh->Nfaces+f];
-      if(bc == 1){ flag = 1; }
-    }
-
-    if(flag){
-
-      dfloat drdx = mesh->vgeo[e*mesh->Nvgeo + RXID];
-      dfloat drdy = mesh->vgeo[e*mesh->Nvgeo + RYID];
-      dfloat dsdx = mesh->vgeo[e*mesh->Nvgeo + SXID];
-      dfloat dsdy = mesh->vgeo[e*mesh->Nvgeo + SYID];
-      for(int n=0;n<mesh->Np;++n){
-        dfloat dudr = 0, duds = 0, dvdr = 0, dvds = 0;     
-        for(int i=0;i<mesh->Np;++i){
-          // load data at node i of element e (note Nfields==4)
-          int id = e*mesh->Np + i;
-          dfloat u = ins->U[id+0*offset];
-          dfloat v = ins->U[id+1*offset];
-          //  
-          dfloat Drni = mesh->Dr[n*mesh->Np+i];
-          dfloat Dsni = mesh->Ds[n*mesh->Np+i];
-          // differentiate (u,v,p) with respect to 'r' and 's'
-          dudr += Drni*u;
-          duds += Dsni*u;
-          dvdr += Drni*v;
-          dvds += Dsni*v;   
-        }
-        dUdx[n] = drdx*dudr + dsdx*duds;
-        dUdy[n] = drdy*dudr + dsdy*duds;
-        dVdx[n] = drdx*dvdr + dsdx*dvds;
-        dVdy[n] = drdy*dvdr + dsdy*dvds;
-      }
-
-   
-      for(int f=0;f<mesh->Nfaces;++f){
-        int bc = mesh->EToB[e*mesh->Nfaces+f];
-        if(bc==1){
-          for(int n=0;n<mesh->Nfp; n++){
-            int sid = mesh->Nsgeo*(e*mesh->Nfaces+f);
-            dfloat nx = mesh->sgeo[sid+NXID];
-            dfloat ny = mesh->sgeo[sid+NYID];
-            dfloat sJ = mesh->sgeo[sid+SJID];
-
-            int vid  = e*mesh->Nfp*mesh->Nfaces + f*mesh->Nfp + n;
-            int idM  = mesh->vmapM[vid];
-            //
-            dfloat dudx = dUdx[idM-e*mesh->Np]; 
-            dfloat dudy = dUdy[idM-e*mesh->Np]; 
-            dfloat dvdx = dVdx[idM-e*mesh->Np]; 
-            dfloat dvdy = dVdy[idM-e*mesh->Np];
-            //
-            dfloat p = ins->P[idM];
-
-            Fx += W[n]*(sJ*(-p*nx + ins->nu*(nx*2.0*dudx + ny*(dvdx + dudy))));
-            Fy += W[n]*(sJ*(-p*ny + ins->nu*(nx*(dvdx + dudy) + ny*2.0*dvdy)));
-          }
-        }
-      }
-    }
-  }
-
-
-  dfloat gFx = 0., gFy = 0.; 
-  // Add all processors force, 
-  MPI_Allreduce(&Fx, &gFx, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
-  MPI_Allreduce(&Fy, &gFy, 1, MPI_DFLOAT, MPI_SUM, mesh->comm);
-
-  //
   if(mesh->rank==0){
     char fname[BUFSIZ];
     sprintf(fname, "INSForceData_N%d.dat", mesh->N);
 
-    FILE *fp; 
-    fp = fopen(fname, "a");  
+    FILE *fp;
+    fp = fopen(fname, "a");
 
-    fprintf(fp, "%.4e %.8e %.8e \n", time, gFx, gFy); 
+    fprintf(fp, "%.4e %.8e %.8e \n", time, forces->integrals[0], forces->integrals[1]);
 
     fclose(fp);
   }
-
-
 }
@@ -28,8 +28,9 @@ SOFTWARE.
 
 int main(int argc, char **argv){
 
-  // start up MPI
-  MPI_Init(&argc, &argv);
+  // start up MPI, checkpoints are written by a helper thread if MPI allows it
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
 
   if(argc!=2){
     printf("usage: ./insMain setupfile\n");
@@ -64,6 +65,8 @@ int main(int argc, char **argv){
 
   ins_t *ins = insSetup(mesh,options);
 
+  occaKernelBuildReport(mesh);
+
   insPlotWallsVTUHex3D(ins, "walls");
   
   if(ins->readRestartFile){
@@ -75,6 +78,10 @@ int main(int argc, char **argv){
   if (ins->options.compareArgs("TIME INTEGRATOR", "ARK"))  insRunARK(ins);
   if (ins->options.compareArgs("TIME INTEGRATOR", "EXTBDF"))  insRunEXTBDF(ins);
 
+  // wait for the last output frame and checkpoint
+  meshVTUFinish(ins->vtu);
+  if(ins->checkpoint) meshCheckpointFinish(ins->checkpoint);
+
   // close down MPI
   MPI_Finalize();
 
@@ -59,9 +59,9 @@ void insPlotVTUHex3D(ins_t *ins, char *fileNameBase){
   printf("N = %d, Eloc = %d, Nel = %d\n",
 	 mesh->Nq-1, Eloc, mesh->Nelements);
 
-  fprintf(fp, "    <Piece NumberOfPoints=\""hlongFormat"\" NumberOfCells=\""hlongFormat"\">\n", 
-          mesh->Nelements*mesh->Np, 
-          mesh->Nelements*Eloc);
+  fprintf(fp, "    <Piece NumberOfPoints=\"" hlongFormat "\" NumberOfCells=\"" hlongFormat "\">\n", 
+          (hlong) mesh->Nelements*mesh->Np, 
+          (hlong) mesh->Nelements*Eloc);
   
   // write out nodes
   fprintf(fp, "      <Points>\n");
@@ -34,14 +34,14 @@ void insReport(ins_t *ins, dfloat time, int tstep){
                        mesh->o_vgeo,
                        mesh->o_Dmatrices,
                        ins->fieldOffset,
-                       ins->o_U,
+                       insHistoryU(ins,0),
                        ins->o_Vort);
 
   ins->divergenceVolumeKernel(mesh->Nelements,
                              mesh->o_vgeo,
                              mesh->o_Dmatrices,
                              ins->fieldOffset,
-                             ins->o_U,
+                             insHistoryU(ins,0),
                              ins->o_Div);
 
   // gatherscatter vorticity field
@@ -60,8 +60,8 @@ void insReport(ins_t *ins, dfloat time, int tstep){
   ins->pSolver->dotMultiplyKernel(mesh->Nelements*mesh->Np, mesh->ogs->o_invDegree, ins->o_Div, ins->o_Div);
 
   // copy data back to host
-  ins->o_U.copyTo(ins->U);
-  ins->o_P.copyTo(ins->P);
+  ins->o_U.copyTo(ins->U, ins->NVfields*ins->Ntotal*sizeof(dfloat), insHistorySlot(ins,0)*ins->NVfields*ins->Ntotal*sizeof(dfloat));
+  ins->o_P.copyTo(ins->P, ins->Ntotal*sizeof(dfloat), insHistorySlot(ins,0)*ins->Ntotal*sizeof(dfloat));
 
   ins->o_Vort.copyTo(ins->Vort);
   ins->o_Div.copyTo(ins->Div);
@@ -74,9 +74,22 @@ void insReport(ins_t *ins, dfloat time, int tstep){
     char fname[BUFSIZ];
     string outName;
     ins->options.getArgs("OUTPUT FILE NAME", outName);
-    sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, ins->frame++);
 
-    insPlotVTU(ins, fname);
+    if(ins->options.compareArgs("OUTPUT VTU FORMAT","ASCII")){
+      sprintf(fname, "%s_%04d_%04d.vtu",(char*)outName.c_str(), mesh->rank, ins->frame++);
+      insPlotVTU(ins, fname);
+    } else {
+      const dlong Np = mesh->Np, offset = ins->fieldOffset;
+      occa::memory o_P = insHistoryP(ins,0);
+      occa::memory o_U = insHistoryU(ins,0);
+
+      meshVTUBegin(ins->vtu, outName.c_str(), ins->frame++);
+      meshVTUAddField(ins->vtu, "Pressure",   o_P,         0, 1, Np, 1, offset, -1, 1.0);
+      meshVTUAddField(ins->vtu, "Divergence", ins->o_Div,  0, 1, Np, 1, offset, -1, 1.0);
+      meshVTUAddField(ins->vtu, "Vorticity",  ins->o_Vort, 0, (ins->dim==2) ? 1 : 3, Np, 1, offset, -1, 1.0);
+      meshVTUAddField(ins->vtu, "Velocity",   o_U,         0, ins->NVfields, Np, 1, offset, -1, 1.0);
+      meshVTUWrite(ins->vtu);
+    }
   }
 
   if(ins->options.compareArgs("OUTPUT TYPE","ISO") && (ins->dim==3)){ 
@@ -96,8 +109,8 @@ void insReport(ins_t *ins, dfloat time, int tstep){
                               mesh->o_x,
                               mesh->o_y,
                               mesh->o_z,
-                              ins->o_P, 
-                              ins->o_U,
+                              insHistoryP(ins,0), 
+                              insHistoryU(ins,0),
                               ins->o_Vort,
                               ins->o_plotInterp,
                               ins->o_plotEToV,
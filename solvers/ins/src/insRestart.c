@@ -29,74 +29,39 @@ void insRestartWrite(ins_t *ins, setupAide &options, dfloat t){
 
   mesh_t *mesh = ins->mesh; 
 
-  // Copy Field To Host
-  // copy data back to host
-  ins->o_U.copyTo(ins->U);
-  ins->o_P.copyTo(ins->P);
-  
-  // History of nonlinear terms !!!!
-  ins->o_NU.copyTo(ins->NU);
-  // History of Pressure !!!!!
-  ins->o_GP.copyTo(ins->GP);
-
   // Create Binary File Name
   char fname[BUFSIZ];
   string outName;
   options.getArgs("RESTART FILE NAME", outName);
-  sprintf(fname, "%s_%04d.dat",(char*)outName.c_str(), mesh->rank);
-  FILE *fp;
-  
-  // Overwrite  Binary File
-  fp = fopen(fname,"wb");
-  
-  // Write q1....qN and all pml variables
-  dfloat *elmField  = (dfloat *) calloc((ins->NVfields+1), sizeof(dfloat)); 
-  dfloat *elmField2 = (dfloat *) calloc(2*ins->NVfields, sizeof(dfloat)); 
+  sprintf(fname, "%s.dat",(char*)outName.c_str());
 
-  // First Write the Solution Time
-  fwrite(&t, sizeof(dfloat), 1, fp);
-  //Write dt
-  fwrite(&ins->dt, sizeof(dfloat), 1, fp);
-  // Write output frame to prevent overwriting vtu files
-  fwrite(&ins->frame, sizeof(int), 1, fp);
+  // Solution time, dt and output frame go in the header
+  meshCheckpointBegin(ins->checkpoint, fname, t, ins->dt, ins->frame);
 
   // 
- if(options.compareArgs("TIME INTEGRATOR", "EXTBDF") ){
-
-  // Write U and P 
-  for(int s =0; s<ins->Nstages; s++){
-    for(dlong e = 0;e<mesh->Nelements; e++){
-      for(int n=0; n<mesh->Np; n++ ){
-        const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields; 
-        const dlong idp = e*mesh->Np + n + s*ins->fieldOffset; 
-          for(int vf = 0; vf<ins->NVfields; vf++){
-            elmField[vf]   =  ins->U[idv + vf*ins->fieldOffset];
-          }
-          elmField[ins->NVfields] = ins->P[idp]; 
-        fwrite(elmField, sizeof(dfloat), (ins->NVfields+1), fp);
-      }
-    } 
-  }
-  // Write nonlinear History 
-  for(int s =0; s<ins->Nstages; s++){
-    for(dlong e = 0;e<mesh->Nelements; e++){
-      for(int n=0; n<mesh->Np; n++ ){
-        const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields; 
-          
-          for(int vf = 0; vf<ins->NVfields; vf++)
-            elmField2[vf]   =  ins->NU[idv + vf*ins->fieldOffset];
-          
-          for(int vf = 0; vf<ins->NVfields; vf++)
-            elmField2[ins->NVfields+ vf]   =  ins->GP[idv + vf*ins->fieldOffset];
-
-        fwrite(elmField2, sizeof(dfloat), 2*ins->NVfields, fp);
-      }
-    } 
-  }
-}
+  if(options.compareArgs("TIME INTEGRATOR", "EXTBDF") ){
+
+    const dlong offset = ins->fieldOffset;
 
-fclose(fp); 
+    // U and P, newest first whatever the position of the history ring
+    for(int s =0; s<ins->Nstages; s++){
+      occa::memory o_Us = insHistoryU(ins,s);
+      occa::memory o_Ps = insHistoryP(ins,s);
+      meshCheckpointAddField(ins->checkpoint, o_Us, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
+      meshCheckpointAddField(ins->checkpoint, o_Ps, 1,             offset, mesh->Np, mesh->Nelements, NULL);
+    }
 
+    // nonlinear and pressure gradient history
+    for(int s =0; s<ins->Nstages; s++){
+      occa::memory o_NUs = insHistoryNU(ins,s);
+      occa::memory o_GPs = insHistoryGP(ins,s);
+      meshCheckpointAddField(ins->checkpoint, o_NUs, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
+      meshCheckpointAddField(ins->checkpoint, o_GPs, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
+    }
+  }
+
+  // written by the checkpoint thread while time stepping continues
+  meshCheckpointWrite(ins->checkpoint);
 }
 
 
@@ -110,67 +75,46 @@ void insRestartRead(ins_t *ins, setupAide &options){
   char fname[BUFSIZ];
   string outName;
   options.getArgs("RESTART FILE NAME", outName);
-  sprintf(fname, "%s_%04d.dat",(char*)outName.c_str(), mesh->rank);
-  FILE *fp; 
-
+  sprintf(fname, "%s.dat",(char*)outName.c_str());
 
   ins->restartedFromFile = 0; 
-  // Overwrite  Binary File
-  fp = fopen(fname,"rb");
 
-  if(fp != NULL){
-  
-      // Write q1....qN and all pml variables
-    dfloat *elmField  = (dfloat *) calloc((ins->NVfields+1), sizeof(dfloat)); 
-    dfloat *elmField2 = (dfloat *) calloc(2*ins->NVfields, sizeof(dfloat)); 
-
-    // First Write the Solution Time
-    dfloat startTime = 0.0, dtold = 0.0;  
-    fread(&startTime, sizeof(dfloat), 1, fp); 
-    //Write dt
-    fread(&dtold, sizeof(dfloat), 1, fp);
-    // Write output frame to prevent overwriting vtu files
-    fread(&ins->frame, sizeof(int), 1, fp);
+  dfloat startTime = 0.0, dtold = 0.0;  
+
+  // the file may come from a run on any number of ranks
+  if(meshCheckpointReadBegin(ins->checkpoint, fname, &startTime, &dtold, &ins->frame)){
 
     // 
     if(options.compareArgs("TIME INTEGRATOR", "EXTBDF") ){
 
-      // Write U and P
-      for(int s =0; s<ins->Nstages; s++){
-        for(dlong e = 0;e<mesh->Nelements; e++){
-          for(int n=0; n<mesh->Np; n++ ){
-
-            fread(elmField, sizeof(dfloat), (ins->NVfields+1), fp);
-
-            const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields; 
-            const dlong idp = e*mesh->Np + n + s*ins->fieldOffset;
-
-              for(int vf = 0; vf<ins->NVfields; vf++)
-                ins->U[idv + vf*ins->fieldOffset] = elmField[vf];
+      const dlong offset = ins->fieldOffset;
 
-              ins->P[idp] = elmField[ins->NVfields]; 
-          }
-        } 
+      // the history ring starts at slot 0 after setup
+      for(int s =0; s<ins->Nstages; s++){
+        occa::memory o_Us = insHistoryU(ins,s);
+        occa::memory o_Ps = insHistoryP(ins,s);
+        meshCheckpointReadField(ins->checkpoint, o_Us, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
+        meshCheckpointReadField(ins->checkpoint, o_Ps, 1,             offset, mesh->Np, mesh->Nelements, NULL);
       }
-      // Write nonlinear History 
+
       for(int s =0; s<ins->Nstages; s++){
-        for(dlong e = 0;e<mesh->Nelements; e++){
-          for(int n=0; n<mesh->Np; n++ ){
-            const dlong idv = e*mesh->Np + n + s*ins->fieldOffset*ins->NVfields;       
-            fread(elmField2, sizeof(dfloat), 2*ins->NVfields, fp);       
-              for(int vf = 0; vf<ins->NVfields; vf++)
-                ins->NU[idv + vf*ins->fieldOffset] = elmField2[vf];    
-              for(int vf = 0; vf<ins->NVfields; vf++)
-                ins->GP[idv + vf*ins->fieldOffset] = elmField2[ins->NVfields+vf];
-          }
-        } 
+        occa::memory o_NUs = insHistoryNU(ins,s);
+        occa::memory o_GPs = insHistoryGP(ins,s);
+        meshCheckpointReadField(ins->checkpoint, o_NUs, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
+        meshCheckpointReadField(ins->checkpoint, o_GPs, ins->NVfields, offset, mesh->Np, mesh->Nelements, NULL);
       }
     }else{
 
       if(mesh->rank==0) printf("restart for ARK has not tested yet\n");
     }
 
-  fclose(fp);
+  meshCheckpointReadEnd(ins->checkpoint);
+
+  // the history interpolation below works on the host copies
+  ins->o_U.copyTo(ins->U);
+  ins->o_P.copyTo(ins->P);
+  ins->o_NU.copyTo(ins->NU);
+  ins->o_GP.copyTo(ins->GP);
 
   ins->restartedFromFile = 1;  
   // Just Update start time
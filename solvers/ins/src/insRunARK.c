@@ -63,7 +63,7 @@ void insRunARK(ins_t *ins){
       // intermediate stage time
       dfloat stageTime = ins->time + ins->rkC[stage]*ins->dt;
       insVelocityRhs  (ins, stageTime, stage, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW);
-      insVelocitySolve(ins, stageTime, stage, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW, ins->o_rkU);
+      insVelocitySolve(ins, stageTime, stage, ins->o_rkU);
 
       insPressureRhs  (ins, stageTime, stage);
       insPressureSolve(ins, stageTime, stage);      
@@ -109,7 +109,7 @@ void insRunARK(ins_t *ins){
   if(ins->dtAdaptStep) insComputeDt(ins, ins->time); 
   // Write Initial Data
   if(ins->outputStep) insReport(ins, 0.0, 0);
-  // Write Initial Force Data (assumes U = o_U )
+  // Write Initial Force Data
   if(ins->outputForceStep) insForces(ins, ins->time); 
 
   while (!done) {
@@ -140,7 +140,7 @@ void insRunARK(ins_t *ins){
       dfloat stageTime = ins->time + ins->rkC[stage]*ins->dt;
 
       insVelocityRhs  (ins, stageTime, stage, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW);
-      insVelocitySolve(ins, stageTime, stage, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW, ins->o_rkU);
+      insVelocitySolve(ins, stageTime, stage, ins->o_rkU);
 
       insPressureRhs  (ins, stageTime, stage);
       insPressureSolve(ins, stageTime, stage);      
@@ -182,8 +182,6 @@ void insRunARK(ins_t *ins){
       
       if(ins->outputForceStep){
         if(((ins->tstep)%(ins->outputForceStep))==0){
-          ins->o_U.copyTo(ins->U);
-          ins->o_P.copyTo(ins->P);
           insForces(ins, ins->time);
         }
       }
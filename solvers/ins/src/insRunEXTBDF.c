@@ -48,10 +48,10 @@ void insRunEXTBDF(ins_t *ins){
     else if(tstep<3 && ins->temporalOrder>=3) 
       extbdfCoefficents(ins,tstep+1);
 
-    insGradient (ins, 0, ins->o_P, ins->o_GP);
+    insGradient (ins, 0, insHistoryP(ins,0), insHistoryGP(ins,0));
 
     insVelocityRhs  (ins, 0, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW);
-    insVelocitySolve(ins, 0, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW, ins->o_rkU);
+    insVelocitySolve(ins, 0, ins->Nstages, ins->o_rkU);
 
     insPressureRhs  (ins, 0, ins->Nstages);
     insPressureSolve(ins, 0, ins->Nstages); 
@@ -59,31 +59,19 @@ void insRunEXTBDF(ins_t *ins){
     insPressureUpdate(ins, 0, ins->Nstages, ins->o_rkP);
     insGradient(ins, 0, ins->o_rkP, ins->o_rkGP);
 
-    //cycle history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_U.copyFrom(ins->o_U, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_P.copyFrom(ins->o_P, ins->Ntotal*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*sizeof(dfloat));
-    }
+    //cycle history: the oldest slot becomes the newest
+    const int head = insHistorySlot(ins, ins->Nstages-1);
 
     //copy updated pressure
-    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat)); 
+    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat), head*ins->Ntotal*sizeof(dfloat)); 
 
     //update velocity
     insVelocityUpdate(ins, 0, ins->Nstages, ins->o_rkGP, ins->o_rkU);
 
-    //copy updated pressure
-    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
+    //copy updated velocity
+    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat), head*ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
 
-    //cycle rhs history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_GP.copyFrom(ins->o_GP, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-    }
+    insSetHistoryHead(ins, head);
 
     if (mesh->rank==0) printf("\rSstep = %d, solver iterations: U - %3d, V - %3d, P - %3d", tstep+1, ins->NiterU, ins->NiterV, ins->NiterP); fflush(stdout);
   }
@@ -115,12 +103,12 @@ void insRunEXTBDF(ins_t *ins){
     if(ins->Nsubsteps) {
       insSubCycle(ins, time, ins->Nstages, ins->o_U, ins->o_NU);
     } else {
-      insAdvection(ins, time, ins->o_U, ins->o_NU);
+      insAdvection(ins, time, insHistoryU(ins,0), insHistoryNU(ins,0));
     } 
-    insGradient (ins, time, ins->o_P, ins->o_GP);
+    insGradient (ins, time, insHistoryP(ins,0), insHistoryGP(ins,0));
 
     insVelocityRhs  (ins, time+ins->dt, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW);
-    insVelocitySolve(ins, time+ins->dt, ins->Nstages, ins->o_rhsU, ins->o_rhsV, ins->o_rhsW, ins->o_rkU);
+    insVelocitySolve(ins, time+ins->dt, ins->Nstages, ins->o_rkU);
 
     insPressureRhs  (ins, time+ins->dt, ins->Nstages);
     insPressureSolve(ins, time+ins->dt, ins->Nstages); 
@@ -128,34 +116,19 @@ void insRunEXTBDF(ins_t *ins){
     insPressureUpdate(ins, time+ins->dt, ins->Nstages, ins->o_rkP);
     insGradient(ins, time+ins->dt, ins->o_rkP, ins->o_rkGP);
 
-    //cycle history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_U.copyFrom(ins->o_U, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_P.copyFrom(ins->o_P, ins->Ntotal*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*sizeof(dfloat));
-    }
+    //cycle history: the oldest slot becomes the newest, NU and GP are overwritten next step
+    const int head = insHistorySlot(ins, ins->Nstages-1);
 
     //copy updated pressure
-    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat)); 
+    ins->o_P.copyFrom(ins->o_rkP, ins->Ntotal*sizeof(dfloat), head*ins->Ntotal*sizeof(dfloat)); 
 
     //update velocity
     insVelocityUpdate(ins, time+ins->dt, ins->Nstages, ins->o_rkGP, ins->o_rkU);
 
-    //copy updated pressure
-    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
-
-    //cycle rhs history
-    for (int s=ins->Nstages;s>1;s--) {
-      ins->o_NU.copyFrom(ins->o_NU, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-      ins->o_GP.copyFrom(ins->o_GP, ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-1)*ins->Ntotal*ins->NVfields*sizeof(dfloat), 
-                                  (s-2)*ins->Ntotal*ins->NVfields*sizeof(dfloat));
-    }
+    //copy updated velocity
+    ins->o_U.copyFrom(ins->o_rkU, ins->NVfields*ins->Ntotal*sizeof(dfloat), head*ins->NVfields*ins->Ntotal*sizeof(dfloat)); 
+
+    insSetHistoryHead(ins, head);
 
     occaTimerTic(mesh->device,"Report");
 
@@ -216,10 +189,6 @@ void extbdfCoefficents(ins_t *ins, int order) {
     memcpy(ins->extbdfA, extbdfA, 3*sizeof(dfloat));
     memcpy(ins->extbdfC, extbdfC, 3*sizeof(dfloat));
 
-    ins->o_extbdfB.copyFrom(extbdfB);
-    ins->o_extbdfA.copyFrom(extbdfA);
-    ins->o_extbdfC.copyFrom(extbdfC);
-
     ins->ExplicitOrder = 1;    
     
     ins->lambda = ins->g0 / (ins->dt * ins->nu);
@@ -235,10 +204,6 @@ void extbdfCoefficents(ins_t *ins, int order) {
     memcpy(ins->extbdfA, extbdfA, 3*sizeof(dfloat));
     memcpy(ins->extbdfC, extbdfC, 3*sizeof(dfloat));
 
-    ins->o_extbdfB.copyFrom(extbdfB);
-    ins->o_extbdfA.copyFrom(extbdfA);
-    ins->o_extbdfC.copyFrom(extbdfC);
-
     ins->ExplicitOrder=2;
 
     ins->lambda = ins->g0 / (ins->dt * ins->nu);
@@ -254,13 +219,35 @@ void extbdfCoefficents(ins_t *ins, int order) {
     memcpy(ins->extbdfA, extbdfA, 3*sizeof(dfloat));
     memcpy(ins->extbdfC, extbdfC, 3*sizeof(dfloat));
 
-    ins->o_extbdfB.copyFrom(extbdfB);
-    ins->o_extbdfA.copyFrom(extbdfA);
-    ins->o_extbdfC.copyFrom(extbdfC);
-
     ins->ExplicitOrder=3;
 
     ins->lambda = ins->g0 / (ins->dt * ins->nu);
     ins->ig0 = 1.0/ins->g0; 
   }
+
+  // coefficients in slot order for every history head, so the kernels sum the ring directly
+  dfloat extbdfTable[3*3*3];
+  memset(extbdfTable, 0, 3*3*3*sizeof(dfloat));
+  for (int head=0;head<ins->Nstages;head++) {
+    for (int s=0;s<ins->Nstages;s++) {
+      const int slot = (head+s)%ins->Nstages;
+      extbdfTable[(3*head+0)*3+slot] = ins->extbdfA[s];
+      extbdfTable[(3*head+1)*3+slot] = ins->extbdfB[s];
+      extbdfTable[(3*head+2)*3+slot] = ins->extbdfC[s];
+    }
+  }
+  ins->o_extbdfTable.copyFrom(extbdfTable);
+}
+
+// rotate the EXTBDF history ring by moving its head; no field data is copied
+void insSetHistoryHead(ins_t *ins, int head){
+
+  ins->histHead = head;
+
+  ins->o_extbdfA = ins->o_extbdfTable + (3*head+0)*3*sizeof(dfloat);
+  ins->o_extbdfB = ins->o_extbdfTable + (3*head+1)*3*sizeof(dfloat);
+  ins->o_extbdfC = ins->o_extbdfTable + (3*head+2)*3*sizeof(dfloat);
+
+  ins->o_prkA = ins->o_extbdfC;
+  ins->o_prkB = ins->o_extbdfC;
 }
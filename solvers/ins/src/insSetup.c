@@ -212,6 +212,10 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   ins->writeRestartFile = 0; 
   options.getArgs("WRITE RESTART FILE", ins->writeRestartFile);
 
+  ins->checkpoint = NULL;
+  if(ins->readRestartFile || ins->writeRestartFile)
+    ins->checkpoint = meshCheckpointSetup(mesh);
+
 
 
   dlong Nlocal = mesh->Np*mesh->Nelements;
@@ -332,14 +336,14 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
     occa::setVerboseCompilation(false);
 #endif
   
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
       if (ins->dim==2) 
         ins->setFlowFieldKernel =  mesh->device.buildKernel(DINS "/okl/insSetFlowField2D.okl", "insSetFlowField2D", kernelInfo);  
       else
         ins->setFlowFieldKernel =  mesh->device.buildKernel(DINS "/okl/insSetFlowField3D.okl", "insSetFlowField3D", kernelInfo);  
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
   }
 
   ins->startTime =0.0;
@@ -605,6 +609,7 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   ins->vSolver->elementType = ins->elementType;
   ins->vSolver->BCType = (int*) calloc(7,sizeof(int));
   memcpy(ins->vSolver->BCType,vBCType,7*sizeof(int));
+  ins->vSolver->preconSource = ins->uSolver;
   ellipticSolveSetup(ins->vSolver, ins->lambda, kernelInfoV);
 
   if (ins->dim==3) {
@@ -615,8 +620,14 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
     ins->wSolver->elementType = ins->elementType;
     ins->wSolver->BCType = (int*) calloc(7,sizeof(int));
     memcpy(ins->wSolver->BCType,wBCType,7*sizeof(int));
+    ins->wSolver->preconSource = ins->uSolver;
     ellipticSolveSetup(ins->wSolver, ins->lambda, kernelInfoV);  
   }
+
+  if (options.compareArgs("VELOCITY BLOCK SOLVER", "TRUE")) {
+    elliptic_t *vSolvers[3] = {ins->uSolver, ins->vSolver, ins->wSolver};
+    ins->velocityBlock = ellipticBlockSolveSetup(vSolvers, ins->NVfields, ins->fieldOffset, ins->lambda, kernelInfoV);
+  }
   
   if (mesh->rank==0) printf("==================PRESSURE SOLVE SETUP=========================\n");
   ins->pSolver = (elliptic_t*) calloc(1, sizeof(elliptic_t));
@@ -724,20 +735,23 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
     dfloat rkC[4] = {1.0, 0.0, -1.0, -2.0};
 
     ins->o_rkC  = mesh->device.malloc(4*sizeof(dfloat),rkC);
-    ins->o_extbdfA = mesh->device.malloc(3*sizeof(dfloat));
-    ins->o_extbdfB = mesh->device.malloc(3*sizeof(dfloat));
-    ins->o_extbdfC = mesh->device.malloc(3*sizeof(dfloat)); 
+    // A, B and C coefficients in slot order, for each of the (up to 3) history heads
+    ins->o_extbdfTable = mesh->device.malloc(3*3*3*sizeof(dfloat));
 
     ins->o_extC = mesh->device.malloc(3*sizeof(dfloat)); 
 
-    ins->o_prkA = ins->o_extbdfC;
-    ins->o_prkB = ins->o_extbdfC;
+    insSetHistoryHead(ins, 0);
   }
 
   // MEMORY ALLOCATION
-  ins->o_rhsU  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsU);
-  ins->o_rhsV  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsV);
-  ins->o_rhsW  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsW);
+  // velocity rhs and solution components are packed so they can be solved as a block
+  ins->o_rhsUVW = mesh->device.malloc(3*Ntotal*sizeof(dfloat));
+  ins->o_rhsU  = ins->o_rhsUVW + 0*Ntotal*sizeof(dfloat);
+  ins->o_rhsV  = ins->o_rhsUVW + 1*Ntotal*sizeof(dfloat);
+  ins->o_rhsW  = ins->o_rhsUVW + 2*Ntotal*sizeof(dfloat);
+  ins->o_rhsU.copyFrom(ins->rhsU, Ntotal*sizeof(dfloat));
+  ins->o_rhsV.copyFrom(ins->rhsV, Ntotal*sizeof(dfloat));
+  ins->o_rhsW.copyFrom(ins->rhsW, Ntotal*sizeof(dfloat));
   ins->o_rhsP  = mesh->device.malloc(Ntotal*sizeof(dfloat), ins->rhsP);
 
   ins->o_NU    = mesh->device.malloc(ins->NVfields*(ins->Nstages+1)*Ntotal*sizeof(dfloat), ins->NU);
@@ -754,10 +768,14 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
   ins->o_rkLU  = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->rkLU);
   ins->o_rkGP  = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->rkGP);
 
+  ins->o_cfl    = mesh->device.malloc((mesh->Nelements+1)*sizeof(dfloat));
+  ins->o_cflMax = mesh->device.malloc(sizeof(dfloat));
+
   //storage for helmholtz solves
-  ins->o_UH = mesh->device.malloc(Ntotal*sizeof(dfloat));
-  ins->o_VH = mesh->device.malloc(Ntotal*sizeof(dfloat));
-  ins->o_WH = mesh->device.malloc(Ntotal*sizeof(dfloat));
+  ins->o_UVWH = mesh->device.malloc(3*Ntotal*sizeof(dfloat));
+  ins->o_UH = ins->o_UVWH + 0*Ntotal*sizeof(dfloat);
+  ins->o_VH = ins->o_UVWH + 1*Ntotal*sizeof(dfloat);
+  ins->o_WH = ins->o_UVWH + 2*Ntotal*sizeof(dfloat);
 
   //plotting fields
   ins->o_Vort = mesh->device.malloc(ins->NVfields*Ntotal*sizeof(dfloat), ins->Vort);
@@ -815,8 +833,8 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
 
   char fileName[BUFSIZ], kernelName[BUFSIZ];
 
-  for (int r=0;r<mesh->size;r++) {
-    if (r==mesh->rank) {
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
       sprintf(fileName, DINS "/okl/insHaloExchange.okl");
       sprintf(kernelName, "insVelocityHaloExtract");
       ins->velocityHaloExtractKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
@@ -927,6 +945,13 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
       sprintf(fileName, DINS "/okl/insVorticity%s.okl", suffix);
       sprintf(kernelName, "insVorticity%s", suffix);
       ins->vorticityKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+
+      sprintf(fileName, DINS "/okl/insCfl.okl");
+      sprintf(kernelName, "insCfl");
+      ins->cflKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
+
+      sprintf(kernelName, "insCflMax");
+      ins->cflMaxKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
     
       // ===========================================================================
       if(ins->dim==3 && ins->options.compareArgs("OUTPUT TYPE","ISO")){
@@ -973,7 +998,29 @@ ins_t *insSetup(mesh_t *mesh, setupAide options){
         ins->subCycleExtKernel =  mesh->device.buildKernel(fileName, kernelName, kernelInfo);
       }
     }
-    MPI_Barrier(mesh->comm);
+    occaKernelBuildDone(mesh, r);
+  }
+
+  ins->vtu = meshVTUSetup(mesh, options, kernelInfo);
+
+  // wall (tag 1) force integrals, the traction is only implemented on triangles
+  ins->forces = NULL;
+  if(ins->outputForceStep){
+    if(ins->elementType==TRIANGLES){
+      int wallTag = 1;
+      ins->forces = meshBoundaryIntegralSetup(mesh, 1, &wallTag, ins->dim, kernelInfo);
+
+      for (int r=0;r<occaKernelBuildRounds;r++) {
+        if (occaKernelBuildTurn(mesh, r)) {
+          ins->tractionKernel =
+            mesh->device.buildKernel(DINS "/okl/insTractionTri2D.okl", "insTractionTri2D", kernelInfo);
+        }
+        occaKernelBuildDone(mesh, r);
+      }
+    } else {
+      if(mesh->rank==0) printf("WARNING: force output is only implemented for triangles\n");
+      ins->outputForceStep = 0;
+    }
   }
 
   return ins;
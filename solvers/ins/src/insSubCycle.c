@@ -34,13 +34,16 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
 
   const dlong NtotalElements = (mesh->Nelements+mesh->totalHaloPairs);  
 
+  // newest velocity in the history ring
+  occa::memory o_U0 = o_U + insHistorySlot(ins,0)*ins->NVfields*ins->Ntotal*sizeof(dfloat);
+
   //Exctract Halo On Device, all fields
   if(mesh->totalHaloPairs>0){
     ins->velocityHaloExtractKernel(mesh->Nelements,
                                  mesh->totalHaloPairs,
                                  mesh->o_haloElementList,
                                  ins->fieldOffset,
-                                 o_U,
+                                 o_U0,
                                  ins->o_vHaloBuffer);
 
     // copy extracted halo to HOST 
@@ -59,7 +62,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
     ins->velocityHaloScatterKernel(mesh->Nelements,
                                   mesh->totalHaloPairs,
                                   ins->fieldOffset,
-                                  o_U,
+                                  o_U0,
                                   ins->o_vHaloBuffer);
   }
 
@@ -80,7 +83,7 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
     bScale += b;
 
     // Initialize SubProblem Velocity i.e. Ud = U^(t-torder*dt)
-    dlong toffset = torder*ins->NVfields*ins->Ntotal;
+    dlong toffset = insHistorySlot(ins,torder)*ins->NVfields*ins->Ntotal;
 
     if (torder==ins->ExplicitOrder-1) { //first substep
       ins->scaledAddKernel(ins->NVfields*ins->Ntotal, b, toffset, o_U, zero, izero, o_Ud);
@@ -97,21 +100,25 @@ void insSubCycle(ins_t *ins, dfloat time, int Nstages, occa::memory o_U, occa::m
         // Extrapolate velocity to subProblem stage time
         dfloat t = tstage +  ins->sdt*mesh->rkc[rk]; 
 
+        dfloat extC[3];
         switch(ins->ExplicitOrder){
           case 1:
-            ins->extC[0] = 1.f; ins->extC[1] = 0.f; ins->extC[2] = 0.f;
+            extC[0] = 1.f; extC[1] = 0.f; extC[2] = 0.f;
             break;
           case 2:
-            ins->extC[0] = (t-tn1)/(tn0-tn1);
-            ins->extC[1] = (t-tn0)/(tn1-tn0);
-            ins->extC[2] = 0.f; 
+            extC[0] = (t-tn1)/(tn0-tn1);
+            extC[1] = (t-tn0)/(tn1-tn0);
+            extC[2] = 0.f; 
             break;
           case 3:
-            ins->extC[0] = (t-tn1)*(t-tn2)/((tn0-tn1)*(tn0-tn2)); 
-            ins->extC[1] = (t-tn0)*(t-tn2)/((tn1-tn0)*(tn1-tn2));
-            ins->extC[2] = (t-tn0)*(t-tn1)/((tn2-tn0)*(tn2-tn1));
+            extC[0] = (t-tn1)*(t-tn2)/((tn0-tn1)*(tn0-tn2)); 
+            extC[1] = (t-tn0)*(t-tn2)/((tn1-tn0)*(tn1-tn2));
+            extC[2] = (t-tn0)*(t-tn1)/((tn2-tn0)*(tn2-tn1));
             break;
         }
+        //extrapolation weights in slot order of the history ring
+        for (int s=0;s<3;s++) ins->extC[s] = 0.f;
+        for (int s=0;s<ins->ExplicitOrder;s++) ins->extC[insHistorySlot(ins,s)] = extC[s];
         ins->o_extC.copyFrom(ins->extC);
 
         //compute advective velocity fields at time t
@@ -26,13 +26,13 @@ SOFTWARE.
 
 #include "ins.h"
 
-// solve lambda*U + A*U = rhsU
-void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU, 
-                                                           occa::memory o_rhsV, 
-                                                           occa::memory o_rhsW, 
-                                                           occa::memory o_Uhat){
+// solve lambda*U + A*U = rhsU, the rhs are read from the packed ins->o_rhsU/V/W
+void insVelocitySolve(ins_t *ins, dfloat time, int stage, occa::memory o_Uhat){
   
   mesh_t *mesh = ins->mesh; 
+  occa::memory &o_rhsU = ins->o_rhsU;
+  occa::memory &o_rhsV = ins->o_rhsV;
+  occa::memory &o_rhsW = ins->o_rhsW;
   elliptic_t *usolver = ins->uSolver; 
   elliptic_t *vsolver = ins->vSolver; 
   elliptic_t *wsolver = ins->wSolver; 
@@ -58,10 +58,14 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
                               o_rhsW);
     
     // gather-scatter
-    ogsGatherScatter(o_rhsU, ogsDfloat, ogsAdd, mesh->ogs);
-    ogsGatherScatter(o_rhsV, ogsDfloat, ogsAdd, mesh->ogs);
-    if (ins->dim==3)
-      ogsGatherScatter(o_rhsW, ogsDfloat, ogsAdd, mesh->ogs);
+    if (ins->velocityBlock) {
+      ogsGatherScatterMany(ins->o_rhsUVW, ins->NVfields, ins->fieldOffset, ogsDfloat, ogsAdd, mesh->ogs);
+    } else {
+      ogsGatherScatter(o_rhsU, ogsDfloat, ogsAdd, mesh->ogs);
+      ogsGatherScatter(o_rhsV, ogsDfloat, ogsAdd, mesh->ogs);
+      if (ins->dim==3)
+        ogsGatherScatter(o_rhsW, ogsDfloat, ogsAdd, mesh->ogs);
+    }
     if (usolver->Nmasked) mesh->maskKernel(usolver->Nmasked, usolver->o_maskIds, o_rhsU);
     if (vsolver->Nmasked) mesh->maskKernel(vsolver->Nmasked, vsolver->o_maskIds, o_rhsV);
     if (ins->dim==3)
@@ -91,10 +95,11 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
 
   //copy current velocity fields as initial guess? (could use Uhat or beter guess)
   dlong Ntotal = (mesh->Nelements+mesh->totalHaloPairs)*mesh->Np;
-  ins->o_UH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,0*ins->fieldOffset*sizeof(dfloat));
-  ins->o_VH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,1*ins->fieldOffset*sizeof(dfloat));
+  dlong Uoffset = insHistorySlot(ins,0)*ins->NVfields*ins->fieldOffset;
+  ins->o_UH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,(Uoffset+0*ins->fieldOffset)*sizeof(dfloat));
+  ins->o_VH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,(Uoffset+1*ins->fieldOffset)*sizeof(dfloat));
   if (ins->dim==3)
-    ins->o_WH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,2*ins->fieldOffset*sizeof(dfloat));
+    ins->o_WH.copyFrom(ins->o_U,Ntotal*sizeof(dfloat),0,(Uoffset+2*ins->fieldOffset)*sizeof(dfloat));
 
   if (ins->vOptions.compareArgs("DISCRETIZATION","CONTINUOUS")) {
     if (usolver->Nmasked) mesh->maskKernel(usolver->Nmasked, usolver->o_maskIds, ins->o_UH);
@@ -104,18 +109,30 @@ void insVelocitySolve(ins_t *ins, dfloat time, int stage,  occa::memory o_rhsU,
 
   }
   
-  occaTimerTic(mesh->device,"Ux-Solve");
-  ins->NiterU = ellipticSolve(usolver, ins->lambda, ins->velTOL, o_rhsU, ins->o_UH);
-  occaTimerToc(mesh->device,"Ux-Solve"); 
-
-  occaTimerTic(mesh->device,"Uy-Solve");
-  ins->NiterV = ellipticSolve(vsolver, ins->lambda, ins->velTOL, o_rhsV, ins->o_VH);
-  occaTimerToc(mesh->device,"Uy-Solve");
-
-  if (ins->dim==3) {
-    occaTimerTic(mesh->device,"Uz-Solve");
-    ins->NiterW = ellipticSolve(wsolver, ins->lambda, ins->velTOL, o_rhsW, ins->o_WH);
-    occaTimerToc(mesh->device,"Uz-Solve");
+  if (ins->velocityBlock) {
+    // all components together, o_rhsU/V/W are slices of ins->o_rhsUVW
+    int Niter[3] = {0, 0, 0};
+    occaTimerTic(mesh->device,"U-Block-Solve");
+    ellipticBlockSolve(ins->velocityBlock, ins->lambda, ins->velTOL, ins->o_rhsUVW, ins->o_UVWH, Niter);
+    occaTimerToc(mesh->device,"U-Block-Solve");
+
+    ins->NiterU = Niter[0];
+    ins->NiterV = Niter[1];
+    ins->NiterW = Niter[2];
+  } else {
+    occaTimerTic(mesh->device,"Ux-Solve");
+    ins->NiterU = ellipticSolve(usolver, ins->lambda, ins->velTOL, o_rhsU, ins->o_UH);
+    occaTimerToc(mesh->device,"Ux-Solve"); 
+
+    occaTimerTic(mesh->device,"Uy-Solve");
+    ins->NiterV = ellipticSolve(vsolver, ins->lambda, ins->velTOL, o_rhsV, ins->o_VH);
+    occaTimerToc(mesh->device,"Uy-Solve");
+
+    if (ins->dim==3) {
+      occaTimerTic(mesh->device,"Uz-Solve");
+      ins->NiterW = ellipticSolve(wsolver, ins->lambda, ins->velTOL, o_rhsW, ins->o_WH);
+      occaTimerToc(mesh->device,"Uz-Solve");
+    }
   }
 
   if (ins->vOptions.compareArgs("DISCRETIZATION","CONTINUOUS")) {
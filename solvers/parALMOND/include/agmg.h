@@ -50,8 +50,18 @@ SOFTWARE.
 
 
 void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowStarts, setupAide options);
+SmoothType agmgSmoothType(setupAide options, int *ChebyshevIterations);
+void agmgSetupLevel(parAlmond_t *parAlmond, agmgLevel *level, SmoothType smoothType, int ChebyshevIterations);
+void agmgAllocateVectors(parAlmond_t *parAlmond);
+
+//binary hierarchy files, one per rank
+unsigned long long agmgHierarchyKey(parAlmond_t *parAlmond, hlong *globalRowStarts,
+                                    dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals);
+bool agmgHierarchyLoad(parAlmond_t *parAlmond, const char *fileName, unsigned long long key);
+void agmgHierarchySave(parAlmond_t *parAlmond, int startLevel, const char *fileName, unsigned long long key);
 void parAlmondReport(parAlmond_t *parAlmond);
 void buildAlmondKernels(parAlmond_t *parAlmond);
+void buildAlmondFloatKernels(parAlmond_t *floatAlmond);
 
 void kcycle(parAlmond_t *parAlmond, int k);
 void device_kcycle(parAlmond_t *parAlmond, int k);
@@ -29,13 +29,22 @@ void agmgAx        (void **args, dfloat *x, dfloat *Ax);
 void agmgCoarsen   (void **args, dfloat *r, dfloat *Rr);
 void agmgProlongate(void **args, dfloat *x, dfloat *Px);
 void agmgSmooth    (void **args, dfloat *rhs, dfloat *x, bool x_is_zero);
+void agmgGather    (void **args, dfloat *x, dfloat *Gx);
+void agmgScatter   (void **args, dfloat *x, dfloat *Sx);
 
 void device_agmgAx        (void **args, occa::memory &o_x, occa::memory &o_Ax);
 void device_agmgCoarsen   (void **args, occa::memory &o_r, occa::memory &o_Rr);
 void device_agmgProlongate(void **args, occa::memory &o_x, occa::memory &o_Px);
 void device_agmgSmooth    (void **args, occa::memory &o_r, occa::memory &o_x, bool x_is_zero);
+void device_agmgGather    (void **args, occa::memory &o_x, occa::memory &o_Gx);
+void device_agmgScatter   (void **args, occa::memory &o_x, occa::memory &o_Sx);
 
 void setupSmoother(parAlmond_t *parAlmond, agmgLevel *level, SmoothType s);
+void setupCoarseSolve(parAlmond_t *parAlmond, agmgLevel *level);
+void agmgAgglomerate(parAlmond_t *parAlmond, agmgLevel *level, int agglomerationSize);
+void agmgAgglomerateSetup(parAlmond_t *parAlmond, agmgLevel *level, hlong *unaggStarts);
 void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, dfloat nullSpacePenalty);
+void setupCoarsePCG(parAlmond_t *parAlmond, agmgLevel *level);
+void coarsePCGSolve(parAlmond_t *parAlmond, int N, dfloat *rhs, dfloat *x);
 void exactCoarseSolve(parAlmond_t *parAlmond, int N, dfloat *rhs, dfloat *x);
 void device_exactCoarseSolve(parAlmond_t *parAlmond, int N, occa::memory o_rhs, occa::memory o_x);
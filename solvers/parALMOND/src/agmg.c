@@ -34,6 +34,11 @@ namespace agmg{
 
 }
 
+// fp32 levels run their vector ops with the fp32 kernel builds
+static parAlmond_t *levelAlmond(parAlmond_t *parAlmond, agmgLevel *level){
+  return level->floatPrecision ? parAlmond->floatAlmond : parAlmond;
+}
+
 void kcycle(parAlmond_t *parAlmond, int k){
 
   agmgLevel **levels = parAlmond->levels;
@@ -43,7 +48,7 @@ void kcycle(parAlmond_t *parAlmond, int k){
 
   //check for base level
   if(k==parAlmond->numLevels-1) {
-    if (parAlmond->invCoarseA != NULL) {
+    if (parAlmond->invCoarseA != NULL || parAlmond->coarseA != NULL) {
       //use exact sovler
       exactCoarseSolve(parAlmond, m, levels[k]->rhs, levels[k]->x);
     } else {
@@ -188,7 +193,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
 
   //check for base level
   if(k==parAlmond->numLevels-1) {
-    if (parAlmond->invCoarseA != NULL) {
+    if (parAlmond->invCoarseA != NULL || parAlmond->coarseA != NULL) {
       //use exact sovler
       device_exactCoarseSolve(parAlmond, m, levels[k]->o_rhs, levels[k]->o_x);
     } else {
@@ -211,7 +216,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
 
   // res = rhs - A*x
   levels[k]->device_Ax(levels[k]->AxArgs,levels[k]->o_x,levels[k]->o_res);
-  vectorAdd(parAlmond, m, 1.0, levels[k]->o_rhs, -1.0, levels[k]->o_res);
+  vectorAdd(levelAlmond(parAlmond, levels[k]), m, 1.0, levels[k]->o_rhs, -1.0, levels[k]->o_res);
 
   // coarsen the residual to next level, checking if the residual needs to be gathered after
   if (levels[k+1]->gatherLevel==true) {
@@ -225,6 +230,9 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
     device_vcycle(parAlmond,k+1);
     //device_kcycle(parAlmond, k+1);
   } else{
+    // vector ops on the coarse level use kernels of its precision
+    parAlmond_t *coarseAlmond = levelAlmond(parAlmond, levels[k+1]);
+
     // first inner krylov iteration
     device_kcycle(parAlmond,k+1);
 
@@ -243,7 +251,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
     //    returns aDotbc[0] = a.b, aDotbc[1] = a.c, aDotbc[2] = b.b
     //       or aDotbc[0] = w.a.b, aDotbc[1] = w.a.c, aDotbc[2] = w.b.b
     if(parAlmond->ktype == PCG)
-      kcycleCombinedOp1(parAlmond, mCoarse, rhoLocal,
+      kcycleCombinedOp1(coarseAlmond, mCoarse, rhoLocal,
                         levels[k+1]->o_ckp1,
                         levels[k+1]->o_rhs,
                         levels[k+1]->o_vkp1,
@@ -251,7 +259,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
                         levels[k+1]->weightedInnerProds);
 
     if(parAlmond->ktype == GMRES)
-      kcycleCombinedOp1(parAlmond, mCoarse, rhoLocal,
+      kcycleCombinedOp1(coarseAlmond, mCoarse, rhoLocal,
                         levels[k+1]->o_vkp1,
                         levels[k+1]->o_rhs,
                         levels[k+1]->o_vkp1,
@@ -265,7 +273,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
     norm_rkp1 = sqrt(rhoGlobal[2]);
 
     // rkp1 = rkp1 - (alpha1/rho1)*vkp1
-    norm_rktilde_pLocal = vectorAddInnerProd(parAlmond, mCoarse, -alpha1/rho1,
+    norm_rktilde_pLocal = vectorAddInnerProd(coarseAlmond, mCoarse, -alpha1/rho1,
                                               levels[k+1]->o_vkp1, 1.0,
                                               levels[k+1]->o_rhs,
                                               levels[k+1]->o_weight,
@@ -276,7 +284,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
     dfloat t = 0.2;
     if(norm_rktilde_pGlobal < t*norm_rkp1){
       //      levels[k+1]->x = (alpha1/rho1)*x
-      scaleVector(parAlmond,mCoarse, levels[k+1]->o_x, alpha1/rho1);
+      scaleVector(coarseAlmond,mCoarse, levels[k+1]->o_x, alpha1/rho1);
     } else{
     
       device_kcycle(parAlmond,k+1);
@@ -290,7 +298,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
       //   returns aDotbcd[0] = a.b, aDotbcd[1] = a.c, aDotbcd[2] = a.d,
       //      or aDotbcd[0] = w.a.b, aDotbcd[1] = w.a.c, aDotbcd[2] = w.a.d,
       if(parAlmond->ktype == PCG)
-        kcycleCombinedOp2(parAlmond,mCoarse,rhoLocal,
+        kcycleCombinedOp2(coarseAlmond,mCoarse,rhoLocal,
                           levels[k+1]->o_x,
                           levels[k+1]->o_vkp1,
                           levels[k+1]->o_wkp1,
@@ -299,7 +307,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
                           levels[k+1]->weightedInnerProds);
 
       if(parAlmond->ktype == GMRES)
-        kcycleCombinedOp2(parAlmond,mCoarse,rhoLocal,
+        kcycleCombinedOp2(coarseAlmond,mCoarse,rhoLocal,
                           levels[k+1]->o_wkp1,
                           levels[k+1]->o_vkp1,
                           levels[k+1]->o_wkp1,
@@ -322,7 +330,7 @@ void device_kcycle(parAlmond_t *parAlmond, int k){
           dfloat a = alpha1/rho1 - gamma*alpha2/(rho1*rho2);
           dfloat b = alpha2/rho2;
 
-          vectorAdd(parAlmond, mCoarse, a, levels[k+1]->o_ckp1,
+          vectorAdd(coarseAlmond, mCoarse, a, levels[k+1]->o_ckp1,
                                         b, levels[k+1]->o_x);
         }
       }
@@ -351,7 +359,7 @@ void vcycle(parAlmond_t *parAlmond, int k) {
 
   //check for base level
   if(k==parAlmond->numLevels-1) {
-    if (parAlmond->invCoarseA != NULL) {
+    if (parAlmond->invCoarseA != NULL || parAlmond->coarseA != NULL) {
       //use exact sovler
       exactCoarseSolve(parAlmond, m, levels[k]->rhs, levels[k]->x);
     } else {
@@ -415,7 +423,7 @@ void device_vcycle(parAlmond_t *parAlmond, int k){
 
   //check for base level
   if (k==parAlmond->numLevels-1) {
-    if (parAlmond->invCoarseA != NULL) {
+    if (parAlmond->invCoarseA != NULL || parAlmond->coarseA != NULL) {
       //use exact sovler
       device_exactCoarseSolve(parAlmond, m, levels[k]->o_rhs, levels[k]->o_x);
     } else {
@@ -435,7 +443,7 @@ void device_vcycle(parAlmond_t *parAlmond, int k){
 
   // res = rhs - A*x
   levels[k]->device_Ax(levels[k]->AxArgs,levels[k]->o_x,levels[k]->o_res);
-  vectorAdd(parAlmond, m, 1.0, levels[k]->o_rhs, -1.0, levels[k]->o_res);
+  vectorAdd(levelAlmond(parAlmond, levels[k]), m, 1.0, levels[k]->o_rhs, -1.0, levels[k]->o_res);
 
   // coarsen the residual to next level, checking if the residual needs to be gathered after
   if (levels[k+1]->gatherLevel==true) {
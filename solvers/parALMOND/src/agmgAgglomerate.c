@@ -0,0 +1,189 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "agmg.h"
+
+#define AGGLOM_AX_TIMINGS 10
+
+//max over ranks of the time for one host Ax (halo exchange and local products)
+static double agmgAxTime(csr *A){
+
+  dfloat *x = (dfloat *) calloc(mymax(A->Ncols,1),sizeof(dfloat));
+  dfloat *y = (dfloat *) calloc(mymax(A->Nrows,1),sizeof(dfloat));
+
+  MPI_Barrier(agmg::comm);
+  double tic = MPI_Wtime();
+  for (int n=0;n<AGGLOM_AX_TIMINGS;n++)
+    axpy(A, 1.0, x, 0.0, y, false, 0.);
+  double localTime = (MPI_Wtime()-tic)/AGGLOM_AX_TIMINGS;
+
+  double maxTime = 0.;
+  MPI_Allreduce(&localTime, &maxTime, 1, MPI_DOUBLE, MPI_MAX, agmg::comm);
+
+  free(x); free(y);
+  return maxTime;
+}
+
+//move a coarse level onto fewer ranks once it has less than agglomerationSize rows per active rank.
+// Groups of agglomStride consecutive ranks hand their rows to the first rank of the group. Global
+// row ids are unchanged, so P and R stay in the unagglomerated distribution and the cycle gathers
+// the coarsened residual onto the group leader and scatters the correction back.
+void agmgAgglomerate(parAlmond_t *parAlmond, agmgLevel *level, int agglomerationSize){
+
+  int rank, size;
+  rank = agmg::rank;
+  size = agmg::size;
+
+  csr *A = level->A;
+  hlong *unaggStarts = level->globalRowStarts;
+  hlong globalRows = unaggStarts[size];
+
+  int active = (A->Nrows>0) ? 1:0;
+  int totalActive = 0;
+  MPI_Allreduce(&active, &totalActive, 1, MPI_INT, MPI_SUM, agmg::comm);
+
+  if (globalRows >= (hlong) agglomerationSize*totalActive) return;
+
+  //number of ranks which keep rows
+  hlong Ntarget = mymax(globalRows/agglomerationSize, (hlong) 1);
+  int stride = (int) ((size+Ntarget-1)/Ntarget);
+  int Nagglom = (size+stride-1)/stride;
+  if ((stride<2)||(Nagglom>=totalActive)) return;
+
+  level->agglomStride = stride;
+  level->agglomAxTime[0] = agmgAxTime(A);
+
+  hlong *aggStarts = (hlong *) calloc(size+1,sizeof(hlong));
+  for (int r=0;r<size+1;r++)
+    aggStarts[r] = (r%stride==0) ? unaggStarts[r] : unaggStarts[mymin((r/stride+1)*stride,size)];
+
+  agmgAgglomerateSetup(parAlmond, level, unaggStarts);
+
+  int groupSize;
+  MPI_Comm_size(level->agglomComm, &groupSize);
+
+  //global COO of the local rows, in row order
+  dlong nnz = A->diagNNZ + A->offdNNZ;
+  hlong  *Ai = (hlong *)  calloc(mymax(nnz,1),sizeof(hlong));
+  hlong  *Aj = (hlong *)  calloc(mymax(nnz,1),sizeof(hlong));
+  dfloat *Av = (dfloat *) calloc(mymax(nnz,1),sizeof(dfloat));
+
+  nnz = 0;
+  for (dlong i=0;i<A->Nrows;i++) {
+    for (dlong j=A->diagRowStarts[i];j<A->diagRowStarts[i+1];j++) {
+      Ai[nnz] = i + unaggStarts[rank];
+      Aj[nnz] = A->colMap[A->diagCols[j]];
+      Av[nnz] = A->diagCoefs[j];
+      nnz++;
+    }
+    for (dlong j=A->offdRowStarts[i];j<A->offdRowStarts[i+1];j++) {
+      Ai[nnz] = i + unaggStarts[rank];
+      Aj[nnz] = A->colMap[A->offdCols[j]];
+      Av[nnz] = A->offdCoefs[j];
+      nnz++;
+    }
+  }
+
+  int localNNZ = (int) nnz;
+  int *NNZ        = (int *) calloc(groupSize,sizeof(int));
+  int *NNZoffsets = (int *) calloc(groupSize+1,sizeof(int));
+  MPI_Gather(&localNNZ, 1, MPI_INT, NNZ, 1, MPI_INT, 0, level->agglomComm);
+  for (int r=0;r<groupSize;r++)
+    NNZoffsets[r+1] = NNZoffsets[r] + NNZ[r];
+
+  dlong Nagg = (dlong) (aggStarts[rank+1]-aggStarts[rank]);
+  dlong aggNNZ = (dlong) NNZoffsets[groupSize];
+
+  hlong  *aggAi = (hlong *)  calloc(mymax(aggNNZ,1),sizeof(hlong));
+  hlong  *aggAj = (hlong *)  calloc(mymax(aggNNZ,1),sizeof(hlong));
+  dfloat *aggAv = (dfloat *) calloc(mymax(aggNNZ,1),sizeof(dfloat));
+  dfloat *aggNull = (dfloat *) calloc(mymax(Nagg,1),sizeof(dfloat));
+
+  MPI_Gatherv(Ai, localNNZ, MPI_HLONG,  aggAi, NNZ, NNZoffsets, MPI_HLONG,  0, level->agglomComm);
+  MPI_Gatherv(Aj, localNNZ, MPI_HLONG,  aggAj, NNZ, NNZoffsets, MPI_HLONG,  0, level->agglomComm);
+  MPI_Gatherv(Av, localNNZ, MPI_DFLOAT, aggAv, NNZ, NNZoffsets, MPI_DFLOAT, 0, level->agglomComm);
+  agmgGather(level->gatherArgs, A->null, aggNull);
+
+  csr *aggA = newCSRfromCOO(Nagg, aggStarts, aggNNZ, aggAi, aggAj, aggAv);
+  aggA->null = aggNull;
+
+  free(A->null);
+  freeCSR(A);
+
+  level->A = aggA;
+  level->globalRowStarts = aggStarts;
+  level->Nrows = aggA->Nrows;
+  level->Ncols = aggA->Ncols;
+
+  level->agglomAxTime[1] = agmgAxTime(aggA);
+
+  free(Ai); free(Aj); free(Av);
+  free(aggAi); free(aggAj); free(aggAv);
+  free(NNZ); free(NNZoffsets);
+}
+
+//set up the group communicator, counts and call-backs which move vectors between the unagglomerated
+// distribution unaggStarts and the group leaders. level->agglomStride must be set.
+void agmgAgglomerateSetup(parAlmond_t *parAlmond, agmgLevel *level, hlong *unaggStarts){
+
+  int rank = agmg::rank;
+  int stride = level->agglomStride;
+  int leader = rank - rank%stride;
+
+  MPI_Comm_split(agmg::comm, rank/stride, rank, &level->agglomComm);
+
+  int groupSize;
+  MPI_Comm_size(level->agglomComm, &groupSize);
+
+  level->agglomNsend = (dlong) (unaggStarts[rank+1]-unaggStarts[rank]);
+  level->agglomCounts  = (int *) calloc(groupSize,sizeof(int));
+  level->agglomOffsets = (int *) calloc(groupSize+1,sizeof(int));
+  for (int r=0;r<groupSize;r++) {
+    level->agglomCounts[r]    = (int) (unaggStarts[leader+r+1]-unaggStarts[leader+r]);
+    level->agglomOffsets[r+1] = level->agglomOffsets[r] + level->agglomCounts[r];
+  }
+
+  //R and P act on the unagglomerated vectors
+  dlong NS = mymax(level->R->Nrows, level->P->Ncols);
+  if (NS) {
+    level->Srhs = (dfloat *) calloc(NS,sizeof(dfloat));
+    level->Sx   = (dfloat *) calloc(NS,sizeof(dfloat));
+    level->o_Srhs = parAlmond->device.malloc(NS*sizeof(dfloat),level->Srhs);
+    level->o_Sx   = parAlmond->device.malloc(NS*sizeof(dfloat),level->Sx);
+  }
+
+  void **args = (void **) calloc(2,sizeof(void*));
+  args[0] = (void *) parAlmond;
+  args[1] = (void *) level;
+
+  level->gatherLevel = true;
+  level->gatherArgs  = args;
+  level->scatterArgs = args;
+  level->gather  = agmgGather;
+  level->scatter = agmgScatter;
+  level->device_gather  = device_agmgGather;
+  level->device_scatter = device_agmgScatter;
+}
@@ -0,0 +1,414 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "agmg.h"
+
+// A hierarchy file holds one rank's share of the AMG levels below any levels
+// added by the caller: the partition, A, P, R and null vector of every level,
+// the agglomeration of coarse levels and, for the dense coarse solver, the
+// local rows of the coarse inverse.
+
+#define AGMG_HIERARCHY_MAGIC "LPAMGHIE"
+#define AGMG_HIERARCHY_VERSION 2
+
+typedef struct {
+  char magic[8];
+  int version;
+  int dfloatSize, dlongSize, hlongSize;
+  int size, rank;
+  unsigned long long key;
+  int Nlevels;
+  int hasInvCoarse;
+} agmgHierarchyHeader_t;
+
+static unsigned long long fnv1a(unsigned long long h, const void *data, size_t bytes){
+  const unsigned char *c = (const unsigned char *) data;
+  for (size_t n=0;n<bytes;n++) {
+    h ^= c[n];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// hash of the input operator and of the options that shape the hierarchy.
+// The operator already encodes mesh, degree, lambda and boundary conditions.
+unsigned long long agmgHierarchyKey(parAlmond_t *parAlmond, hlong *globalRowStarts,
+                                    dlong nnz, hlong *Ai, hlong *Aj, dfloat *Avals){
+
+  int rank = agmg::rank;
+  int size = agmg::size;
+
+  unsigned long long h = 14695981039346656037ULL;
+  h = fnv1a(h, &rank, sizeof(int));
+  h = fnv1a(h, &nnz, sizeof(dlong));
+  h = fnv1a(h, Ai, nnz*sizeof(hlong));
+  h = fnv1a(h, Aj, nnz*sizeof(hlong));
+  h = fnv1a(h, Avals, nnz*sizeof(dfloat));
+
+  unsigned long long *hashes = (unsigned long long *) calloc(size, sizeof(unsigned long long));
+  MPI_Allgather(&h, 1, MPI_UNSIGNED_LONG_LONG, hashes, 1, MPI_UNSIGNED_LONG_LONG, agmg::comm);
+
+  int gCoarseSize = 1000;
+  parAlmond->options.getArgs("PARALMOND COARSE SIZE", gCoarseSize);
+  int agglomerationSize = 0;
+  parAlmond->options.getArgs("PARALMOND AGGLOMERATION SIZE", agglomerationSize);
+  int partition = parAlmond->options.compareArgs("PARALMOND PARTITION", "STRONGNODES")
+               + 2*parAlmond->options.compareArgs("PARALMOND PARTITION", "DISTRIBUTED");
+  int nullSpace = parAlmond->nullSpace ? 1:0;
+
+  unsigned long long key = 14695981039346656037ULL;
+  key = fnv1a(key, &size, sizeof(int));
+  key = fnv1a(key, globalRowStarts, (size+1)*sizeof(hlong));
+  key = fnv1a(key, hashes, size*sizeof(unsigned long long));
+  key = fnv1a(key, &gCoarseSize, sizeof(int));
+  key = fnv1a(key, &agglomerationSize, sizeof(int));
+  key = fnv1a(key, &partition, sizeof(int));
+  key = fnv1a(key, &nullSpace, sizeof(int));
+  key = fnv1a(key, &parAlmond->nullSpacePenalty, sizeof(dfloat));
+
+  free(hashes);
+  return key;
+}
+
+static void writeCSR(FILE *fp, csr *A){
+
+  fwrite(&A->Nrows, sizeof(dlong), 1, fp);
+  fwrite(&A->Ncols, sizeof(dlong), 1, fp);
+  fwrite(&A->NlocalCols, sizeof(dlong), 1, fp);
+  fwrite(&A->NHalo, sizeof(dlong), 1, fp);
+  fwrite(&A->diagNNZ, sizeof(dlong), 1, fp);
+  fwrite(&A->offdNNZ, sizeof(dlong), 1, fp);
+
+  if (A->Nrows) {
+    fwrite(A->diagRowStarts, sizeof(dlong), A->Nrows+1, fp);
+    fwrite(A->offdRowStarts, sizeof(dlong), A->Nrows+1, fp);
+  }
+  fwrite(A->diagCols,  sizeof(dlong),  A->diagNNZ, fp);
+  fwrite(A->diagCoefs, sizeof(dfloat), A->diagNNZ, fp);
+  fwrite(A->offdCols,  sizeof(dlong),  A->offdNNZ, fp);
+  fwrite(A->offdCoefs, sizeof(dfloat), A->offdNNZ, fp);
+  fwrite(A->colMap,    sizeof(hlong),  A->Ncols, fp);
+}
+
+// bytes between the file position and the end of the file
+static size_t bytesLeft(FILE *fp){
+
+  long pos = ftell(fp);
+  fseek(fp, 0, SEEK_END);
+  long end = ftell(fp);
+  fseek(fp, pos, SEEK_SET);
+
+  return (pos>=0 && end>pos) ? (size_t) (end-pos) : 0;
+}
+
+// read count items, failing on a short read or a count the file cannot hold
+static bool readItems(FILE *fp, void *data, size_t bytes, size_t count, bool &ok){
+
+  if (!ok || count==0) return ok;
+
+  ok = (count<=bytesLeft(fp)/bytes) && (fread(data, bytes, count, fp)==count);
+  return ok;
+}
+
+static void *readArray(FILE *fp, size_t bytes, size_t count, bool &ok){
+
+  if (!ok || count==0) return NULL;
+
+  if (count>bytesLeft(fp)/bytes) {
+    ok = false;
+    return NULL;
+  }
+
+  void *a = calloc(count, bytes);
+  readItems(fp, a, bytes, count, ok);
+  return a;
+}
+
+// the halo of the csr is set up once the whole file has been read
+static csr *readCSR(FILE *fp, bool &ok){
+
+  csr *A = (csr *) calloc(1,sizeof(csr));
+
+  readItems(fp, &A->Nrows, sizeof(dlong), 1, ok);
+  readItems(fp, &A->Ncols, sizeof(dlong), 1, ok);
+  readItems(fp, &A->NlocalCols, sizeof(dlong), 1, ok);
+  readItems(fp, &A->NHalo, sizeof(dlong), 1, ok);
+  readItems(fp, &A->diagNNZ, sizeof(dlong), 1, ok);
+  readItems(fp, &A->offdNNZ, sizeof(dlong), 1, ok);
+
+  if (ok && A->Nrows) {
+    A->diagRowStarts = (dlong *) readArray(fp, sizeof(dlong), (size_t) A->Nrows+1, ok);
+    A->offdRowStarts = (dlong *) readArray(fp, sizeof(dlong), (size_t) A->Nrows+1, ok);
+  }
+  A->diagCols  = (dlong *)  readArray(fp, sizeof(dlong),  (size_t) A->diagNNZ, ok);
+  A->diagCoefs = (dfloat *) readArray(fp, sizeof(dfloat), (size_t) A->diagNNZ, ok);
+  A->offdCols  = (dlong *)  readArray(fp, sizeof(dlong),  (size_t) A->offdNNZ, ok);
+  A->offdCoefs = (dfloat *) readArray(fp, sizeof(dfloat), (size_t) A->offdNNZ, ok);
+  A->colMap    = (hlong *)  readArray(fp, sizeof(hlong),  (size_t) A->Ncols, ok);
+
+  return A;
+}
+
+// free a csr read by readCSR, before its halo was set up
+static void freeReadCSR(csr *A){
+
+  if (A==NULL) return;
+
+  free(A->diagRowStarts);
+  free(A->offdRowStarts);
+  free(A->diagCols);
+  free(A->diagCoefs);
+  free(A->offdCols);
+  free(A->offdCoefs);
+  free(A->colMap);
+  free(A);
+}
+
+void agmgHierarchySave(parAlmond_t *parAlmond, int startLevel, const char *fileName, unsigned long long key){
+
+  int rank = agmg::rank;
+  int size = agmg::size;
+
+  FILE *fp = fopen(fileName, "wb");
+  if (fp==NULL) {
+    printf("Rank %d: could not write AMG hierarchy file %s\n", rank, fileName);
+    return;
+  }
+
+  agmgHierarchyHeader_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, AGMG_HIERARCHY_MAGIC, 8);
+  header.version = AGMG_HIERARCHY_VERSION;
+  header.dfloatSize = sizeof(dfloat);
+  header.dlongSize  = sizeof(dlong);
+  header.hlongSize  = sizeof(hlong);
+  header.size = size;
+  header.rank = rank;
+  header.key  = key;
+  header.Nlevels = parAlmond->numLevels - startLevel;
+  header.hasInvCoarse = (parAlmond->invCoarseA!=NULL) ? 1:0;
+  fwrite(&header, sizeof(header), 1, fp);
+
+  for (int lev=startLevel;lev<parAlmond->numLevels;lev++) {
+    agmgLevel *level = parAlmond->levels[lev];
+
+    fwrite(level->globalRowStarts, sizeof(hlong), size+1, fp);
+    writeCSR(fp, level->A);
+    fwrite(level->A->null, sizeof(dfloat), level->A->Nrows, fp);
+    if (lev>startLevel) {
+      //partition of this level before any agglomeration, P's column partition
+      fwrite(parAlmond->levels[lev-1]->globalAggStarts, sizeof(hlong), size+1, fp);
+      fwrite(&level->agglomStride, sizeof(int), 1, fp);
+      fwrite(level->agglomAxTime, sizeof(double), 2, fp);
+      writeCSR(fp, level->P);
+      writeCSR(fp, level->R);
+    }
+  }
+
+  if (header.hasInvCoarse) {
+    dlong N = parAlmond->levels[parAlmond->numLevels-1]->Nrows;
+    fwrite(&parAlmond->coarseTotal, sizeof(int), 1, fp);
+    fwrite(parAlmond->coarseOffsets, sizeof(int), size+1, fp);
+    fwrite(parAlmond->invCoarseA, sizeof(dfloat), (size_t)N*parAlmond->coarseTotal, fp);
+  }
+
+  fclose(fp);
+}
+
+// collective: loads the hierarchy only if every rank has a matching file
+bool agmgHierarchyLoad(parAlmond_t *parAlmond, const char *fileName, unsigned long long key){
+
+  int rank = agmg::rank;
+  int size = agmg::size;
+
+  agmgHierarchyHeader_t header;
+  memset(&header, 0, sizeof(header));
+
+  int found = 0;
+  FILE *fp = fopen(fileName, "rb");
+  if (fp!=NULL) {
+    found = (fread(&header, sizeof(header), 1, fp)==1)
+          && !strncmp(header.magic, AGMG_HIERARCHY_MAGIC, 8)
+          && header.version==AGMG_HIERARCHY_VERSION
+          && header.dfloatSize==sizeof(dfloat)
+          && header.dlongSize==sizeof(dlong)
+          && header.hlongSize==sizeof(hlong)
+          && header.size==size && header.rank==rank
+          && header.key==key
+          && header.Nlevels>0
+          && parAlmond->numLevels+header.Nlevels<=MAX_LEVELS;
+  }
+
+  int allFound = 0;
+  MPI_Allreduce(&found, &allFound, 1, MPI_INT, MPI_MIN, agmg::comm);
+  if (!allFound) {
+    if (fp!=NULL) fclose(fp);
+    return false;
+  }
+
+  //read the whole file before setting anything up, so a truncated file
+  //falls back to building the hierarchy
+  bool ok = true;
+
+  int Nlevels = header.Nlevels;
+  hlong **globalRowStarts = (hlong **) calloc(Nlevels, sizeof(hlong*));
+  hlong **aggStarts = (hlong **) calloc(Nlevels, sizeof(hlong*));
+  csr **As = (csr **) calloc(Nlevels, sizeof(csr*));
+  csr **Ps = (csr **) calloc(Nlevels, sizeof(csr*));
+  csr **Rs = (csr **) calloc(Nlevels, sizeof(csr*));
+  dfloat **nulls = (dfloat **) calloc(Nlevels, sizeof(dfloat*));
+  int *agglomStride = (int *) calloc(Nlevels, sizeof(int));
+  double *agglomAxTime = (double *) calloc(2*Nlevels, sizeof(double));
+
+  for (int l=0;l<Nlevels && ok;l++) {
+    globalRowStarts[l] = (hlong *) readArray(fp, sizeof(hlong), size+1, ok);
+
+    As[l] = readCSR(fp, ok);
+    if (ok) {
+      nulls[l] = (dfloat *) calloc(mymax(mymax(As[l]->Ncols,As[l]->Nrows),1),sizeof(dfloat));
+      readItems(fp, nulls[l], sizeof(dfloat), (size_t) As[l]->Nrows, ok);
+    }
+
+    if (l>0) {
+      aggStarts[l] = (hlong *) readArray(fp, sizeof(hlong), size+1, ok);
+      readItems(fp, agglomStride+l, sizeof(int), 1, ok);
+      readItems(fp, agglomAxTime+2*l, sizeof(double), 2, ok);
+
+      Ps[l] = readCSR(fp, ok);
+      if (ok) Rs[l] = readCSR(fp, ok);
+    }
+  }
+
+  bool readInvCoarse = header.hasInvCoarse && !parAlmond->options.compareArgs("PARALMOND COARSE SOLVER", "PCG");
+
+  int coarseTotal = 0;
+  int *coarseOffsets = NULL;
+  dfloat *invCoarseA = NULL;
+  if (readInvCoarse && ok) {
+    dlong coarseNrows = As[Nlevels-1]->Nrows;
+    readItems(fp, &coarseTotal, sizeof(int), 1, ok);
+    coarseOffsets = (int *) readArray(fp, sizeof(int), size+1, ok);
+    if (ok && coarseTotal>=0)
+      invCoarseA = (dfloat *) readArray(fp, sizeof(dfloat), (size_t)coarseNrows*coarseTotal, ok);
+    else
+      ok = false;
+  }
+
+  fclose(fp);
+
+  int readOk = ok ? 1:0, allReadOk = 0;
+  MPI_Allreduce(&readOk, &allReadOk, 1, MPI_INT, MPI_MIN, agmg::comm);
+
+  if (!allReadOk) {
+    if (rank==0) printf("AMG hierarchy file %s is incomplete, rebuilding\n", fileName);
+
+    for (int l=0;l<Nlevels;l++) {
+      free(globalRowStarts[l]); free(aggStarts[l]); free(nulls[l]);
+      freeReadCSR(As[l]); freeReadCSR(Ps[l]); freeReadCSR(Rs[l]);
+    }
+    free(coarseOffsets); free(invCoarseA);
+    free(globalRowStarts); free(aggStarts); free(nulls);
+    free(As); free(Ps); free(Rs);
+    free(agglomStride); free(agglomAxTime);
+    return false;
+  }
+
+  //same seed as agmgSetup for the smoother's spectral radius estimates
+  double seed = (double) rank;
+  srand48(seed);
+
+  agmgLevel **levels = parAlmond->levels;
+  int startLevel = parAlmond->numLevels;
+
+  int ChebyshevIterations;
+  SmoothType smoothType = agmgSmoothType(parAlmond->options, &ChebyshevIterations);
+
+  for (int lev=startLevel;lev<startLevel+Nlevels;lev++) {
+    int l = lev-startLevel;
+
+    levels[lev] = (agmgLevel *) calloc(1,sizeof(agmgLevel));
+    levels[lev]->gatherLevel = false;
+    levels[lev]->weightedInnerProds = false;
+    parAlmond->numLevels++;
+
+    levels[lev]->globalRowStarts = globalRowStarts[l];
+
+    csr *A = As[l];
+    csrHaloSetup(A, levels[lev]->globalRowStarts);
+    A->null = nulls[l];
+
+    levels[lev]->A = A;
+    levels[lev]->Nrows = A->Nrows;
+    levels[lev]->Ncols = A->Ncols;
+
+    if (lev>startLevel) {
+      levels[lev]->agglomStride = agglomStride[l];
+      levels[lev]->agglomAxTime[0] = agglomAxTime[2*l+0];
+      levels[lev]->agglomAxTime[1] = agglomAxTime[2*l+1];
+      levels[lev-1]->globalAggStarts = aggStarts[l];
+
+      levels[lev]->P = Ps[l];
+      levels[lev]->R = Rs[l];
+      csrHaloSetup(levels[lev]->P, aggStarts[l]);
+      csrHaloSetup(levels[lev]->R, levels[lev-1]->globalRowStarts);
+
+      //same dimensions as a freshly coarsened level
+      levels[lev-1]->Ncols = mymax(levels[lev-1]->Ncols, levels[lev]->R->Ncols);
+      if (levels[lev]->agglomStride)
+        agmgAgglomerateSetup(parAlmond, levels[lev], aggStarts[l]);
+      else
+        levels[lev]->Ncols = mymax(levels[lev]->A->Ncols, levels[lev]->P->Ncols);
+    }
+
+    agmgSetupLevel(parAlmond, levels[lev], smoothType, ChebyshevIterations);
+  }
+
+  free(globalRowStarts); free(aggStarts); free(nulls);
+  free(As); free(Ps); free(Rs);
+  free(agglomStride); free(agglomAxTime);
+
+  agmgLevel *coarseLevel = levels[parAlmond->numLevels-1];
+
+  if (readInvCoarse) {
+    parAlmond->coarseTotal = coarseTotal;
+    parAlmond->invCoarseA = invCoarseA;
+
+    parAlmond->coarseOffset = coarseOffsets[rank];
+    parAlmond->coarseOffsets = coarseOffsets;
+    parAlmond->coarseCounts = (int*) calloc(size,sizeof(int));
+    for (int r=0;r<size;r++)
+      parAlmond->coarseCounts[r] = coarseOffsets[r+1]-coarseOffsets[r];
+
+    parAlmond->xCoarse   = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+    parAlmond->rhsCoarse = (dfloat*) calloc(coarseTotal,sizeof(dfloat));
+  } else {
+    setupCoarseSolve(parAlmond, coarseLevel);
+  }
+
+  agmgAllocateVectors(parAlmond);
+
+  return true;
+}
@@ -61,6 +61,24 @@ void agmgSmooth(void **args, dfloat *rhs, dfloat *x, bool x_is_zero){
   }
 }
 
+//collect the coarsened vector of an agglomerated level on its group leader
+void agmgGather(void **args, dfloat *x, dfloat *Gx){
+  // parAlmond_t *parAlmond = (parAlmond_t *) args[0];
+  agmgLevel *level = (agmgLevel *) args[1];
+
+  MPI_Gatherv(x, level->agglomNsend, MPI_DFLOAT,
+              Gx, level->agglomCounts, level->agglomOffsets, MPI_DFLOAT, 0, level->agglomComm);
+}
+
+//return the correction of an agglomerated level to the ranks owning the aggregates
+void agmgScatter(void **args, dfloat *x, dfloat *Sx){
+  // parAlmond_t *parAlmond = (parAlmond_t *) args[0];
+  agmgLevel *level = (agmgLevel *) args[1];
+
+  MPI_Scatterv(x, level->agglomCounts, level->agglomOffsets, MPI_DFLOAT,
+               Sx, level->agglomNsend, MPI_DFLOAT, 0, level->agglomComm);
+}
+
 void device_agmgAx(void **args, occa::memory &o_x, occa::memory &o_Ax){
   parAlmond_t *parAlmond = (parAlmond_t *) args[0];
   agmgLevel *level = (agmgLevel *) args[1];
@@ -82,6 +100,23 @@ void device_agmgProlongate(void **args, occa::memory &o_x, occa::memory &o_Px){
   axpy(parAlmond, level->dcsrP, 1.0, o_x, 1.0, o_Px);
 }
 
+//device versions stage through the level's host Srhs/Sx and rhs/x buffers
+void device_agmgGather(void **args, occa::memory &o_x, occa::memory &o_Gx){
+  agmgLevel *level = (agmgLevel *) args[1];
+
+  if (level->agglomNsend) o_x.copyTo(level->Srhs, level->agglomNsend*sizeof(dfloat));
+  agmgGather(args, level->Srhs, level->rhs);
+  if (level->Nrows) o_Gx.copyFrom(level->rhs, level->Nrows*sizeof(dfloat));
+}
+
+void device_agmgScatter(void **args, occa::memory &o_x, occa::memory &o_Sx){
+  agmgLevel *level = (agmgLevel *) args[1];
+
+  if (level->Nrows) o_x.copyTo(level->x, level->Nrows*sizeof(dfloat));
+  agmgScatter(args, level->x, level->Sx);
+  if (level->agglomNsend) o_Sx.copyFrom(level->Sx, level->agglomNsend*sizeof(dfloat));
+}
+
 void device_agmgSmooth(void **args, occa::memory &o_rhs, occa::memory &o_x, bool x_is_zero){
   parAlmond_t *parAlmond = (parAlmond_t *) args[0];
   agmgLevel *level = (agmgLevel *) args[1];
@@ -298,6 +333,118 @@ dfloat rhoDinvA(parAlmond_t* parAlmond,csr *A, dfloat *invD){
 
 void matrixInverse(int N, dfloat *A);
 
+//pick the coarsest level solver from PARALMOND COARSE SOLVER (DENSE or PCG)
+void setupCoarseSolve(parAlmond_t *parAlmond, agmgLevel *level) {
+
+  if (parAlmond->options.compareArgs("PARALMOND COARSE SOLVER", "PCG"))
+    setupCoarsePCG(parAlmond, level);
+  else
+    setupExactSolve(parAlmond, level, parAlmond->nullSpace, parAlmond->nullSpacePenalty);
+}
+
+//set up a distributed Jacobi-PCG on the coarse level's own csr. Unlike the
+//dense inverse nothing is gathered: memory stays O(local nnz) and each solve
+//costs a halo exchange and two Allreduces per iteration.
+void setupCoarsePCG(parAlmond_t *parAlmond, agmgLevel *level) {
+
+  csr *A = level->A;
+  dlong N = A->Nrows;
+  dlong M = mymax(A->Ncols, N);
+
+  if((agmg::rank==0)&&(parAlmond->options.compareArgs("VERBOSE","TRUE"))) printf("Setting up coarse PCG solver...");fflush(stdout);
+
+  parAlmond->coarseA = A;
+
+  parAlmond->coarseMaxIt = 50;
+  parAlmond->coarseTol = 1e-2;
+  parAlmond->options.getArgs("PARALMOND COARSE ITERATIONS", parAlmond->coarseMaxIt);
+  parAlmond->options.getArgs("PARALMOND COARSE TOLERANCE", parAlmond->coarseTol);
+
+  if (N) {
+    parAlmond->coarseDiagInv = (dfloat *) calloc(N,sizeof(dfloat));
+    parAlmond->coarseR  = (dfloat *) calloc(N,sizeof(dfloat));
+    parAlmond->coarseZ  = (dfloat *) calloc(N,sizeof(dfloat));
+    parAlmond->coarseAp = (dfloat *) calloc(N,sizeof(dfloat));
+  }
+  //p is the only vector the operator reads, so it carries the halo
+  if (M) parAlmond->coarseP = (dfloat *) calloc(M,sizeof(dfloat));
+
+  for (dlong i=0;i<N;i++) {
+    dfloat diag = A->diagCoefs[A->diagRowStarts[i]];
+    if (parAlmond->nullSpace)
+      diag += parAlmond->nullSpacePenalty*A->null[i]*A->null[i];
+    parAlmond->coarseDiagInv[i] = 1.0/diag;
+  }
+
+  if((agmg::rank==0)&&(parAlmond->options.compareArgs("VERBOSE","TRUE"))) printf("done.\n");
+}
+
+//approximate coarse solve: x = A^{-1} rhs to a relative tolerance of coarseTol.
+//This is not a fixed linear operator, so the outer Krylov method should be flexible.
+void coarsePCGSolve(parAlmond_t *parAlmond, int N, dfloat *rhs, dfloat *x) {
+
+  csr *A = parAlmond->coarseA;
+
+  dfloat *r  = parAlmond->coarseR;
+  dfloat *z  = parAlmond->coarseZ;
+  dfloat *p  = parAlmond->coarseP;
+  dfloat *Ap = parAlmond->coarseAp;
+  dfloat *invD = parAlmond->coarseDiagInv;
+
+  dfloat localDots[2], dots[2];
+
+  // x = 0, r = rhs, p = z = invD*r
+  #pragma omp parallel for
+  for (dlong i=0;i<N;i++) {
+    x[i] = 0.;
+    r[i] = rhs[i];
+    z[i] = invD[i]*r[i];
+    p[i] = z[i];
+  }
+
+  localDots[0] = innerProd(N, r, r);
+  localDots[1] = innerProd(N, r, z);
+  MPI_Allreduce(localDots, dots, 2, MPI_DFLOAT, MPI_SUM, agmg::comm);
+
+  dfloat TOL = parAlmond->coarseTol*parAlmond->coarseTol*dots[0];
+  dfloat rdotz0 = dots[1];
+
+  if (dots[0]==0.) return;
+
+  for (int it=0;it<parAlmond->coarseMaxIt;it++) {
+
+    // Ap = A*p
+    axpy(A, 1.0, p, 0.0, Ap, parAlmond->nullSpace, parAlmond->nullSpacePenalty);
+
+    dfloat pApLocal = innerProd(N, p, Ap);
+    dfloat pAp = 0;
+    MPI_Allreduce(&pApLocal, &pAp, 1, MPI_DFLOAT, MPI_SUM, agmg::comm);
+
+    dfloat alpha = rdotz0/pAp;
+
+    // x += alpha*p, r -= alpha*Ap, z = invD*r
+    #pragma omp parallel for
+    for (dlong i=0;i<N;i++) {
+      x[i] += alpha*p[i];
+      r[i] -= alpha*Ap[i];
+      z[i] = invD[i]*r[i];
+    }
+
+    // r.r and r.z in one reduction
+    localDots[0] = innerProd(N, r, r);
+    localDots[1] = innerProd(N, r, z);
+    MPI_Allreduce(localDots, dots, 2, MPI_DFLOAT, MPI_SUM, agmg::comm);
+
+    if (dots[0]<TOL) break;
+
+    dfloat beta = dots[1]/rdotz0;
+    rdotz0 = dots[1];
+
+    // p = z + beta*p
+    vectorAdd(N, 1.0, z, beta, p);
+  }
+}
+
 //set up exact solver using xxt
 void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, dfloat nullSpacePenalty) {
 
@@ -305,6 +452,15 @@ void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, d
   rank = agmg::rank;
   size = agmg::size;
 
+  //the dense coarse operator is indexed with ints, so its square must fit in an int
+  hlong globalCoarseTotal = level->globalRowStarts[size];
+  if (globalCoarseTotal > 46340) {
+    if (rank==0)
+      printf("ERROR: coarse level has " hlongFormat " rows, too many for the dense coarse solver; "
+             "set PARALMOND COARSE SOLVER = PCG or lower PARALMOND COARSE SIZE\n", globalCoarseTotal);
+    MPI_Abort(agmg::comm, 1);
+  }
+
   //copy the global coarse partition as ints
   int *coarseOffsets = (int* ) calloc(size+1,sizeof(int));
   for (int r=0;r<size+1;r++) coarseOffsets[r] = (int) level->globalRowStarts[r];
@@ -414,7 +570,7 @@ void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, d
   MPI_Allgatherv(vals, localNNZ, MPI_DFLOAT, Avals, NNZ, NNZoffsets, MPI_DFLOAT, agmg::comm);
 
   //assemble the full matrix
-  dfloat *coarseA = (dfloat *) calloc(coarseTotal*coarseTotal,sizeof(dfloat));
+  dfloat *coarseA = (dfloat *) calloc((size_t)coarseTotal*coarseTotal,sizeof(dfloat));
   for (int i=0;i<totalNNZ;i++) {
     int n = Arows[i];
     int m = Acols[i];
@@ -424,7 +580,7 @@ void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, d
   matrixInverse(coarseTotal, coarseA);
 
   //store only the local rows of the full inverse
-  parAlmond->invCoarseA = (dfloat *) calloc(A->Nrows*coarseTotal,sizeof(dfloat));
+  parAlmond->invCoarseA = (dfloat *) calloc((size_t)A->Nrows*coarseTotal,sizeof(dfloat));
   for (int n=0;n<N;n++) {
     for (int m=0;m<coarseTotal;m++) {
       parAlmond->invCoarseA[n*coarseTotal+m] = coarseA[(n+coarseOffset)*coarseTotal+m];
@@ -463,6 +619,11 @@ void setupExactSolve(parAlmond_t *parAlmond, agmgLevel *level, bool nullSpace, d
 
 void exactCoarseSolve(parAlmond_t *parAlmond, int N, dfloat *rhs, dfloat *x) {
 
+  if (parAlmond->coarseA != NULL) {
+    coarsePCGSolve(parAlmond, N, rhs, x);
+    return;
+  }
+
   //gather the full vector
   MPI_Allgatherv(rhs, N, MPI_DFLOAT, parAlmond->rhsCoarse, parAlmond->coarseCounts, parAlmond->coarseOffsets, MPI_DFLOAT, agmg::comm);
 
@@ -483,6 +644,13 @@ void device_exactCoarseSolve(parAlmond_t *parAlmond, int N, occa::memory o_rhs,
 
   //use coarse solver
   o_rhs.copyTo(rhs);
+
+  if (parAlmond->coarseA != NULL) {
+    coarsePCGSolve(parAlmond, N, rhs, x);
+    o_x.copyFrom(x);
+    return;
+  }
+
   //gather the full vector
   MPI_Allgatherv(rhs, N, MPI_DFLOAT, parAlmond->rhsCoarse, parAlmond->coarseCounts, parAlmond->coarseOffsets, MPI_DFLOAT, agmg::comm);
 
@@ -44,6 +44,11 @@ void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowSt
 
   // approximate Nrows at coarsest level
   int gCoarseSize = 1000;
+  options.getArgs("PARALMOND COARSE SIZE", gCoarseSize);
+
+  // move coarse levels onto fewer ranks below this many rows per rank (0 = never)
+  int agglomerationSize = 0;
+  options.getArgs("PARALMOND AGGLOMERATION SIZE", agglomerationSize);
 
   double seed = (double) rank;
   srand48(seed);
@@ -64,32 +69,10 @@ void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowSt
   levels[lev]->Nrows = A->Nrows;
   levels[lev]->Ncols = A->Ncols;
 
-  
-  SmoothType smoothType;
-  int ChebyshevIterations=2; //default to degree 2
-  if (options.compareArgs("PARALMOND SMOOTHER", "CHEBYSHEV")) {
-    smoothType = CHEBYSHEV;
-    options.getArgs("PARALMOND CHEBYSHEV DEGREE", ChebyshevIterations);
-  } else { //default to DAMPED_JACOBI
-    smoothType = DAMPED_JACOBI;
-  }
-  levels[lev]->ChebyshevIterations = ChebyshevIterations;
-
-  setupSmoother(parAlmond, levels[lev], smoothType);
-
-  levels[lev]->deviceA = newHYB(parAlmond, levels[lev]->A);
-
-  //set operator callback
-  void **args = (void **) calloc(2,sizeof(void*));
-  args[0] = (void *) parAlmond;
-  args[1] = (void *) levels[lev];
+  int ChebyshevIterations;
+  SmoothType smoothType = agmgSmoothType(options, &ChebyshevIterations);
 
-  levels[lev]->AxArgs = args;
-  levels[lev]->smoothArgs = args;
-  levels[lev]->Ax = agmgAx;
-  levels[lev]->smooth = agmgSmooth;
-  levels[lev]->device_Ax = device_agmgAx;
-  levels[lev]->device_smooth = device_agmgSmooth;
+  agmgSetupLevel(parAlmond, levels[lev], smoothType, ChebyshevIterations);
 
   //copy global partiton
   levels[lev]->globalRowStarts = (hlong *) calloc(size+1,sizeof(hlong));
@@ -103,7 +86,7 @@ void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowSt
   //if the system if already small, dont create MG levels
   bool done = false;
   if(globalSize <= gCoarseSize){
-    setupExactSolve(parAlmond, levels[lev],parAlmond->nullSpace,parAlmond->nullSpacePenalty);
+    setupCoarseSolve(parAlmond, levels[lev]);
     //setupSmoother(parAlmond, levels[lev], smoothType);
     done = true;
   }
@@ -126,41 +109,18 @@ void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowSt
     levels[lev+1]->Nrows = levels[lev+1]->A->Nrows;
     levels[lev+1]->Ncols = mymax(levels[lev+1]->A->Ncols, levels[lev+1]->P->Ncols);
     levels[lev+1]->globalRowStarts = levels[lev]->globalAggStarts;
-    
-    levels[lev+1]->ChebyshevIterations = ChebyshevIterations;
 
-    setupSmoother(parAlmond, levels[lev+1], smoothType);
+    if (agglomerationSize)
+      agmgAgglomerate(parAlmond, levels[lev+1], agglomerationSize);
 
-    levels[lev+1]->deviceA = newHYB (parAlmond, levels[lev+1]->A);
-    levels[lev+1]->deviceR = newHYB (parAlmond, levels[lev+1]->R);
-    levels[lev+1]->dcsrP   = newDCOO(parAlmond, levels[lev+1]->P);
-
-    //set operator callback
-    void **args = (void **) calloc(2,sizeof(void*));
-    args[0] = (void *) parAlmond;
-    args[1] = (void *) levels[lev+1];
-
-    levels[lev+1]->AxArgs = args;
-    levels[lev+1]->coarsenArgs = args;
-    levels[lev+1]->prolongateArgs = args;
-    levels[lev+1]->smoothArgs = args;
-
-    levels[lev+1]->Ax = agmgAx;
-    levels[lev+1]->coarsen = agmgCoarsen;
-    levels[lev+1]->prolongate = agmgProlongate;
-    levels[lev+1]->smooth = agmgSmooth;
-
-    levels[lev+1]->device_Ax = device_agmgAx;
-    levels[lev+1]->device_coarsen = device_agmgCoarsen;
-    levels[lev+1]->device_prolongate = device_agmgProlongate;
-    levels[lev+1]->device_smooth = device_agmgSmooth;
+    agmgSetupLevel(parAlmond, levels[lev+1], smoothType, ChebyshevIterations);
 
     const hlong localCoarseDim = (hlong) levels[lev+1]->A->Nrows;
     hlong globalCoarseSize;
     MPI_Allreduce(&localCoarseDim, &globalCoarseSize, 1, MPI_HLONG, MPI_SUM, agmg::comm);
 
     if(globalCoarseSize <= gCoarseSize || globalSize < 2*globalCoarseSize){
-      setupExactSolve(parAlmond, levels[lev+1],parAlmond->nullSpace,parAlmond->nullSpacePenalty);
+      setupCoarseSolve(parAlmond, levels[lev+1]);
       //setupSmoother(parAlmond, levels[lev+1], smoothType);
       break;
     }
@@ -169,33 +129,105 @@ void agmgSetup(parAlmond_t *parAlmond, csr *A, dfloat *nullA, hlong *globalRowSt
     lev++;
   } 
   
-  //allocate vectors required
+  agmgAllocateVectors(parAlmond);
+}
+
+SmoothType agmgSmoothType(setupAide options, int *ChebyshevIterations){
+
+  *ChebyshevIterations = 2; //default to degree 2
+  if (options.compareArgs("PARALMOND SMOOTHER", "CHEBYSHEV")) {
+    options.getArgs("PARALMOND CHEBYSHEV DEGREE", *ChebyshevIterations);
+    return CHEBYSHEV;
+  } else { //default to DAMPED_JACOBI
+    return DAMPED_JACOBI;
+  }
+}
+
+//set up smoothing, device operators and call-backs of a level whose A (and P,R if coarse) are built
+void agmgSetupLevel(parAlmond_t *parAlmond, agmgLevel *level, SmoothType smoothType, int ChebyshevIterations){
+
+  level->ChebyshevIterations = ChebyshevIterations;
+
+  setupSmoother(parAlmond, level, smoothType);
+
+  level->deviceA = newHYB(parAlmond, level->A);
+  if (level->P) {
+    level->deviceR = newHYB (parAlmond, level->R);
+    level->dcsrP   = newDCOO(parAlmond, level->P);
+  }
+
+  //set operator callback
+  void **args = (void **) calloc(2,sizeof(void*));
+  args[0] = (void *) parAlmond;
+  args[1] = (void *) level;
+
+  level->AxArgs = args;
+  level->smoothArgs = args;
+  level->Ax = agmgAx;
+  level->smooth = agmgSmooth;
+  level->device_Ax = device_agmgAx;
+  level->device_smooth = device_agmgSmooth;
+
+  if (level->P) {
+    level->coarsenArgs = args;
+    level->prolongateArgs = args;
+    level->coarsen = agmgCoarsen;
+    level->prolongate = agmgProlongate;
+    level->device_coarsen = device_agmgCoarsen;
+    level->device_prolongate = device_agmgProlongate;
+  }
+}
+
+//allocate the cycle vectors on all levels
+void agmgAllocateVectors(parAlmond_t *parAlmond){
+
+  agmgLevel **levels = parAlmond->levels;
+
   occa::device device = parAlmond->device;
+  bool anyFloat = false;
   for (int n=0;n<parAlmond->numLevels;n++) {
     dlong N = levels[n]->Nrows;
     dlong M = levels[n]->Ncols;
 
+    //the zeroed host vectors are big enough to initialize either precision
+    size_t entrySize = levels[n]->floatPrecision ? sizeof(float) : sizeof(dfloat);
+    anyFloat = anyFloat || levels[n]->floatPrecision;
+
     if ((n>0)&&(n<parAlmond->numLevels)) { //kcycle vectors
       if (M) levels[n]->ckp1 = (dfloat *) calloc(M,sizeof(dfloat));
       if (N) levels[n]->vkp1 = (dfloat *) calloc(N,sizeof(dfloat));
       if (N) levels[n]->wkp1 = (dfloat *) calloc(N,sizeof(dfloat));
 
-      if (M) levels[n]->o_ckp1 = device.malloc(M*sizeof(dfloat),levels[n]->ckp1);
-      if (N) levels[n]->o_vkp1 = device.malloc(N*sizeof(dfloat),levels[n]->vkp1);
-      if (N) levels[n]->o_wkp1 = device.malloc(N*sizeof(dfloat),levels[n]->wkp1);
+      if (M) levels[n]->o_ckp1 = device.malloc(M*entrySize,levels[n]->ckp1);
+      if (N) levels[n]->o_vkp1 = device.malloc(N*entrySize,levels[n]->vkp1);
+      if (N) levels[n]->o_wkp1 = device.malloc(N*entrySize,levels[n]->wkp1);
     }
     if (M) levels[n]->x    = (dfloat *) calloc(M,sizeof(dfloat));
     if (M) levels[n]->res  = (dfloat *) calloc(M,sizeof(dfloat));
     if (N) levels[n]->rhs  = (dfloat *) calloc(N,sizeof(dfloat));
 
-    if (M) levels[n]->o_x   = device.malloc(M*sizeof(dfloat),levels[n]->x);
-    if (M) levels[n]->o_res = device.malloc(M*sizeof(dfloat),levels[n]->res);
-    if (N) levels[n]->o_rhs = device.malloc(N*sizeof(dfloat),levels[n]->rhs);
+    if (M) levels[n]->o_x   = device.malloc(M*entrySize,levels[n]->x);
+    if (M) levels[n]->o_res = device.malloc(M*entrySize,levels[n]->res);
+    if (N) levels[n]->o_rhs = device.malloc(N*entrySize,levels[n]->rhs);
   }
   //buffer for innerproducts in kcycle
   dlong numBlocks = ((levels[0]->Nrows+RDIMX*RDIMY-1)/(RDIMX*RDIMY))/RLOAD;
   parAlmond->rho  = (dfloat*) calloc(3*numBlocks,sizeof(dfloat));
   parAlmond->o_rho  = device.malloc(3*numBlocks*sizeof(dfloat), parAlmond->rho); 
+
+  //fp32 view sharing the reduction buffers, for the vector ops on fp32 levels
+  if (anyFloat) {
+    parAlmond_t *floatAlmond = (parAlmond_t *) calloc(1,sizeof(parAlmond_t));
+    floatAlmond->mesh = parAlmond->mesh;
+    floatAlmond->device = parAlmond->device;
+    floatAlmond->floatPrecision = true;
+    floatAlmond->rho = parAlmond->rho;
+    floatAlmond->o_rho = parAlmond->o_rho;
+    floatAlmond->floatRho = (float*) calloc(3*numBlocks,sizeof(float));
+
+    buildAlmondFloatKernels(floatAlmond);
+    parAlmond->floatAlmond = floatAlmond;
+  }
 }
 
 void parAlmondReport(parAlmond_t *parAlmond) {
@@ -267,6 +299,14 @@ void parAlmondReport(parAlmond_t *parAlmond) {
   }
   if(rank==0)
     printf("---------------------------------------------------------------------\n");
+
+  for(int lev=0; lev<parAlmond->numLevels; lev++){
+    agmgLevel *level = parAlmond->levels[lev];
+    if ((rank==0)&&(level->gatherLevel==true)&&(level->agglomStride)) {
+      printf(" %3d | agglomerated over %d ranks, Ax time %g s -> %g s\n",
+             lev, level->agglomStride, level->agglomAxTime[0], level->agglomAxTime[1]);
+    }
+  }
 }
 
 
@@ -952,7 +992,7 @@ void find_aggregate_owners(agmgLevel *level, hlong* FineToCoarse, setupAide opti
 
   //determine a global numbering of the aggregates
   dlong *lNumAggs = (dlong*) calloc(size,sizeof(dlong));
-  MPI_Allgather(&numAggs, 1, MPI_DLONG, lNumAggs, 1, MPI_INT, agmg::comm);
+  MPI_Allgather(&numAggs, 1, MPI_DLONG, lNumAggs, 1, MPI_DLONG, agmg::comm);
 
   level->globalAggStarts[0] = 0;
   for (int r=0;r<size;r++)
@@ -26,12 +26,8 @@ SOFTWARE.
 
 #include "agmg.h"
 
-void buildAlmondKernels(parAlmond_t *parAlmond){
+static occa::properties almondKernelInfo(parAlmond_t *parAlmond, bool floatPrecision){
 
-  int rank, size;
-  rank = agmg::rank;
-  size = agmg::size;
-  
   occa::properties kernelInfo;
  kernelInfo["defines"].asObject();
  kernelInfo["includes"].asArray();
@@ -49,14 +45,14 @@ void buildAlmondKernels(parAlmond_t *parAlmond){
     kernelInfo["defines/" "dlong"]="long long int";
   }
 
-  if(sizeof(dfloat) == sizeof(double)){
-    kernelInfo["defines/" "dfloat"]= "double";
-    kernelInfo["defines/" "dfloat4"]= "double4";
-  }
-  else if(sizeof(dfloat) == sizeof(float)){
+  if(floatPrecision || sizeof(dfloat) == sizeof(float)){
     kernelInfo["defines/" "dfloat"]= "float";
     kernelInfo["defines/" "dfloat4"]= "float4";
   }
+  else if(sizeof(dfloat) == sizeof(double)){
+    kernelInfo["defines/" "dfloat"]= "double";
+    kernelInfo["defines/" "dfloat4"]= "double4";
+  }
 
   kernelInfo["defines/" "p_RDIMX"]= RDIMX;
   kernelInfo["defines/" "p_RDIMY"]= RDIMY;
@@ -76,10 +72,19 @@ void buildAlmondKernels(parAlmond_t *parAlmond){
     kernelInfo["compiler_flags"] += "--fmad=true"; // compiler option for cuda
   }
 
-  if (rank==0) printf("Compiling parALMOND Kernels \n");
+  return kernelInfo;
+}
+
+void buildAlmondKernels(parAlmond_t *parAlmond){
 
-  for (int r=0;r<size;r++) {
-    if (r==rank) {
+  mesh_t *mesh = parAlmond->mesh;
+
+  occa::properties kernelInfo = almondKernelInfo(parAlmond, false);
+
+  if (agmg::rank==0) printf("Compiling parALMOND Kernels \n");
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
       parAlmond->ellAXPYKernel = parAlmond->device.buildKernel(DPWD "/okl/ellAXPY.okl",
            "ellAXPY", kernelInfo);
 
@@ -143,6 +148,46 @@ void buildAlmondKernels(parAlmond_t *parAlmond){
       parAlmond->kcycleWeightedCombinedOp2Kernel = parAlmond->device.buildKernel(DPWD "/okl/kcycleCombinedOp.okl",
                  "kcycleWeightedCombinedOp2Kernel", kernelInfo);
     }
-    MPI_Barrier(agmg::comm);
+    occaKernelBuildDone(mesh, r);
+  }
+}
+
+// fp32 builds of the vector kernels used by the k-cycle on fp32 levels
+void buildAlmondFloatKernels(parAlmond_t *floatAlmond){
+
+  mesh_t *mesh = floatAlmond->mesh;
+
+  occa::properties kernelInfo = almondKernelInfo(floatAlmond, true);
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      floatAlmond->scaleVectorKernel = floatAlmond->device.buildKernel(DPWD "/okl/scaleVector.okl",
+             "scaleVectorKernel", kernelInfo);
+
+      floatAlmond->vectorAddKernel = floatAlmond->device.buildKernel(DPWD "/okl/vectorAdd.okl",
+             "vectorAddKernel", kernelInfo);
+
+      floatAlmond->vectorAddKernel2 = floatAlmond->device.buildKernel(DPWD "/okl/vectorAdd.okl",
+              "vectorAddKernel2", kernelInfo);
+
+      floatAlmond->vectorAddInnerProdKernel = floatAlmond->device.buildKernel(DPWD "/okl/vectorAddInnerProduct.okl",
+                 "vectorAddInnerProductKernel", kernelInfo);
+
+      floatAlmond->kcycleCombinedOp1Kernel = floatAlmond->device.buildKernel(DPWD "/okl/kcycleCombinedOp.okl",
+                 "kcycleCombinedOp1Kernel", kernelInfo);
+
+      floatAlmond->kcycleCombinedOp2Kernel = floatAlmond->device.buildKernel(DPWD "/okl/kcycleCombinedOp.okl",
+                 "kcycleCombinedOp2Kernel", kernelInfo);
+
+      floatAlmond->vectorAddWeightedInnerProdKernel = floatAlmond->device.buildKernel(DPWD "/okl/vectorAddInnerProduct.okl",
+                 "vectorAddWeightedInnerProductKernel", kernelInfo);
+
+      floatAlmond->kcycleWeightedCombinedOp1Kernel = floatAlmond->device.buildKernel(DPWD "/okl/kcycleCombinedOp.okl",
+                 "kcycleWeightedCombinedOp1Kernel", kernelInfo);
+
+      floatAlmond->kcycleWeightedCombinedOp2Kernel = floatAlmond->device.buildKernel(DPWD "/okl/kcycleCombinedOp.okl",
+                 "kcycleWeightedCombinedOp2Kernel", kernelInfo);
+    }
+    occaKernelBuildDone(mesh, r);
   }
 }
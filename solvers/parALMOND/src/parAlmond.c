@@ -69,7 +69,7 @@ void parAlmondPrecon(parAlmond_t *parAlmond, occa::memory o_x, occa::memory o_rh
   if (baseLevel->gatherLevel==true) {// scatter solution
     baseLevel->device_scatter(baseLevel->scatterArgs, baseLevel->o_x, o_x);
   } else {
-    baseLevel->o_x.copyTo(o_x,baseLevel->Nrows*sizeof(dfloat));
+    baseLevel->o_x.copyTo(o_x,baseLevel->Nrows*(baseLevel->floatPrecision ? sizeof(float) : sizeof(dfloat)));
   }
 }
 
@@ -77,6 +77,7 @@ parAlmond_t *parAlmondInit(mesh_t *mesh, setupAide options) {
 
   parAlmond_t *parAlmond = (parAlmond_t *) calloc(1,sizeof(parAlmond_t));
 
+  parAlmond->mesh = mesh;
   parAlmond->device = mesh->device;
   parAlmond->defaultStream = mesh->defaultStream;
   parAlmond->dataStream = mesh->dataStream;
@@ -118,17 +119,41 @@ void parAlmondAgmgSetup(parAlmond_t *parAlmond,
 
   if(rank==0) printf("Setting up AMG...");fflush(stdout);
 
-  csr *A = newCSRfromCOO(numLocalRows,globalRowStarts,nnz, Ai, Aj, Avals);
-
   //record if there is null space
   parAlmond->nullSpace = nullSpace;
   parAlmond->nullSpacePenalty = nullSpacePenalty;
 
+  //reuse a hierarchy saved by an earlier run with the same operator
+  string hierarchyFile;
+  char fileName[BUFSIZ];
+  unsigned long long key = 0;
+  bool saveHierarchy = false;
+  if (parAlmond->options.getArgs("PARALMOND HIERARCHY FILE", hierarchyFile)) {
+    key = agmgHierarchyKey(parAlmond, globalRowStarts, nnz, Ai, Aj, Avals);
+    sprintf(fileName, "%s_%016llx_%04d.amg", (char*)hierarchyFile.c_str(), key, rank);
+
+    if (agmgHierarchyLoad(parAlmond, fileName, key)) {
+      if(rank==0) printf("loaded from %s_%016llx_*.amg\n", (char*)hierarchyFile.c_str(), key);
+
+      if (parAlmond->options.compareArgs("VERBOSE","TRUE"))
+        parAlmondReport(parAlmond);
+      return;
+    }
+    saveHierarchy = true;
+  }
+
+  int startLevel = parAlmond->numLevels;
+
+  csr *A = newCSRfromCOO(numLocalRows,globalRowStarts,nnz, Ai, Aj, Avals);
+
   //populate null space vector
   dfloat *nullA = (dfloat *) calloc(numLocalRows, sizeof(dfloat));
   for (dlong i=0;i<numLocalRows;i++) nullA[i] = 1/sqrt(TotalRows);
 
   agmgSetup(parAlmond, A, nullA, globalRowStarts, parAlmond->options);
+
+  if (saveHierarchy)
+    agmgHierarchySave(parAlmond, startLevel, fileName, key);
   
   if(rank==0) printf("done.\n");
 
@@ -136,8 +161,21 @@ void parAlmondAgmgSetup(parAlmond_t *parAlmond,
     parAlmondReport(parAlmond);
 }
 
-//TODO code this
+//TODO free the rest of the hierarchy
 int parAlmondFree(void* A) {
+
+  parAlmond_t *parAlmond = (parAlmond_t *) A;
+
+  //group communicators and buffers of the agglomerated levels
+  for (int n=0;n<parAlmond->numLevels;n++) {
+    agmgLevel *level = parAlmond->levels[n];
+    if (!level->agglomStride) continue;
+
+    MPI_Comm_free(&level->agglomComm);
+    free(level->agglomCounts);
+    free(level->agglomOffsets);
+  }
+
   return 0;
 }
 
@@ -192,8 +192,23 @@ dfloat maxEntry(dlong n, dfloat *a){
 
 
 
+// copy N block partial sums to parAlmond->rho, widening fp32 partials
+static void copyPartialSums(parAlmond_t *parAlmond, dlong N){
+  if (parAlmond->floatPrecision) {
+    parAlmond->o_rho.copyTo(parAlmond->floatRho,N*sizeof(float),0);
+    for (dlong i=0; i<N; i++) parAlmond->rho[i] = parAlmond->floatRho[i];
+  } else {
+    parAlmond->o_rho.copyTo(parAlmond->rho,N*sizeof(dfloat),0);
+  }
+}
+
 void scaleVector(parAlmond_t *parAlmond, dlong N, occa::memory o_a, dfloat alpha){
-  if (N) parAlmond->scaleVectorKernel(N, alpha, o_a);
+  if (N) {
+    if (parAlmond->floatPrecision)
+      parAlmond->scaleVectorKernel(N, (float) alpha, o_a);
+    else
+      parAlmond->scaleVectorKernel(N, alpha, o_a);
+  }
 }
 
 void setVector(parAlmond_t *parAlmond, dlong N, occa::memory o_a, dfloat alpha){
@@ -205,7 +220,7 @@ dfloat sumVector(parAlmond_t *parAlmond, dlong N, occa::memory o_a){
   if(!numBlocks) numBlocks = 1;
 
   if (N) parAlmond->sumVectorKernel(numBlocks,N,o_a,parAlmond->o_rho);
-  parAlmond->o_rho.copyTo(parAlmond->rho,numBlocks*sizeof(dfloat),0);
+  copyPartialSums(parAlmond, numBlocks);
   
   dfloat alpha =0.;
   #pragma omp parallel for reduction(+:alpha)
@@ -236,7 +251,7 @@ dfloat innerProd(parAlmond_t *parAlmond, dlong N,
   if(!numBlocks) numBlocks = 1;
 
   parAlmond->innerProdKernel(numBlocks,N,o_x,o_y,parAlmond->o_rho);
-  parAlmond->o_rho.copyTo(parAlmond->rho,numBlocks*sizeof(dfloat),0);
+  copyPartialSums(parAlmond, numBlocks);
   
   dfloat result =0.;
   #pragma omp parallel for reduction(+:result)
@@ -259,7 +274,7 @@ void kcycleCombinedOp1(parAlmond_t *parAlmond, dlong N, dfloat *aDotbc,
   } else {
     parAlmond->kcycleCombinedOp1Kernel(numBlocks,N,o_a,o_b,o_c,parAlmond->o_rho);
   }
-  parAlmond->o_rho.copyTo(parAlmond->rho,3*numBlocks*sizeof(dfloat),0);
+  copyPartialSums(parAlmond, 3*numBlocks);
   
   dfloat aDotb = 0., aDotc = 0., bDotb = 0.;
   #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:bDotb)
@@ -288,7 +303,7 @@ void kcycleCombinedOp2(parAlmond_t *parAlmond, dlong N, dfloat *aDotbcd,
   } else {
     parAlmond->kcycleCombinedOp2Kernel(numBlocks,N,o_a,o_b,o_c,o_d,parAlmond->o_rho);
   }
-  parAlmond->o_rho.copyTo(parAlmond->rho,3*numBlocks*sizeof(dfloat),0);
+  copyPartialSums(parAlmond, 3*numBlocks);
   
   dfloat aDotb = 0., aDotc = 0., aDotd = 0.;
   #pragma omp parallel for reduction(+:aDotb) reduction(+:aDotc) reduction(+:aDotd)
@@ -310,12 +325,20 @@ dfloat vectorAddInnerProd(parAlmond_t *parAlmond, dlong N, dfloat alpha, occa::m
   dlong numBlocks = ((N+RDIMX*RDIMY-1)/(RDIMX*RDIMY))/RLOAD;
   if(!numBlocks) numBlocks = 1;
 
-  if (weighted) {
-    parAlmond->vectorAddWeightedInnerProdKernel(numBlocks,N,alpha,beta,o_x,o_y,o_w,parAlmond->o_rho);
+  if (parAlmond->floatPrecision) {
+    if (weighted) {
+      parAlmond->vectorAddWeightedInnerProdKernel(numBlocks,N,(float)alpha,(float)beta,o_x,o_y,o_w,parAlmond->o_rho);
+    } else {
+      parAlmond->vectorAddInnerProdKernel(numBlocks,N,(float)alpha,(float)beta,o_x,o_y,parAlmond->o_rho);
+    }
   } else {
-    parAlmond->vectorAddInnerProdKernel(numBlocks,N,alpha,beta,o_x,o_y,parAlmond->o_rho);
+    if (weighted) {
+      parAlmond->vectorAddWeightedInnerProdKernel(numBlocks,N,alpha,beta,o_x,o_y,o_w,parAlmond->o_rho);
+    } else {
+      parAlmond->vectorAddInnerProdKernel(numBlocks,N,alpha,beta,o_x,o_y,parAlmond->o_rho);
+    }
   }
-  parAlmond->o_rho.copyTo(parAlmond->rho,numBlocks*sizeof(dfloat),0);
+  copyPartialSums(parAlmond, numBlocks);
   
   dfloat result =0.;
   #pragma omp parallel for reduction(+:result)
@@ -328,10 +351,16 @@ dfloat vectorAddInnerProd(parAlmond_t *parAlmond, dlong N, dfloat alpha, occa::m
 
 
 void vectorAdd(parAlmond_t *parAlmond, dlong N, dfloat alpha, occa::memory o_x, dfloat beta, occa::memory o_y){
-  parAlmond->vectorAddKernel(N, alpha, beta, o_x, o_y);
+  if (parAlmond->floatPrecision)
+    parAlmond->vectorAddKernel(N, (float) alpha, (float) beta, o_x, o_y);
+  else
+    parAlmond->vectorAddKernel(N, alpha, beta, o_x, o_y);
 }
 
 void vectorAdd(parAlmond_t *parAlmond, dlong N, dfloat alpha, occa::memory o_x,
 	 dfloat beta, occa::memory o_y, occa::memory o_z){
-  parAlmond->vectorAddKernel2(N, alpha, beta, o_x, o_y, o_z);
+  if (parAlmond->floatPrecision)
+    parAlmond->vectorAddKernel2(N, (float) alpha, (float) beta, o_x, o_y, o_z);
+  else
+    parAlmond->vectorAddKernel2(N, alpha, beta, o_x, o_y, o_z);
 }
@@ -0,0 +1,149 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "mesh2D.h"
+#include "mesh3D.h"
+#include "meshBoundaryIntegral.h"
+
+// reference weights of the face nodes of a simplex: column sums of MM*LIFT,
+// which are the row sums of the face mass matrices
+static dfloat *meshSimplexFaceWeights(mesh_t *mesh){
+
+  int NfpNfaces = mesh->Nfp*mesh->Nfaces;
+  dfloat *w = (dfloat*) calloc(NfpNfaces, sizeof(dfloat));
+
+  for(int j=0;j<NfpNfaces;++j){
+    for(int k=0;k<mesh->Np;++k){
+      dfloat MMk = 0;
+      for(int i=0;i<mesh->Np;++i)
+        MMk += mesh->MM[i*mesh->Np+k];
+      w[j] += MMk*mesh->LIFT[k*NfpNfaces+j];
+    }
+  }
+
+  return w;
+}
+
+meshBoundaryIntegral_t *meshBoundaryIntegralSetup(mesh_t *mesh, int Ntags, const int *tags,
+                                                  int Ncomponents, occa::properties &kernelInfo){
+
+  meshBoundaryIntegral_t *bi = (meshBoundaryIntegral_t *) calloc(1, sizeof(meshBoundaryIntegral_t));
+
+  bi->mesh = mesh;
+  bi->Ntags = Ntags;
+  bi->Ncomponents = Ncomponents;
+  bi->tags = (int*) calloc(Ntags+1, sizeof(int));
+  for(int t=0;t<Ntags;++t) bi->tags[t] = tags[t];
+
+  // list local faces tag by tag
+  bi->tagStarts = (dlong*) calloc(Ntags+1, sizeof(dlong));
+  for(int t=0;t<Ntags;++t){
+    bi->tagStarts[t] = bi->Nfaces;
+    for(dlong e=0;e<mesh->Nelements;++e)
+      for(int f=0;f<mesh->Nfaces;++f)
+        if(mesh->EToB[e*mesh->Nfaces+f]==tags[t]) ++bi->Nfaces;
+  }
+  bi->tagStarts[Ntags] = bi->Nfaces;
+
+  bi->faceElements = (dlong*) calloc(bi->Nfaces+1, sizeof(dlong));
+  bi->faceIds      = (int*)   calloc(bi->Nfaces+1, sizeof(int));
+
+  dlong cnt = 0;
+  for(int t=0;t<Ntags;++t){
+    for(dlong e=0;e<mesh->Nelements;++e){
+      for(int f=0;f<mesh->Nfaces;++f){
+        if(mesh->EToB[e*mesh->Nfaces+f]==tags[t]){
+          bi->faceElements[cnt] = e;
+          bi->faceIds[cnt] = f;
+          ++cnt;
+        }
+      }
+    }
+  }
+
+  // surface quadrature weights: simplices keep one surface Jacobian per face,
+  // quads and hexes store the weighted Jacobian of every face node
+  int simplex = (mesh->Nverts==mesh->dim+1);
+  dfloat *wref = simplex ? meshSimplexFaceWeights(mesh) : NULL;
+
+  dfloat *wsJ = (dfloat*) calloc(bi->Nfaces*mesh->Nfp+1, sizeof(dfloat));
+  for(dlong face=0;face<bi->Nfaces;++face){
+    const dlong e = bi->faceElements[face];
+    const int f = bi->faceIds[face];
+    for(int m=0;m<mesh->Nfp;++m){
+      if(simplex){
+        const dlong sid = mesh->Nsgeo*(e*mesh->Nfaces+f);
+        wsJ[face*mesh->Nfp+m] = wref[f*mesh->Nfp+m]*mesh->sgeo[sid+SJID];
+      } else {
+        const dlong sid = mesh->Nsgeo*(mesh->Nfaces*mesh->Nfp*e + f*mesh->Nfp + m);
+        wsJ[face*mesh->Nfp+m] = mesh->sgeo[sid+WSJID];
+      }
+    }
+  }
+
+  bi->o_tagStarts    = mesh->device.malloc((Ntags+1)*sizeof(dlong), bi->tagStarts);
+  bi->o_faceElements = mesh->device.malloc((bi->Nfaces+1)*sizeof(dlong), bi->faceElements);
+  bi->o_faceIds      = mesh->device.malloc((bi->Nfaces+1)*sizeof(int), bi->faceIds);
+  bi->o_wsJ          = mesh->device.malloc((bi->Nfaces*mesh->Nfp+1)*sizeof(dfloat), wsJ);
+  bi->o_traction     = mesh->device.malloc((bi->Nfaces*mesh->Nfp*Ncomponents+1)*sizeof(dfloat));
+  bi->o_integrals    = mesh->device.malloc((Ntags*Ncomponents+1)*sizeof(dfloat));
+
+  bi->localIntegrals = (dfloat*) calloc(Ntags*Ncomponents+1, sizeof(dfloat));
+  bi->integrals      = (dfloat*) calloc(Ntags*Ncomponents+1, sizeof(dfloat));
+
+  free(wsJ);
+  if(wref) free(wref);
+
+  occa::properties integralInfo = kernelInfo;
+  integralInfo["defines/" "p_Ncomponents"]= Ncomponents;
+  integralInfo["defines/" "p_blockSize"]= 256;
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      bi->integrateKernel = mesh->device.buildKernel(DHOLMES "/okl/meshBoundaryIntegral.okl",
+                                                     "meshBoundaryIntegral", integralInfo);
+    }
+    occaKernelBuildDone(mesh, r);
+  }
+
+  return bi;
+}
+
+void meshBoundaryIntegral(meshBoundaryIntegral_t *bi){
+
+  mesh_t *mesh = bi->mesh;
+  int Nintegrals = bi->Ntags*bi->Ncomponents;
+
+  if(bi->Ntags){
+    bi->integrateKernel(bi->Ntags, bi->o_tagStarts, bi->o_wsJ, bi->o_traction, bi->o_integrals);
+    bi->o_integrals.copyTo(bi->localIntegrals, Nintegrals*sizeof(dfloat));
+  }
+
+  MPI_Allreduce(bi->localIntegrals, bi->integrals, Nintegrals, MPI_DFLOAT, MPI_SUM, mesh->comm);
+}
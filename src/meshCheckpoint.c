@@ -0,0 +1,420 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "meshCheckpoint.h"
+
+static const char meshCheckpointMagic[8] = "LPCKPT1";
+
+typedef struct {
+  hlong v[8];   // sorted global vertex ids
+  int rank;     // owner, -1 for padding
+  dlong e;
+} checkpointElement_t;
+
+typedef struct {
+  dlong e;
+  hlong id;
+} checkpointId_t;
+
+// padding sorts after every element
+static int compareCheckpointElements(const void *a, const void *b){
+  const checkpointElement_t *ea = (const checkpointElement_t*) a;
+  const checkpointElement_t *eb = (const checkpointElement_t*) b;
+
+  if(ea->rank<0 || eb->rank<0) return (ea->rank<0) - (eb->rank<0);
+
+  for(int n=0;n<8;++n){
+    if(ea->v[n] < eb->v[n]) return -1;
+    if(ea->v[n] > eb->v[n]) return +1;
+  }
+  return 0;
+}
+
+static int compareCheckpointIds(const void *a, const void *b){
+  const checkpointId_t *ia = (const checkpointId_t*) a;
+  const checkpointId_t *ib = (const checkpointId_t*) b;
+
+  if(ia->id < ib->id) return -1;
+  if(ia->id > ib->id) return +1;
+  return 0;
+}
+
+static void matchCheckpointElements(void *a, void *b){ }
+
+// number elements by their sorted vertex ids so the numbering does not
+// depend on the partition
+static void meshCheckpointGlobalIds(meshCheckpoint_t *cp){
+
+  mesh_t *mesh = cp->mesh;
+
+  dlong maxNelements = 0;
+  MPI_Allreduce(&(mesh->Nelements), &maxNelements, 1, MPI_DLONG, MPI_MAX, mesh->comm);
+
+  hlong localNelements = mesh->Nelements;
+  MPI_Allreduce(&localNelements, &(cp->Nelements), 1, MPI_HLONG, MPI_SUM, mesh->comm);
+
+  checkpointElement_t *elements =
+    (checkpointElement_t*) calloc(maxNelements+1, sizeof(checkpointElement_t));
+
+  for(dlong e=0;e<maxNelements;++e){
+    elements[e].rank = -1;
+    if(e<mesh->Nelements){
+      hlong *v = elements[e].v;
+      for(int n=0;n<mesh->Nverts;++n)
+        v[n] = mesh->EToV[e*mesh->Nverts+n];
+
+      // insertion sort of the element vertices
+      for(int n=1;n<mesh->Nverts;++n)
+        for(int m=n;m>0 && v[m]<v[m-1];--m){
+          hlong tmp = v[m]; v[m] = v[m-1]; v[m-1] = tmp;
+        }
+
+      elements[e].rank = mesh->rank;
+      elements[e].e = e;
+    }
+  }
+
+  parallelSort(mesh->size, mesh->rank, mesh->comm, maxNelements, elements,
+               sizeof(checkpointElement_t), compareCheckpointElements, matchCheckpointElements);
+
+  // padding sorts last, so entry n on this rank has global number rank*maxNelements+n
+  int *sendCounts = (int*) calloc(mesh->size, sizeof(int));
+  int *recvCounts = (int*) calloc(mesh->size, sizeof(int));
+  int *sendOffsets = (int*) calloc(mesh->size+1, sizeof(int));
+  int *recvOffsets = (int*) calloc(mesh->size+1, sizeof(int));
+
+  for(dlong n=0;n<maxNelements;++n)
+    if(elements[n].rank>=0)
+      sendCounts[elements[n].rank] += sizeof(checkpointId_t);
+
+  MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, mesh->comm);
+
+  for(int r=0;r<mesh->size;++r){
+    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r];
+    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+  }
+
+  checkpointId_t *sendIds = (checkpointId_t*) calloc(maxNelements+1, sizeof(checkpointId_t));
+  checkpointId_t *recvIds = (checkpointId_t*) calloc(mesh->Nelements+1, sizeof(checkpointId_t));
+
+  int *cnt = (int*) calloc(mesh->size, sizeof(int));
+  for(dlong n=0;n<maxNelements;++n){
+    const int r = elements[n].rank;
+    if(r>=0){
+      checkpointId_t *id = sendIds + (sendOffsets[r]/sizeof(checkpointId_t)) + cnt[r]++;
+      id->e  = elements[n].e;
+      id->id = ((hlong) mesh->rank)*maxNelements + n;
+    }
+  }
+
+  MPI_Alltoallv(sendIds, sendCounts, sendOffsets, MPI_CHAR,
+                recvIds, recvCounts, recvOffsets, MPI_CHAR, mesh->comm);
+
+  cp->globalIds = (hlong*) calloc(mesh->Nelements+1, sizeof(hlong));
+  for(dlong n=0;n<mesh->Nelements;++n)
+    cp->globalIds[recvIds[n].e] = recvIds[n].id;
+
+  // file views need increasing displacements
+  qsort(recvIds, mesh->Nelements, sizeof(checkpointId_t), compareCheckpointIds);
+
+  cp->order = (dlong*) calloc(mesh->Nelements+1, sizeof(dlong));
+  for(dlong n=0;n<mesh->Nelements;++n)
+    cp->order[n] = recvIds[n].e;
+
+  free(elements);
+  free(sendIds); free(recvIds);
+  free(sendCounts); free(recvCounts);
+  free(sendOffsets); free(recvOffsets);
+  free(cnt);
+}
+
+meshCheckpoint_t *meshCheckpointSetup(mesh_t *mesh){
+
+  meshCheckpoint_t *cp = (meshCheckpoint_t*) calloc(1, sizeof(meshCheckpoint_t));
+
+  cp->mesh = mesh;
+  MPI_Comm_dup(mesh->comm, &(cp->comm));
+
+  int provided;
+  MPI_Query_thread(&provided);
+  cp->threaded = (provided==MPI_THREAD_MULTIPLE);
+
+  if(mesh->rank==0 && !cp->threaded)
+    printf("meshCheckpointSetup: MPI is not thread multiple, checkpoints will be written synchronously\n");
+
+  meshCheckpointGlobalIds(cp);
+
+  return cp;
+}
+
+// one record type per element, placed at the element's global number
+static void meshCheckpointView(meshCheckpoint_t *cp, MPI_File fh, MPI_Datatype *record, MPI_Datatype *filetype){
+
+  mesh_t *mesh = cp->mesh;
+
+  // byte displacements, so files with more than 2^31 values stay addressable
+  MPI_Aint recordBytes = ((MPI_Aint) cp->header.Nvalues)*sizeof(dfloat);
+
+  MPI_Aint *displs = (MPI_Aint*) calloc(mesh->Nelements+1, sizeof(MPI_Aint));
+  for(dlong n=0;n<mesh->Nelements;++n)
+    displs[n] = ((MPI_Aint) cp->globalIds[cp->order[n]])*recordBytes;
+
+  MPI_Type_contiguous(cp->header.Nvalues, MPI_DFLOAT, record);
+  MPI_Type_commit(record);
+
+  MPI_Type_create_hindexed_block(mesh->Nelements, 1, displs, *record, filetype);
+  MPI_Type_commit(filetype);
+
+  char native[] = "native";
+  MPI_File_set_view(fh, sizeof(meshCheckpointHeader_t), *record, *filetype, native, MPI_INFO_NULL);
+
+  free(displs);
+}
+
+static void *meshCheckpointWriteThread(void *args){
+
+  meshCheckpoint_t *cp = (meshCheckpoint_t*) args;
+  mesh_t *mesh = cp->mesh;
+
+  const int Np = mesh->Np;
+  const int Nvalues = cp->header.Nvalues;
+
+  // pack the staged fields into element records
+  for(dlong n=0;n<mesh->Nelements;++n){
+    const dlong e = cp->order[n];
+    dfloat *record = cp->records + n*Nvalues;
+
+    for(int f=0;f<cp->Nfields;++f){
+      meshCheckpointField_t *field = cp->fields+f;
+      const dlong row = (field->rows) ? field->rows[e] : e;
+
+      for(int b=0;b<field->Nblocks;++b){
+        for(int i=0;i<Np;++i)
+          record[i] = (row>=0) ? field->staging[row*field->elementStride + b*field->blockStride + i] : 0.;
+        record += Np;
+      }
+    }
+  }
+
+  MPI_File fh;
+  char *fileName = cp->fileName;
+  if(MPI_File_open(cp->comm, fileName, MPI_MODE_WRONLY|MPI_MODE_CREATE, MPI_INFO_NULL, &fh)!=MPI_SUCCESS){
+    if(mesh->rank==0) printf("meshCheckpointWrite: could not open %s\n", cp->fileName);
+    return NULL;
+  }
+  MPI_File_set_size(fh, 0);
+
+  if(mesh->rank==0)
+    MPI_File_write_at(fh, 0, &(cp->header), sizeof(meshCheckpointHeader_t), MPI_CHAR, MPI_STATUS_IGNORE);
+
+  MPI_Datatype record, filetype;
+  meshCheckpointView(cp, fh, &record, &filetype);
+
+  MPI_File_write_all(fh, cp->records, mesh->Nelements, record, MPI_STATUS_IGNORE);
+
+  MPI_File_close(&fh);
+  MPI_Type_free(&record);
+  MPI_Type_free(&filetype);
+
+  return NULL;
+}
+
+void meshCheckpointBegin(meshCheckpoint_t *cp, const char *fileName, dfloat time, dfloat dt, int frame){
+
+  mesh_t *mesh = cp->mesh;
+
+  // the staging buffers are reused
+  meshCheckpointFinish(cp);
+
+  strcpy(cp->fileName, fileName);
+  cp->Nfields = 0;
+
+  meshCheckpointHeader_t *header = &(cp->header);
+  memcpy(header->magic, meshCheckpointMagic, sizeof(header->magic));
+  header->dim = mesh->dim;
+  header->Np = mesh->Np;
+  header->dfloatSize = sizeof(dfloat);
+  header->Nvalues = 0;
+  header->Nelements = cp->Nelements;
+  header->time = time;
+  header->dt = dt;
+  header->frame = frame;
+}
+
+static size_t meshCheckpointFieldBytes(mesh_t *mesh, int Nblocks, dlong blockStride, dlong elementStride, dlong Nrows){
+  if(Nrows==0 || Nblocks==0) return 0;
+  return ((Nrows-1)*elementStride + (Nblocks-1)*blockStride + mesh->Np)*sizeof(dfloat);
+}
+
+void meshCheckpointAddField(meshCheckpoint_t *cp, occa::memory &o_q, int Nblocks,
+                            dlong blockStride, dlong elementStride, dlong Nrows, dlong *rows){
+
+  mesh_t *mesh = cp->mesh;
+
+  if(cp->Nfields==MESH_CHECKPOINT_MAX_FIELDS){
+    if(mesh->rank==0) printf("meshCheckpointAddField: too many fields\n");
+    return;
+  }
+
+  meshCheckpointField_t *field = cp->fields + cp->Nfields++;
+
+  field->Nblocks = Nblocks;
+  field->blockStride = blockStride;
+  field->elementStride = elementStride;
+
+  if(rows){
+    if(!field->rows) field->rows = (dlong*) calloc(mesh->Nelements+1, sizeof(dlong));
+    memcpy(field->rows, rows, mesh->Nelements*sizeof(dlong));
+  } else if(field->rows){
+    free(field->rows);
+    field->rows = NULL;
+  }
+
+  const size_t bytes = meshCheckpointFieldBytes(mesh, Nblocks, blockStride, elementStride, Nrows);
+  if(bytes>field->bytes){
+    if(field->bytes) field->o_staging.free();
+    field->staging = (dfloat*) occaHostMallocPinned(mesh->device, bytes, NULL, field->o_staging);
+    field->bytes = bytes;
+  }
+
+  if(bytes) o_q.copyTo(field->staging, bytes);
+
+  cp->header.Nvalues += Nblocks*mesh->Np;
+}
+
+void meshCheckpointWrite(meshCheckpoint_t *cp){
+
+  mesh_t *mesh = cp->mesh;
+
+  free(cp->records);
+  cp->records = (dfloat*) calloc(mesh->Nelements*cp->header.Nvalues+1, sizeof(dfloat));
+
+  if(!cp->threaded || pthread_create(&(cp->thread), NULL, meshCheckpointWriteThread, cp)){
+    meshCheckpointWriteThread(cp);
+    return;
+  }
+  cp->writing = 1;
+}
+
+void meshCheckpointFinish(meshCheckpoint_t *cp){
+
+  if(cp->writing){
+    pthread_join(cp->thread, NULL);
+    cp->writing = 0;
+  }
+}
+
+int meshCheckpointReadBegin(meshCheckpoint_t *cp, const char *fileName, dfloat *time, dfloat *dt, int *frame){
+
+  mesh_t *mesh = cp->mesh;
+
+  meshCheckpointFinish(cp);
+
+  MPI_File fh;
+  char *name = (char*) fileName;
+  if(MPI_File_open(cp->comm, name, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh)!=MPI_SUCCESS)
+    return 0;
+
+  meshCheckpointHeader_t *header = &(cp->header);
+  MPI_File_read_at_all(fh, 0, header, sizeof(meshCheckpointHeader_t), MPI_CHAR, MPI_STATUS_IGNORE);
+
+  if(memcmp(header->magic, meshCheckpointMagic, sizeof(header->magic)) ||
+     header->dim!=mesh->dim || header->Np!=mesh->Np ||
+     header->dfloatSize!=(int)sizeof(dfloat) || header->Nelements!=cp->Nelements){
+    if(mesh->rank==0) printf("meshCheckpointReadBegin: %s does not match this mesh\n", fileName);
+    MPI_File_close(&fh);
+    return 0;
+  }
+
+  free(cp->records);
+  cp->records = (dfloat*) calloc(mesh->Nelements*header->Nvalues+1, sizeof(dfloat));
+  cp->recordOffset = 0;
+
+  MPI_Datatype record, filetype;
+  meshCheckpointView(cp, fh, &record, &filetype);
+
+  MPI_File_read_all(fh, cp->records, mesh->Nelements, record, MPI_STATUS_IGNORE);
+
+  MPI_File_close(&fh);
+  MPI_Type_free(&record);
+  MPI_Type_free(&filetype);
+
+  *time  = header->time;
+  *dt    = header->dt;
+  *frame = header->frame;
+
+  return 1;
+}
+
+void meshCheckpointReadField(meshCheckpoint_t *cp, occa::memory &o_q, int Nblocks,
+                             dlong blockStride, dlong elementStride, dlong Nrows, dlong *rows){
+
+  mesh_t *mesh = cp->mesh;
+
+  const int Np = mesh->Np;
+  const int Nvalues = cp->header.Nvalues;
+
+  if(cp->recordOffset + Nblocks*Np > Nvalues){
+    if(mesh->rank==0) printf("meshCheckpointReadField: record holds only %d values\n", Nvalues);
+    return;
+  }
+
+  // patch the rows into a copy of the device extent
+  const size_t bytes = meshCheckpointFieldBytes(mesh, Nblocks, blockStride, elementStride, Nrows);
+  dfloat *q = (dfloat*) calloc(bytes/sizeof(dfloat)+1, sizeof(dfloat));
+  if(bytes) o_q.copyTo(q, bytes);
+
+  for(dlong n=0;n<mesh->Nelements;++n){
+    const dlong e = cp->order[n];
+    const dlong row = (rows) ? rows[e] : e;
+    if(row<0) continue;
+
+    const dfloat *record = cp->records + n*Nvalues + cp->recordOffset;
+    for(int b=0;b<Nblocks;++b)
+      for(int i=0;i<Np;++i)
+        q[row*elementStride + b*blockStride + i] = record[b*Np+i];
+  }
+
+  if(bytes) o_q.copyFrom(q, bytes);
+  free(q);
+
+  cp->recordOffset += Nblocks*Np;
+}
+
+void meshCheckpointReadEnd(meshCheckpoint_t *cp){
+
+  mesh_t *mesh = cp->mesh;
+
+  if(cp->recordOffset!=cp->header.Nvalues && mesh->rank==0)
+    printf("meshCheckpointReadEnd: read %d of %d values per element\n", cp->recordOffset, cp->header.Nvalues);
+
+  free(cp->records);
+  cp->records = NULL;
+}
@@ -184,7 +184,7 @@ dfloat meshClusteredGeometricPartition2D(mesh2D *mesh, int Nclusters, cluster_t
     parallelClusters[n].index = hilbert2D(Nboxes, Nboxes-1, Nboxes-1);
   }
 
-  // odd-even parallel sort of cluster capsules based on their Morton index
+  // parallel sample sort of cluster capsules based on their Morton index
   parallelSort(mesh->size, mesh->rank, mesh->comm,
 	       maxNclusters, parallelClusters, sizeof(parallelCluster_t),
 	       compareIndex2D, bogusMatch);
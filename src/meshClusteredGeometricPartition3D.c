@@ -197,7 +197,7 @@ dfloat meshClusteredGeometricPartition3D(mesh3D *mesh, int Nclusters, cluster_t
     parallelClusters[n].index = mortonIndex3D(Nboxes+1, Nboxes+1,Nboxes+1);
   }
 
-  // odd-even parallel sort of cluster capsules based on their Morton index
+  // parallel sample sort of cluster capsules based on their Morton index
   parallelSort(mesh->size, mesh->rank, mesh->comm,
 	       maxNclusters, parallelClusters, sizeof(parallelCluster_t),
 	       compareIndex3D, bogusMatch);
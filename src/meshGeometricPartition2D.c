@@ -273,7 +273,7 @@ void meshGeometricPartition2D(mesh2D *mesh){
     //    elements[e].index = mortonIndex2D(Nboxes+1, Nboxes+1);
   }
 
-  // odd-even parallel sort of element capsules based on their Morton index
+  // parallel sample sort of element capsules based on their Morton index
   parallelSort(mesh->size, mesh->rank, mesh->comm,
 	       maxNelements, elements, sizeof(element_t),
 	       compareElements2D,
@@ -177,7 +177,7 @@ void meshGeometricPartition3D(mesh3D *mesh){
     elements[e].index = mortonIndex3D(Nboxes+1, Nboxes+1, Nboxes+1);
   }
 
-  // odd-even parallel sort of element capsules based on their Morton index
+  // parallel sample sort of element capsules based on their Morton index
   parallelSort(mesh->size, mesh->rank, mesh->comm,
 	       maxNelements, elements, sizeof(element_t),
 	       compareElements, 
@@ -33,7 +33,7 @@ void meshLoadReferenceNodesQuad2D(mesh2D *mesh, int N){
   char fname[BUFSIZ];
   sprintf(fname, DHOLMES "/nodes/quadrilateralN%02d.dat", N);
 
-  FILE *fp = fopen(fname, "r");
+  FILE *fp = meshOpenReferenceFile(fname, mesh->comm);
 
   if (!fp) {
     printf("ERROR: Cannot open file: '%s'\n", fname);
@@ -33,7 +33,7 @@ void meshLoadReferenceNodesTet3D(mesh3D *mesh, int N){
   char fname[BUFSIZ];
   sprintf(fname, DHOLMES "/nodes/tetN%02d.dat", N);
 
-  FILE *fp = fopen(fname, "r");
+  FILE *fp = meshOpenReferenceFile(fname, mesh->comm);
 
   if (!fp) {
     printf("ERROR: Cannot open file: '%s'\n", fname);
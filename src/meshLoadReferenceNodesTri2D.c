@@ -34,7 +34,7 @@ void meshLoadReferenceNodesTri2D(mesh2D *mesh, int N){
   char fname[BUFSIZ];
   sprintf(fname, DHOLMES "/nodes/triangleN%02d.dat", N);
 
-  FILE *fp = fopen(fname, "r");
+  FILE *fp = meshOpenReferenceFile(fname, mesh->comm);
 
   if (!fp) {
     printf("ERROR: Cannot open file: '%s'\n", fname);
@@ -140,9 +140,6 @@ void meshMRABWeightedPartition2D(mesh2D *mesh, dfloat *weights,
 
   // connect elements using parallel sort
   meshParallelConnect(mesh);
-
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
   
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
@@ -173,6 +170,9 @@ void meshMRABWeightedPartition2D(mesh2D *mesh, dfloat *weights,
 
   // global nodes
   meshParallelConnectNodes(mesh);
+
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
   
   if (mesh->totalHaloPairs) {
     mesh->MRABlevel = (int *) realloc(mesh->MRABlevel,(mesh->Nelements+mesh->totalHaloPairs)*sizeof(int));
@@ -142,9 +142,6 @@ void meshMRABWeightedPartition3D(mesh3D *mesh, dfloat *weights,
 
   // connect elements using parallel sort
   meshParallelConnect(mesh);
-
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
   
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
@@ -175,6 +172,9 @@ void meshMRABWeightedPartition3D(mesh3D *mesh, dfloat *weights,
   // global nodes
   meshParallelConnectNodes(mesh);
 
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
+
   if (mesh->totalHaloPairs) {
     mesh->MRABlevel = (int *) realloc(mesh->MRABlevel,(mesh->Nelements+mesh->totalHaloPairs)*sizeof(int));
     int *MRABsendBuffer = (int *) calloc(mesh->totalHaloPairs,sizeof(int));
@@ -27,6 +27,8 @@ SOFTWARE.
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
+#include <math.h>
 
 #include "mesh.h"
 
@@ -39,8 +41,23 @@ typedef struct{
 }parallelNode_t;
 
 
-// uniquely label each node with a global index, used for gatherScatter
-void meshParallelConnectNodes(mesh_t *mesh){
+typedef struct{
+
+  hlong v[4];          // sorted global vertex ids of the vertex, edge or face holding the node
+  long long int c[2];  // quantized local coordinates of the node on it
+
+  int baseRank;
+  hlong baseId;
+
+  dlong id;            // local node id on the rank the copy came from
+  dlong slot;          // position in the owner's receive buffer
+
+}parallelNodeKey_t;
+
+#define connectNodesScale (1LL<<30)
+
+// initial labels: vertex nodes use their vertex id, all others a unique id
+static parallelNode_t *meshParallelNodeLabels(mesh_t *mesh){
 
   int rank, size;
   rank = mesh->rank; 
@@ -82,7 +99,38 @@ void meshParallelConnectNodes(mesh_t *mesh){
     }
   }
 
+  return localNodes;
+}
+
+static void meshParallelNodeResult(mesh_t *mesh, parallelNode_t *localNodes){
+
+  dlong localNodeCount = mesh->Np*mesh->Nelements;
+
+  //make a locally-ordered version
+  mesh->globalIds = (hlong*) calloc(localNodeCount, sizeof(hlong));
+  for(dlong id=0;id<localNodeCount;++id){
+    mesh->globalIds[id] = localNodes[id].baseId;    
+  }
+}
+
+// uniquely label each node with a global index, used for gatherScatter
+void meshParallelConnectNodes(mesh_t *mesh){
+
+  meshParallelConnectNodesSort(mesh);
+}
+
+// keep comparing labels across element traces until nothing changes; the
+// number of rounds grows with the graph diameter of the shared nodes
+void meshParallelConnectNodesHalo(mesh_t *mesh){
+
+  double tic = MPI_Wtime();
+
+  dlong localNodeCount = mesh->Np*mesh->Nelements;
+
+  parallelNode_t *localNodes = meshParallelNodeLabels(mesh);
+
   dlong localChange = 0, gatherChange = 1;
+  int Nrounds = 0;
 
   parallelNode_t *sendBuffer =
     (parallelNode_t*) calloc(mesh->totalHaloPairs*mesh->Np, sizeof(parallelNode_t));
@@ -90,6 +138,8 @@ void meshParallelConnectNodes(mesh_t *mesh){
   // keep comparing numbers on positive and negative traces until convergence
   while(gatherChange>0){
 
+    ++Nrounds;
+
     // reset change counter
     localChange = 0;
 
@@ -127,12 +177,318 @@ void meshParallelConnectNodes(mesh_t *mesh){
     MPI_Allreduce(&localChange, &gatherChange, 1, MPI_DLONG, MPI_SUM, mesh->comm);
   }
 
-  //make a locally-ordered version
-  mesh->globalIds = (hlong*) calloc(localNodeCount, sizeof(hlong));
-  for(dlong id=0;id<localNodeCount;++id){
-    mesh->globalIds[id] = localNodes[id].baseId;    
-  }
+  meshParallelNodeResult(mesh, localNodes);
   
   free(localNodes);
   free(sendBuffer);
+
+  mesh->connectNodesRounds[MESH_CONNECT_NODES_HALO] = Nrounds;
+  mesh->connectNodesTime[MESH_CONNECT_NODES_HALO] = MPI_Wtime()-tic;
+}
+
+static int compareNodeKeys(const void *a, const void *b){
+
+  const parallelNodeKey_t *ka = (const parallelNodeKey_t*) a;
+  const parallelNodeKey_t *kb = (const parallelNodeKey_t*) b;
+
+  for(int n=0;n<4;++n){
+    if(ka->v[n] < kb->v[n]) return -1;
+    if(ka->v[n] > kb->v[n]) return +1;
+  }
+  for(int n=0;n<2;++n){
+    if(ka->c[n] < kb->c[n]) return -1;
+    if(ka->c[n] > kb->c[n]) return +1;
+  }
+  return 0;
+}
+
+static int nodeLabelLess(const parallelNode_t *a, const parallelNode_t *b){
+  return (a->baseId<b->baseId || (a->baseId==b->baseId && a->baseRank<b->baseRank));
+}
+
+static dlong findNodeRoot(dlong *parent, dlong id){
+  while(parent[id]!=id){
+    parent[id] = parent[parent[id]];
+    id = parent[id];
+  }
+  return id;
+}
+
+// join node copies connected through this rank's own element traces, keeping
+// the smallest label at the root of each set; vertex nodes are skipped since
+// their labels are final already
+static dlong *meshLocalNodeSets(mesh_t *mesh, const int *Nverts, parallelNode_t *localNodes){
+
+  dlong localNodeCount = mesh->Np*mesh->Nelements;
+
+  dlong *parent = (dlong*) calloc(localNodeCount+1, sizeof(dlong));
+  for(dlong id=0;id<localNodeCount;++id) parent[id] = id;
+
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->Nfp*mesh->Nfaces;++n){
+      dlong id  = e*mesh->Nfp*mesh->Nfaces + n;
+      dlong idP = mesh->vmapP[id];
+      if(idP>=localNodeCount || Nverts[mesh->faceNodes[n]]<=1) continue;
+
+      dlong rootM = findNodeRoot(parent, mesh->vmapM[id]);
+      dlong rootP = findNodeRoot(parent, idP);
+      if(rootM==rootP) continue;
+
+      if(nodeLabelLess(localNodes+rootP, localNodes+rootM)){
+        dlong tmp = rootM; rootM = rootP; rootP = tmp;
+      }
+      parent[rootP] = rootM;
+    }
+  }
+
+  return parent;
+}
+
+// copy the label of each set's root to all of its members
+static void meshLocalNodeLabels(mesh_t *mesh, const int *Nverts, dlong *parent, parallelNode_t *localNodes){
+
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->Np;++n){
+      if(Nverts[n]<=1) continue;
+      dlong id = e*mesh->Np+n;
+      localNodes[id] = localNodes[findNodeRoot(parent, id)];
+    }
+  }
+}
+
+// reference coordinates of node n
+static void meshNodeCoordinates(mesh_t *mesh, int n, dfloat *r){
+  r[0] = mesh->r[n];
+  r[1] = mesh->s[n];
+  r[2] = (mesh->NfaceVertices>2) ? mesh->t[n] : 0;
+}
+
+static long long int quantizeCoordinate(dfloat c){
+  return llround(c*connectNodesScale);
+}
+
+/* key of node n of element e: the sorted global vertex ids of the smallest
+   vertex, edge or face holding it, and its coordinates on that entity in a
+   frame anchored at the entity's smallest global vertex, so every element
+   sharing the node computes the same key */
+static void meshNodeKey(mesh_t *mesh, dlong e, int n, int Nv, const int *verts, parallelNodeKey_t *key){
+
+  hlong gid[4];
+  for(int i=0;i<Nv;++i) gid[i] = mesh->EToV[e*mesh->Nverts+verts[i]];
+
+  for(int i=0;i<4;++i) key->v[i] = -1;
+  key->c[0] = key->c[1] = 0;
+
+  // sorted vertex ids
+  for(int i=0;i<Nv;++i) key->v[i] = gid[i];
+  for(int i=1;i<Nv;++i)
+    for(int j=i;j>0 && key->v[j]<key->v[j-1];--j){
+      hlong tmp = key->v[j]; key->v[j] = key->v[j-1]; key->v[j-1] = tmp;
+    }
+
+  if(Nv==1) return;
+
+  // anchor vertex and, for faces, its two neighbours in the face ordered by id
+  int i0 = 0;
+  for(int i=1;i<Nv;++i) if(gid[i]<gid[i0]) i0 = i;
+
+  dfloat rn[3], r0[3], ra[3], rb[3];
+  meshNodeCoordinates(mesh, n, rn);
+  meshNodeCoordinates(mesh, mesh->vertexNodes[verts[i0]], r0);
+
+  if(Nv==2){
+    meshNodeCoordinates(mesh, mesh->vertexNodes[verts[1-i0]], ra);
+    dfloat len = 0, dist = 0;
+    for(int d=0;d<3;++d){
+      len  += (ra[d]-r0[d])*(ra[d]-r0[d]);
+      dist += (rn[d]-r0[d])*(rn[d]-r0[d]);
+    }
+    key->c[0] = quantizeCoordinate(sqrt(dist/len));
+    return;
+  }
+
+  // face vertices are listed cyclically, so the neighbours of the anchor are adjacent in the list
+  int ia = (i0+1)%Nv, ib = (i0+Nv-1)%Nv;
+  if(gid[ib]<gid[ia]){ int tmp = ia; ia = ib; ib = tmp; }
+
+  meshNodeCoordinates(mesh, mesh->vertexNodes[verts[ia]], ra);
+  meshNodeCoordinates(mesh, mesh->vertexNodes[verts[ib]], rb);
+
+  // rn - r0 = alpha*(ra - r0) + beta*(rb - r0)
+  dfloat aa = 0, ab = 0, bb = 0, pa = 0, pb = 0;
+  for(int d=0;d<3;++d){
+    const dfloat ea = ra[d]-r0[d], eb = rb[d]-r0[d], p = rn[d]-r0[d];
+    aa += ea*ea; ab += ea*eb; bb += eb*eb;
+    pa += p*ea;  pb += p*eb;
+  }
+  const dfloat det = aa*bb - ab*ab;
+  key->c[0] = quantizeCoordinate((pa*bb - pb*ab)/det);
+  key->c[1] = quantizeCoordinate((pb*aa - pa*ab)/det);
+}
+
+// settle labels on each rank first, then bucket the keys of the nodes on
+// faces shared between ranks on the rank owning their smallest vertex id with
+// one Alltoallv, take the smallest label of each node there and send the
+// labels back with a second Alltoallv
+void meshParallelConnectNodesSort(mesh_t *mesh){
+
+  double tic = MPI_Wtime();
+
+  int size = mesh->size; 
+
+  parallelNode_t *localNodes = meshParallelNodeLabels(mesh);
+
+  // vertices of the smallest entity holding each reference node (0 for interior nodes)
+  int *Nverts = (int*) calloc(mesh->Np, sizeof(int));
+  int *verts  = (int*) calloc(mesh->Np*4, sizeof(int));
+
+  for(int n=0;n<mesh->Np;++n){
+    int Nv = -1;
+    for(int f=0;f<mesh->Nfaces;++f){
+      int onFace = 0;
+      for(int m=0;m<mesh->Nfp;++m)
+        if(mesh->faceNodes[f*mesh->Nfp+m]==n) onFace = 1;
+      if(!onFace) continue;
+
+      const int *fv = mesh->faceVertices + f*mesh->NfaceVertices;
+      if(Nv<0){
+        Nv = mesh->NfaceVertices;
+        for(int i=0;i<Nv;++i) verts[n*4+i] = fv[i];
+      } else {
+        // keep the vertices shared with this face, in order
+        int cnt = 0;
+        for(int i=0;i<Nv;++i){
+          int shared = 0;
+          for(int j=0;j<mesh->NfaceVertices;++j)
+            if(fv[j]==verts[n*4+i]) shared = 1;
+          if(shared) verts[n*4+cnt++] = verts[n*4+i];
+        }
+        Nv = cnt;
+      }
+    }
+    Nverts[n] = mymax(Nv, 0);
+  }
+
+  // labels of nodes connected through this rank's own elements
+  dlong *parent = meshLocalNodeSets(mesh, Nverts, localNodes);
+  meshLocalNodeLabels(mesh, Nverts, parent, localNodes);
+
+  // only non-vertex nodes on faces shared with another rank need a key:
+  // vertex labels are already final and every copy of a shared edge or face
+  // node is reached locally from one of these faces
+  dlong Nkeys = 0;
+  for(dlong e=0;e<mesh->Nelements;++e)
+    for(int f=0;f<mesh->Nfaces;++f)
+      if(mesh->EToP[e*mesh->Nfaces+f]!=-1)
+        for(int m=0;m<mesh->Nfp;++m)
+          if(Nverts[mesh->faceNodes[f*mesh->Nfp+m]]>1) ++Nkeys;
+
+  parallelNodeKey_t *keys = (parallelNodeKey_t*) calloc(Nkeys+1, sizeof(parallelNodeKey_t));
+
+  dlong cnt = 0;
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int f=0;f<mesh->Nfaces;++f){
+      if(mesh->EToP[e*mesh->Nfaces+f]==-1) continue;
+      for(int m=0;m<mesh->Nfp;++m){
+        const int n = mesh->faceNodes[f*mesh->Nfp+m];
+        if(Nverts[n]<=1) continue;
+
+        parallelNodeKey_t *key = keys + cnt++;
+        meshNodeKey(mesh, e, n, Nverts[n], verts+n*4, key);
+
+        const dlong id = e*mesh->Np+n;
+        key->baseRank = localNodes[id].baseRank;
+        key->baseId   = localNodes[id].baseId;
+        key->id = id;
+      }
+    }
+  }
+
+  // bucket by owner of the smallest vertex id
+  int *sendCounts  = (int*) calloc(size, sizeof(int));
+  int *recvCounts  = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size+1, sizeof(int));
+  int *recvOffsets = (int*) calloc(size+1, sizeof(int));
+
+  for(dlong k=0;k<Nkeys;++k)
+    ++sendCounts[keys[k].v[0]%size];
+
+  MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, mesh->comm);
+
+  for(int r=0;r<size;++r){
+    sendOffsets[r+1] = sendOffsets[r] + sendCounts[r];
+    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+  }
+
+  parallelNodeKey_t *sendKeys = (parallelNodeKey_t*) calloc(Nkeys+1, sizeof(parallelNodeKey_t));
+  int *fill = (int*) calloc(size, sizeof(int));
+  for(dlong k=0;k<Nkeys;++k){
+    const int owner = (int) (keys[k].v[0]%size);
+    sendKeys[sendOffsets[owner] + fill[owner]++] = keys[k];
+  }
+
+  MPI_Datatype MPI_NODEKEY_T;
+  MPI_Type_contiguous(sizeof(parallelNodeKey_t), MPI_CHAR, &MPI_NODEKEY_T);
+  MPI_Type_commit(&MPI_NODEKEY_T);
+
+  dlong Nrecv = recvOffsets[size];
+  parallelNodeKey_t *recvKeys = (parallelNodeKey_t*) calloc(Nrecv+1, sizeof(parallelNodeKey_t));
+
+  MPI_Alltoallv(sendKeys, sendCounts, sendOffsets, MPI_NODEKEY_T,
+                recvKeys, recvCounts, recvOffsets, MPI_NODEKEY_T, mesh->comm);
+
+  // smallest label of each node, written back in receive order
+  for(dlong k=0;k<Nrecv;++k) recvKeys[k].slot = k;
+
+  parallelNodeKey_t *sortedKeys = (parallelNodeKey_t*) calloc(Nrecv+1, sizeof(parallelNodeKey_t));
+  memcpy(sortedKeys, recvKeys, Nrecv*sizeof(parallelNodeKey_t));
+  qsort(sortedKeys, Nrecv, sizeof(parallelNodeKey_t), compareNodeKeys);
+
+  for(dlong start=0;start<Nrecv;){
+    dlong end = start+1;
+    while(end<Nrecv && !compareNodeKeys(sortedKeys+start, sortedKeys+end)) ++end;
+
+    hlong baseId = sortedKeys[start].baseId;
+    int baseRank = sortedKeys[start].baseRank;
+    for(dlong k=start+1;k<end;++k){
+      if(sortedKeys[k].baseId<baseId ||
+         (sortedKeys[k].baseId==baseId && sortedKeys[k].baseRank<baseRank)){
+        baseId = sortedKeys[k].baseId;
+        baseRank = sortedKeys[k].baseRank;
+      }
+    }
+    for(dlong k=start;k<end;++k){
+      recvKeys[sortedKeys[k].slot].baseId = baseId;
+      recvKeys[sortedKeys[k].slot].baseRank = baseRank;
+    }
+    start = end;
+  }
+
+  // return the labels to the ranks the node copies came from
+  MPI_Alltoallv(recvKeys, recvCounts, recvOffsets, MPI_NODEKEY_T,
+                sendKeys, sendCounts, sendOffsets, MPI_NODEKEY_T, mesh->comm);
+
+  // every copy in a local set gets the same global label back
+  for(dlong k=0;k<Nkeys;++k){
+    const dlong root = findNodeRoot(parent, sendKeys[k].id);
+    localNodes[root].baseId   = sendKeys[k].baseId;
+    localNodes[root].baseRank = sendKeys[k].baseRank;
+  }
+
+  meshLocalNodeLabels(mesh, Nverts, parent, localNodes);
+
+  meshParallelNodeResult(mesh, localNodes);
+
+  MPI_Type_free(&MPI_NODEKEY_T);
+
+  free(localNodes);
+  free(Nverts); free(verts);
+  free(parent);
+  free(keys); free(fill);
+  free(sendKeys); free(recvKeys); free(sortedKeys);
+  free(sendCounts); free(recvCounts);
+  free(sendOffsets); free(recvOffsets);
+
+  mesh->connectNodesRounds[MESH_CONNECT_NODES_SORT] = 2;
+  mesh->connectNodesTime[MESH_CONNECT_NODES_SORT] = MPI_Wtime()-tic;
 }
@@ -0,0 +1,190 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mesh.h"
+#include "meshBinary.h"
+
+/* 
+   read Nrecords records of recordBytes bytes at offset, in rounds of at most
+   1GB so no MPI count overflows; Nrounds must be the same on every rank
+*/
+static void meshBinaryReadAll(MPI_File fh, MPI_Offset offset, char *buffer,
+                              hlong Nrecords, size_t recordBytes, hlong NmaxRecords){
+
+  const hlong NroundRecords = mymax((hlong) 1, (hlong) ((1<<30)/recordBytes));
+  const hlong Nrounds = (NmaxRecords+NroundRecords-1)/NroundRecords;
+
+  for(hlong r=0;r<Nrounds;++r){
+    hlong first = r*NroundRecords;
+    hlong count = mymax((hlong) 0, mymin(NroundRecords, Nrecords-first));
+
+    MPI_File_read_at_all(fh, offset + (MPI_Offset) first*recordBytes,
+                         buffer + (size_t) first*recordBytes,
+                         (int) (count*recordBytes), MPI_BYTE, MPI_STATUS_IGNORE);
+  }
+}
+
+/* 
+   purpose: read this rank's share of a native binary mesh with MPI-IO
+
+   Every rank reads the header and the boundary section, but only its own
+   contiguous slice of element records, so no rank touches the whole file.
+*/
+int meshParallelReaderBinary(mesh_t *mesh, char *fileName, int elementType, int faceType){
+
+  int rank, size;
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  MPI_File fh;
+  if(MPI_File_open(MPI_COMM_WORLD, fileName, MPI_MODE_RDONLY, MPI_INFO_NULL, &fh)!=MPI_SUCCESS)
+    return 0;
+
+  meshBinaryHeader_t header;
+  memset(&header, 0, sizeof(meshBinaryHeader_t));
+
+  MPI_Offset fileSize;
+  MPI_File_get_size(fh, &fileSize);
+  if(fileSize>=(MPI_Offset) sizeof(meshBinaryHeader_t))
+    MPI_File_read_at_all(fh, 0, &header, sizeof(meshBinaryHeader_t), MPI_BYTE, MPI_STATUS_IGNORE);
+
+  if(strncmp(header.magic, MESH_BINARY_MAGIC, 8)){ // not a binary mesh
+    MPI_File_close(&fh);
+    return 0;
+  }
+
+  if(header.byteOrder!=1 || header.version!=MESH_BINARY_VERSION){
+    if(rank==0)
+      printf("meshParallelReaderBinary: %s was written with a different byte order or format version\n", fileName);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+
+  if(header.elementType!=elementType || header.faceType!=faceType ||
+     header.Nverts!=mesh->Nverts || header.NfaceVertices!=mesh->NfaceVertices){
+    if(rank==0)
+      printf("meshParallelReaderBinary: %s holds gmsh element/face types %d/%d, expected %d/%d\n",
+             fileName, (int) header.elementType, (int) header.faceType, elementType, faceType);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+
+#ifndef HLONG64
+  if(header.Nnodes>2147483647){
+    if(rank==0)
+      printf("meshParallelReaderBinary: %s has %lld nodes, rebuild with hlong=64\n",
+             fileName, (long long int) header.Nnodes);
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+#endif
+
+  mesh->Nnodes = (hlong) header.Nnodes;
+
+  int Nverts = mesh->Nverts;
+  int NfaceVertices = mesh->NfaceVertices;
+
+  /* same element distribution as the gmsh readers */
+  hlong Nelements = (hlong) header.Nelements;
+  hlong chunk = (hlong) Nelements/size;
+  int remainder = (int) (Nelements - chunk*size);
+
+  hlong NelementsLocal = chunk + (rank<remainder);
+  hlong start = rank*chunk + mymin(rank, remainder);
+
+  /* read this rank's slice of element records */
+  size_t elementBytes = meshBinaryElementBytes(Nverts);
+
+  char *elementBuffer = (char*) calloc(NelementsLocal*elementBytes+1, sizeof(char));
+  MPI_Offset elementStart = (MPI_Offset) header.elementOffset + (MPI_Offset) start*elementBytes;
+  meshBinaryReadAll(fh, elementStart, elementBuffer, NelementsLocal, elementBytes, chunk + (remainder>0));
+
+  /* every rank keeps all boundary faces, as in the gmsh readers */
+  hlong NboundaryFaces = (hlong) header.NboundaryFaces;
+  size_t boundaryBytes = meshBinaryBoundaryBytes(NfaceVertices);
+
+  int64_t *boundaryBuffer = (int64_t*) calloc(NboundaryFaces*(NfaceVertices+1)+1, sizeof(int64_t));
+  meshBinaryReadAll(fh, (MPI_Offset) header.boundaryOffset, (char*) boundaryBuffer,
+                    NboundaryFaces, boundaryBytes, NboundaryFaces);
+
+  MPI_File_close(&fh);
+
+  /* unpack element records */
+  mesh->Nelements = (dlong) NelementsLocal;
+
+  mesh->EToV = (hlong*) calloc(mesh->Nelements*Nverts, sizeof(hlong));
+  mesh->elementInfo = (int*) calloc(mesh->Nelements, sizeof(int));
+
+  mesh->EX = (dfloat*) calloc(Nverts*mesh->Nelements, sizeof(dfloat));
+  mesh->EY = (dfloat*) calloc(Nverts*mesh->Nelements, sizeof(dfloat));
+  if(mesh->dim==3)
+    mesh->EZ = (dfloat*) calloc(Nverts*mesh->Nelements, sizeof(dfloat));
+
+  for(dlong e=0;e<mesh->Nelements;++e){
+    char *record = elementBuffer + e*elementBytes;
+
+    int64_t *ids = (int64_t*) record;
+    double *xyz  = (double*) (record + (1+Nverts)*sizeof(int64_t));
+
+    mesh->elementInfo[e] = (int) ids[0];
+
+    for(int n=0;n<Nverts;++n){
+      mesh->EToV[e*Nverts+n] = (hlong) ids[1+n];
+      mesh->EX[e*Nverts+n] = (dfloat) xyz[3*n+0];
+      mesh->EY[e*Nverts+n] = (dfloat) xyz[3*n+1];
+      if(mesh->dim==3)
+        mesh->EZ[e*Nverts+n] = (dfloat) xyz[3*n+2];
+    }
+
+    // check orientation, as meshParallelReaderTri2D/Quad2D do
+    if(mesh->dim==2 && (elementType==2 || elementType==3)){
+      int va = (elementType==2) ? 2:3; // vertex swapped with vertex 1
+      dfloat *ex = mesh->EX + e*Nverts, *ey = mesh->EY + e*Nverts;
+      dfloat J = 0.25*((ex[1]-ex[0])*(ey[va]-ey[0]) - (ex[va]-ex[0])*(ey[1]-ey[0]));
+      if(J<0){
+        hlong vtmp = mesh->EToV[e*Nverts+va];
+        mesh->EToV[e*Nverts+va] = mesh->EToV[e*Nverts+1];
+        mesh->EToV[e*Nverts+1] = vtmp;
+
+        dfloat xtmp = ex[va]; ex[va] = ex[1]; ex[1] = xtmp;
+        dfloat ytmp = ey[va]; ey[va] = ey[1]; ey[1] = ytmp;
+      }
+    }
+  }
+
+  /* unpack boundary records */
+  mesh->NboundaryFaces = NboundaryFaces;
+  mesh->boundaryInfo = (hlong*) calloc(NboundaryFaces*(NfaceVertices+1), sizeof(hlong));
+  for(hlong n=0;n<NboundaryFaces*(NfaceVertices+1);++n)
+    mesh->boundaryInfo[n] = (hlong) boundaryBuffer[n];
+
+  free(elementBuffer);
+  free(boundaryBuffer);
+
+  return 1;
+}
@@ -64,6 +64,12 @@ mesh3D* meshParallelReaderHex3D(char *fileName){
 
   memcpy(mesh->faceVertices, faceVertices[0], mesh->NfaceVertices*mesh->Nfaces*sizeof(int));
     
+  /* native binary meshes are read in slices with MPI-IO */
+  if(meshParallelReaderBinary(mesh, fileName, 5, 3)){
+    if(fp) fclose(fp);
+    return mesh;
+  }
+
   if(fp==NULL){
     printf("meshReaderHex3D: could not load file %s\n", fileName);
     exit(0);
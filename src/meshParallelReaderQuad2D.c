@@ -65,6 +65,12 @@ mesh2D* meshParallelReaderQuad2D(char *fileName){
   
   memcpy(mesh->faceVertices, faceVertices[0], mesh->NfaceVertices*mesh->Nfaces*sizeof(int));
   
+  /* native binary meshes are read in slices with MPI-IO */
+  if(meshParallelReaderBinary(mesh, fileName, 3, 1)){
+    if(fp) fclose(fp);
+    return mesh;
+  }
+
   if(fp==NULL){
     printf("meshParallelReaderQuad2D: could not load file %s\n", fileName);
     exit(0);
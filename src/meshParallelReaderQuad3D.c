@@ -43,7 +43,6 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   FILE *fp = fopen(fileName, "r");
-  int n;
 
   mesh_t *mesh = (mesh_t*) calloc(1, sizeof(mesh_t));
 
@@ -59,6 +58,12 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   
   memcpy(mesh->faceVertices, faceVertices[0], mesh->NfaceVertices*mesh->Nfaces*sizeof(int));
   
+  /* native binary meshes are read in slices with MPI-IO */
+  if(meshParallelReaderBinary(mesh, fileName, 3, 1)){
+    if(fp) fclose(fp);
+    return mesh;
+  }
+
   if(fp==NULL){
     printf("meshReader2D: could not load file %s\n", fileName);
     exit(0);
@@ -71,7 +76,7 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
 
   /* read number of nodes in mesh */
   fgets(buf, BUFSIZ, fp);
-  sscanf(buf, "%d", &(mesh->Nnodes));
+  sscanf(buf, hlongFormat, &(mesh->Nnodes));
 
   /* allocate space for node coordinates */
   dfloat *VX = (dfloat*) calloc(mesh->Nnodes, sizeof(dfloat));
@@ -79,7 +84,7 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   dfloat *VZ = (dfloat*) calloc(mesh->Nnodes, sizeof(dfloat));
 
   /* load nodes */
-  for(n=0;n<mesh->Nnodes;++n){
+  for(hlong n=0;n<mesh->Nnodes;++n){
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d" dfloatFormat dfloatFormat dfloatFormat,
 	   VX+n, VY+n, VZ+n);
@@ -91,16 +96,17 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   }while(!strstr(buf, "$Elements"));
 
   /* read number of nodes in mesh */
+  hlong Nelements;
   fgets(buf, BUFSIZ, fp);
-  sscanf(buf, "%d", &(mesh->Nelements));
+  sscanf(buf, hlongFormat, &Nelements);
 
   /* find # of quadrilaterals */
   fpos_t fpos;
   fgetpos(fp, &fpos);
-  int Nquadrilaterals = 0;
+  hlong Nquadrilaterals = 0;
 
-  int NboundaryFaces = 0;
-  for(n=0;n<mesh->Nelements;++n){
+  hlong NboundaryFaces = 0;
+  for(hlong n=0;n<Nelements;++n){
     int elementType;
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d%d", &elementType);
@@ -110,33 +116,34 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   // rewind to start of elements
   fsetpos(fp, &fpos);
 
-  int chunk = Nquadrilaterals/size;
-  int remainder = Nquadrilaterals - chunk*size;
+  hlong chunk = (hlong) Nquadrilaterals/size;
+  int remainder = (int) (Nquadrilaterals - chunk*size);
 
-  int NquadrilateralsLocal = chunk + (rank<remainder);
+  hlong NquadrilateralsLocal = chunk + (rank<remainder);
 
   /* where do these elements start ? */
-  int start = rank*chunk + mymin(rank, remainder); 
-  int end = start + NquadrilateralsLocal-1;
+  hlong start = rank*chunk + mymin(rank, remainder); 
+  hlong end = start + NquadrilateralsLocal-1;
   
   /* allocate space for Element node index data */
 
   mesh->EToV 
-    = (int*) calloc(NquadrilateralsLocal*mesh->Nverts, 
-		     sizeof(int));
+    = (hlong*) calloc(NquadrilateralsLocal*mesh->Nverts, 
+		     sizeof(hlong));
 
   /* scan through file looking for quadrilateral elements */
-  int cnt=0, bcnt=0;
+  hlong cnt=0, bcnt=0;
   Nquadrilaterals = 0;
 
-  mesh->boundaryInfo = (int*) calloc(NboundaryFaces*3, sizeof(int));
-  for(n=0;n<mesh->Nelements;++n){
-    int elementType, v1, v2, v3, v4;
+  mesh->boundaryInfo = (hlong*) calloc(NboundaryFaces*3, sizeof(hlong));
+  for(hlong n=0;n<Nelements;++n){
+    int elementType;
+    hlong v1, v2, v3, v4;
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d%d", &elementType);
 
     if(elementType==1){ // boundary face
-      sscanf(buf, "%*d%*d %*d%d%*d %d%d", 
+      sscanf(buf, "%*d%*d %*d" hlongFormat "%*d " hlongFormat hlongFormat, 
 	     mesh->boundaryInfo+bcnt*3, &v1, &v2);
       mesh->boundaryInfo[bcnt*3+1] = v1-1;
       mesh->boundaryInfo[bcnt*3+2] = v2-1;
@@ -145,7 +152,7 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
     
     if(elementType==3){  // quadrilateral
       if(start<=Nquadrilaterals && Nquadrilaterals<=end){
-	sscanf(buf, "%*d%*d%*d%*d%*d %d%d%d%d", 
+	sscanf(buf, "%*d%*d%*d%*d%*d " hlongFormat hlongFormat hlongFormat hlongFormat, 
 	       &v1, &v2, &v3, &v4);
 
 #if 0
@@ -177,14 +184,14 @@ mesh_t* meshParallelReaderQuad3D(char *fileName){
   mesh->NboundaryFaces = bcnt;
   
   /* record number of found quadrilaterals */
-  mesh->Nelements = NquadrilateralsLocal;
+  mesh->Nelements = (dlong) NquadrilateralsLocal;
 
   /* collect vertices for each element */
   mesh->EX = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
   mesh->EY = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
   mesh->EZ = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
-  for(int e=0;e<mesh->Nelements;++e){
-    for(n=0;n<mesh->Nverts;++n){
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->Nverts;++n){
       mesh->EX[e*mesh->Nverts+n] = VX[mesh->EToV[e*mesh->Nverts+n]];
       mesh->EY[e*mesh->Nverts+n] = VY[mesh->EToV[e*mesh->Nverts+n]];
       mesh->EZ[e*mesh->Nverts+n] = VZ[mesh->EToV[e*mesh->Nverts+n]];
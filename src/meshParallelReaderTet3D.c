@@ -63,6 +63,12 @@ mesh3D* meshParallelReaderTet3D(char *fileName){
     (int*) calloc(mesh->NfaceVertices*mesh->Nfaces, sizeof(int));
   memcpy(mesh->faceVertices, faceVertices[0], 12*sizeof(int));
     
+  /* native binary meshes are read in slices with MPI-IO */
+  if(meshParallelReaderBinary(mesh, fileName, 4, 2)){
+    if(fp) fclose(fp);
+    return mesh;
+  }
+
   if(fp==NULL){
     printf("meshReaderTet3D: could not load file %s\n", fileName);
     exit(0);
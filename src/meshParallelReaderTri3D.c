@@ -43,7 +43,6 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
   MPI_Comm_size(MPI_COMM_WORLD, &size);
 
   FILE *fp = fopen(fileName, "r");
-  int n;
 
   mesh3D *mesh = (mesh3D*) calloc(1, sizeof(mesh3D));
 
@@ -60,6 +59,12 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
 
   memcpy(mesh->faceVertices, faceVertices[0], mesh->NfaceVertices*mesh->Nfaces*sizeof(int));
 
+  /* native binary meshes are read in slices with MPI-IO */
+  if(meshParallelReaderBinary(mesh, fileName, 2, 1)){
+    if(fp) fclose(fp);
+    return mesh;
+  }
+
   if(fp==NULL){
     printf("meshParallelReaderTri3D: could not load file %s\n", fileName);
     exit(0);
@@ -75,7 +80,7 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
 
   /* read number of nodes in mesh */
   fgets(buf, BUFSIZ, fp);
-  sscanf(buf, "%d", &(mesh->Nnodes));
+  sscanf(buf, hlongFormat, &(mesh->Nnodes));
 
   /* allocate space for node coordinates */
   dfloat *VX = (dfloat*) calloc(mesh->Nnodes, sizeof(dfloat));
@@ -83,7 +88,7 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
   dfloat *VZ = (dfloat*) calloc(mesh->Nnodes, sizeof(dfloat));
 
   /* load nodes */
-  for(n=0;n<mesh->Nnodes;++n){
+  for(hlong n=0;n<mesh->Nnodes;++n){
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d" dfloatFormat dfloatFormat dfloatFormat,
 	   VX+n, VY+n, VZ+n);
@@ -95,15 +100,16 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
   }while(!strstr(buf, "$Elements"));
 
   /* read number of nodes in mesh */
+  hlong Nelements;
   fgets(buf, BUFSIZ, fp);
-  sscanf(buf, "%d", &(mesh->Nelements));
+  sscanf(buf, hlongFormat, &Nelements);
 
   /* find # of triangles */
   fpos_t fpos;
   fgetpos(fp, &fpos);
-  int Ntriangles = 0;
-  int NboundaryFaces = 0;
-  for(n=0;n<mesh->Nelements;++n){
+  hlong Ntriangles = 0;
+  hlong NboundaryFaces = 0;
+  for(hlong n=0;n<Nelements;++n){
     int elementType;
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d%d", &elementType);
@@ -113,34 +119,35 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
   // rewind to start of elements
   fsetpos(fp, &fpos);
 
-  int chunk = Ntriangles/size;
-  int remainder = Ntriangles - chunk*size;
+  hlong chunk = (hlong) Ntriangles/size;
+  int remainder = (int) (Ntriangles - chunk*size);
 
-  int NtrianglesLocal = chunk + (rank<remainder);
+  hlong NtrianglesLocal = chunk + (rank<remainder);
 
   /* where do these elements start ? */
-  int start = rank*chunk + mymin(rank, remainder);
-  int end = start + NtrianglesLocal-1;
+  hlong start = rank*chunk + mymin(rank, remainder);
+  hlong end = start + NtrianglesLocal-1;
 
   /* allocate space for Element node index data */
 
   mesh->EToV
-    = (int*) calloc(NtrianglesLocal*mesh->Nverts,
-		     sizeof(int));
+    = (hlong*) calloc(NtrianglesLocal*mesh->Nverts,
+		     sizeof(hlong));
   mesh->elementInfo
     = (int*) calloc(NtrianglesLocal,sizeof(int));
 
   /* scan through file looking for triangle elements */
-  int cnt=0, bcnt=0;
+  hlong cnt=0, bcnt=0;
   Ntriangles = 0;
 
-  mesh->boundaryInfo = (int*) calloc(NboundaryFaces*3, sizeof(int));
-  for(n=0;n<mesh->Nelements;++n){
-    int elementType, v1, v2, v3;
+  mesh->boundaryInfo = (hlong*) calloc(NboundaryFaces*3, sizeof(hlong));
+  for(hlong n=0;n<Nelements;++n){
+    int elementType;
+    hlong v1, v2, v3;
     fgets(buf, BUFSIZ, fp);
     sscanf(buf, "%*d%d", &elementType);
     if(elementType==1){ // boundary face
-      sscanf(buf, "%*d%*d %*d%d%*d %d%d",
+      sscanf(buf, "%*d%*d %*d" hlongFormat "%*d " hlongFormat hlongFormat,
 	     mesh->boundaryInfo+bcnt*3, &v1, &v2);
       mesh->boundaryInfo[bcnt*3+1] = v1-1;
       mesh->boundaryInfo[bcnt*3+2] = v2-1;
@@ -148,7 +155,7 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
     }
     if(elementType==2){  // triangle
       if(start<=Ntriangles && Ntriangles<=end){
-	sscanf(buf, "%*d%*d%*d %d %*d %d%d%d",
+	sscanf(buf, "%*d%*d%*d %d %*d " hlongFormat hlongFormat hlongFormat,
 	      mesh->elementInfo+cnt, &v1, &v2, &v3);
 
 	// check orientation
@@ -160,7 +167,7 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
 	// TW: no idea 
 	dfloat J = 0.25*((xe2-xe1)*(ye3-ye1) - (xe3-xe1)*(ye2-ye1));
 	if(J<0){
-	  int v3tmp = v3;
+	  hlong v3tmp = v3;
 	  v3 = v2;
 	  v2 = v3tmp;
 	  //	  printf("unwarping element\n");
@@ -183,14 +190,14 @@ mesh3D* meshParallelReaderTri3D(char *fileName){
   mesh->NboundaryFaces = bcnt;
 
   /* record number of found triangles */
-  mesh->Nelements = NtrianglesLocal;
+  mesh->Nelements = (dlong) NtrianglesLocal;
 
   /* collect vertices for each element */
   mesh->EX = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
   mesh->EY = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
   mesh->EZ = (dfloat*) calloc(mesh->Nverts*mesh->Nelements, sizeof(dfloat));
-  for(int e=0;e<mesh->Nelements;++e){
-    for(n=0;n<mesh->Nverts;++n){
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->Nverts;++n){
       mesh->EX[e*mesh->Nverts+n] = VX[mesh->EToV[e*mesh->Nverts+n]];
       mesh->EY[e*mesh->Nverts+n] = VY[mesh->EToV[e*mesh->Nverts+n]];
       mesh->EZ[e*mesh->Nverts+n] = VZ[mesh->EToV[e*mesh->Nverts+n]];
@@ -67,6 +67,19 @@ void meshPartitionStatistics(mesh_t *mesh){
       fflush(stdout);
     }
   }
+
+  /* report cost of each global node numbering variant that has been run */
+  const char *connectNodesNames[2] = {"halo", "sort"};
+  for(int v=MESH_CONNECT_NODES_HALO;v<=MESH_CONNECT_NODES_SORT;++v){
+    if(mesh->connectNodesRounds[v]>0){
+      double maxTime = 0;
+      MPI_Allreduce(mesh->connectNodesTime+v, &maxTime, 1, MPI_DOUBLE, MPI_MAX, mesh->comm);
+      if(rank==0)
+        printf("global node numbering (%s): %d rounds, %g s\n",
+               connectNodesNames[v], mesh->connectNodesRounds[v], maxTime);
+    }
+  }
+  fflush(stdout);
   
   free(comms);
 }
@@ -0,0 +1,616 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "meshProbe.h"
+
+#define MESH_PROBE_TOL 1e-8
+#define MESH_PROBE_MAX_NEWTON 32
+
+// element type from the mesh shape, mesh_t does not carry it
+static int meshProbeElementType(mesh_t *mesh){
+  if(mesh->dim==2 && mesh->Nverts==3) return TRIANGLES;
+  if(mesh->dim==2 && mesh->Nverts==4) return QUADRILATERALS;
+  if(mesh->dim==3 && mesh->Nverts==4 && mesh->Nfaces==4 &&
+     mesh->Np==(mesh->N+1)*(mesh->N+2)*(mesh->N+3)/6) return TETRAHEDRA;
+  if(mesh->dim==3 && mesh->Nverts==8) return HEXAHEDRA;
+  return 0;
+}
+
+// vertex shape functions of the straight sided element and their
+// derivatives dN[v*3+d] with respect to reference coordinate d
+static void meshProbeVertexShape(int elementType, const double *r, double *N, double *dN){
+
+  static const double qr[8] = {-1, 1, 1,-1,-1, 1, 1,-1};
+  static const double qs[8] = {-1,-1, 1, 1,-1,-1, 1, 1};
+  static const double qt[8] = {-1,-1,-1,-1, 1, 1, 1, 1};
+
+  for(int n=0;n<24;++n) dN[n] = 0;
+
+  switch(elementType){
+  case TRIANGLES:
+    N[0] = -0.5*(r[0]+r[1]); dN[0*3+0] = -0.5; dN[0*3+1] = -0.5;
+    N[1] =  0.5*(1+r[0]);    dN[1*3+0] =  0.5;
+    N[2] =  0.5*(1+r[1]);    dN[2*3+1] =  0.5;
+    break;
+  case TETRAHEDRA:
+    N[0] = -0.5*(1+r[0]+r[1]+r[2]); dN[0*3+0] = -0.5; dN[0*3+1] = -0.5; dN[0*3+2] = -0.5;
+    N[1] =  0.5*(1+r[0]);           dN[1*3+0] =  0.5;
+    N[2] =  0.5*(1+r[1]);           dN[2*3+1] =  0.5;
+    N[3] =  0.5*(1+r[2]);           dN[3*3+2] =  0.5;
+    break;
+  case QUADRILATERALS:
+    for(int v=0;v<4;++v){
+      const double a = 0.5*(1+qr[v]*r[0]), b = 0.5*(1+qs[v]*r[1]);
+      N[v] = a*b;
+      dN[v*3+0] = 0.5*qr[v]*b;
+      dN[v*3+1] = 0.5*qs[v]*a;
+    }
+    break;
+  case HEXAHEDRA:
+    for(int v=0;v<8;++v){
+      const double a = 0.5*(1+qr[v]*r[0]), b = 0.5*(1+qs[v]*r[1]), c = 0.5*(1+qt[v]*r[2]);
+      N[v] = a*b*c;
+      dN[v*3+0] = 0.5*qr[v]*b*c;
+      dN[v*3+1] = 0.5*qs[v]*a*c;
+      dN[v*3+2] = 0.5*qt[v]*a*b;
+    }
+    break;
+  }
+}
+
+static int meshProbeInside(int elementType, const double *r){
+  const double tol = MESH_PROBE_TOL;
+  switch(elementType){
+  case TRIANGLES:
+    return (r[0]>=-1-tol) && (r[1]>=-1-tol) && (r[0]+r[1]<=tol);
+  case TETRAHEDRA:
+    return (r[0]>=-1-tol) && (r[1]>=-1-tol) && (r[2]>=-1-tol) && (r[0]+r[1]+r[2]<=-1+tol);
+  case QUADRILATERALS:
+    return (fabs(r[0])<=1+tol) && (fabs(r[1])<=1+tol);
+  case HEXAHEDRA:
+    return (fabs(r[0])<=1+tol) && (fabs(r[1])<=1+tol) && (fabs(r[2])<=1+tol);
+  }
+  return 0;
+}
+
+// invert the vertex map of element e at point p with Newton, returns 1 if p is inside
+static int meshProbeInvertMap(mesh_t *mesh, int elementType, dlong e, const double *p, double *r){
+
+  const int dim = mesh->dim;
+  double N[8], dN[24];
+
+  r[0] = r[1] = r[2] = 0;
+  if(elementType==TRIANGLES)  r[0] = r[1] = -1./3.;
+  if(elementType==TETRAHEDRA) r[0] = r[1] = r[2] = -0.5;
+
+  for(int it=0;it<MESH_PROBE_MAX_NEWTON;++it){
+    meshProbeVertexShape(elementType, r, N, dN);
+
+    double res[3] = {-p[0], -p[1], -p[2]};
+    double J[3][3] = {{0,0,0},{0,0,0},{0,0,0}};
+    for(int v=0;v<mesh->Nverts;++v){
+      const dlong id = e*mesh->Nverts+v;
+      const double X[3] = {mesh->EX[id], mesh->EY[id], (dim==3) ? mesh->EZ[id] : 0.};
+      for(int i=0;i<dim;++i){
+        res[i] += N[v]*X[i];
+        for(int j=0;j<dim;++j) J[i][j] += X[i]*dN[v*3+j];
+      }
+    }
+
+    // dr = J^{-1} res by Cramer's rule
+    double dr[3] = {0,0,0};
+    if(dim==2){
+      const double det = J[0][0]*J[1][1] - J[0][1]*J[1][0];
+      if(det==0) return 0;
+      dr[0] = ( J[1][1]*res[0] - J[0][1]*res[1])/det;
+      dr[1] = (-J[1][0]*res[0] + J[0][0]*res[1])/det;
+    } else {
+      const double det = J[0][0]*(J[1][1]*J[2][2]-J[1][2]*J[2][1])
+                        -J[0][1]*(J[1][0]*J[2][2]-J[1][2]*J[2][0])
+                        +J[0][2]*(J[1][0]*J[2][1]-J[1][1]*J[2][0]);
+      if(det==0) return 0;
+      for(int j=0;j<3;++j){
+        double Jj[3][3];
+        for(int a=0;a<3;++a)
+          for(int b=0;b<3;++b)
+            Jj[a][b] = (b==j) ? res[a] : J[a][b];
+        dr[j] = (Jj[0][0]*(Jj[1][1]*Jj[2][2]-Jj[1][2]*Jj[2][1])
+                -Jj[0][1]*(Jj[1][0]*Jj[2][2]-Jj[1][2]*Jj[2][0])
+                +Jj[0][2]*(Jj[1][0]*Jj[2][1]-Jj[1][1]*Jj[2][0]))/det;
+      }
+    }
+
+    double norm = 0;
+    for(int d=0;d<dim;++d){
+      r[d] -= dr[d];
+      norm += dr[d]*dr[d];
+    }
+
+    if(norm<1e-24) break;
+    if(fabs(r[0])+fabs(r[1])+fabs(r[2])>10) return 0; // far outside, stop early
+  }
+
+  return meshProbeInside(elementType, r);
+}
+
+// Jacobi polynomial P_n^{(alpha,0)}(x), unnormalized
+static double meshProbeJacobi(double x, double alpha, int n){
+  double P0 = 1, P1 = 0.5*(alpha + (alpha+2)*x);
+  if(n==0) return P0;
+  for(int k=2;k<=n;++k){
+    const double c = 2*k+alpha;
+    const double P2 = ((c-1)*(c*(c-2)*x + alpha*alpha)*P1 - 2*(k+alpha-1)*(k-1)*c*P0)/(2*k*(k+alpha)*(c-2));
+    P0 = P1; P1 = P2;
+  }
+  return P1;
+}
+
+// modal basis spanning P_N on simplices (collapsed coordinates) or Q_N on
+// quads and hexes, evaluated at reference point r
+static void meshProbeModes(mesh_t *mesh, int elementType, const double *r, double *phi){
+
+  const int N = mesh->N;
+  int sk = 0;
+
+  if(elementType==TRIANGLES){
+    const double a = (fabs(1-r[1])>1e-12) ? 2*(1+r[0])/(1-r[1])-1 : -1;
+    const double b = r[1];
+    for(int i=0;i<=N;++i)
+      for(int j=0;j<=N-i;++j)
+        phi[sk++] = meshProbeJacobi(a,0,i)*meshProbeJacobi(b,2*i+1,j)*pow(0.5*(1-b),i);
+  }
+  if(elementType==TETRAHEDRA){
+    const double a = (fabs(r[1]+r[2])>1e-12) ? 2*(1+r[0])/(-r[1]-r[2])-1 : -1;
+    const double b = (fabs(1-r[2])>1e-12) ? 2*(1+r[1])/(1-r[2])-1 : -1;
+    const double c = r[2];
+    for(int i=0;i<=N;++i)
+      for(int j=0;j<=N-i;++j)
+        for(int k=0;k<=N-i-j;++k)
+          phi[sk++] = meshProbeJacobi(a,0,i)
+            *meshProbeJacobi(b,2*i+1,j)*pow(0.5*(1-b),i)
+            *meshProbeJacobi(c,2*i+2*j+2,k)*pow(0.5*(1-c),i+j);
+  }
+  if(elementType==QUADRILATERALS)
+    for(int j=0;j<=N;++j)
+      for(int i=0;i<=N;++i)
+        phi[sk++] = meshProbeJacobi(r[0],0,i)*meshProbeJacobi(r[1],0,j);
+  if(elementType==HEXAHEDRA)
+    for(int k=0;k<=N;++k)
+      for(int j=0;j<=N;++j)
+        for(int i=0;i<=N;++i)
+          phi[sk++] = meshProbeJacobi(r[0],0,i)*meshProbeJacobi(r[1],0,j)*meshProbeJacobi(r[2],0,k);
+}
+
+// LU factorization with partial pivoting of the n x n matrix A in place
+static void meshProbeLU(int n, double *A, int *piv){
+  for(int k=0;k<n;++k){
+    int p = k;
+    for(int i=k+1;i<n;++i)
+      if(fabs(A[i*n+k])>fabs(A[p*n+k])) p = i;
+    piv[k] = p;
+    if(p!=k)
+      for(int j=0;j<n;++j){ double tmp = A[k*n+j]; A[k*n+j] = A[p*n+j]; A[p*n+j] = tmp; }
+    for(int i=k+1;i<n;++i){
+      A[i*n+k] /= A[k*n+k];
+      for(int j=k+1;j<n;++j) A[i*n+j] -= A[i*n+k]*A[k*n+j];
+    }
+  }
+}
+
+static void meshProbeLUSolve(int n, const double *A, const int *piv, double *b){
+  for(int k=0;k<n;++k)
+    if(piv[k]!=k){ double tmp = b[k]; b[k] = b[piv[k]]; b[piv[k]] = tmp; }
+  for(int k=0;k<n;++k)
+    for(int i=k+1;i<n;++i) b[i] -= A[i*n+k]*b[k];
+  for(int k=n-1;k>=0;--k){
+    for(int j=k+1;j<n;++j) b[k] -= A[k*n+j]*b[j];
+    b[k] /= A[k*n+k];
+  }
+}
+
+// read the probe coordinates on rank 0 and broadcast them, 3 per probe
+static dfloat *meshProbeRead(mesh_t *mesh, const char *probeFileName, dlong *Nprobes){
+
+  dfloat *xyz = NULL;
+  dlong Np = 0;
+
+  if(mesh->rank==0){
+    FILE *fp = fopen(probeFileName, "r");
+    if(!fp){
+      printf("meshProbeSetup: cannot open probe file %s\n", probeFileName);
+    } else {
+      char buf[BUFSIZ];
+      dlong maxNp = 0;
+      while(fgets(buf, BUFSIZ, fp)){
+        double x = 0, y = 0, z = 0;
+        if(buf[0]=='#' || sscanf(buf, "%lf %lf %lf", &x, &y, &z)<mesh->dim) continue;
+        if(Np==maxNp){
+          maxNp = 2*maxNp+16;
+          xyz = (dfloat*) realloc(xyz, 3*maxNp*sizeof(dfloat));
+        }
+        xyz[3*Np+0] = x; xyz[3*Np+1] = y; xyz[3*Np+2] = z;
+        ++Np;
+      }
+      fclose(fp);
+    }
+  }
+
+  MPI_Bcast(&Np, 1, MPI_DLONG, 0, mesh->comm);
+  if(mesh->rank) xyz = (dfloat*) calloc(3*Np+1, sizeof(dfloat));
+  if(Np) MPI_Bcast(xyz, 3*Np, MPI_DFLOAT, 0, mesh->comm);
+
+  *Nprobes = Np;
+  return xyz;
+}
+
+static void *meshProbeWriteThread(void *args){
+
+  meshProbe_t *probe = (meshProbe_t *) args;
+
+  FILE *fp = fopen(probe->fileName, "a");
+  if(!fp) return NULL;
+
+  for(int s=0;s<probe->Nbatch;++s){
+    fprintf(fp, "%.8e", probe->batchTimes[s]);
+    for(dlong k=0;k<probe->Nfound;++k){
+      const int r = probe->outputRanks[k];
+      const dlong Nr = probe->counts[r]/probe->Nfields;
+      const dfloat *sample = probe->batchSamples + probe->Nbatch*probe->displacements[r]
+                             + (s*Nr + probe->outputOffsets[k])*probe->Nfields;
+      for(int f=0;f<probe->Nfields;++f)
+        fprintf(fp, " %.8e", sample[f]);
+    }
+    fprintf(fp, "\n");
+  }
+  fclose(fp);
+
+  return NULL;
+}
+
+meshProbe_t *meshProbeSetup(mesh_t *mesh, const char *probeFileName, int Nfields, int Nbuffer,
+                            const char *outputFileName, occa::properties &kernelInfo){
+
+  meshProbe_t *probe = (meshProbe_t *) calloc(1, sizeof(meshProbe_t));
+
+  probe->mesh = mesh;
+  probe->Nfields = Nfields;
+  probe->Nbuffer = mymax(Nbuffer, 1);
+  strcpy(probe->fileName, outputFileName);
+
+  const int elementType = meshProbeElementType(mesh);
+  if(!elementType && mesh->rank==0)
+    printf("meshProbeSetup: unsupported element type, no probes located\n");
+
+  dfloat *xyz = meshProbeRead(mesh, probeFileName, &probe->Nprobes);
+  const dlong Nprobes = probe->Nprobes;
+
+  // bin index over the local element bounding boxes
+  const int dim = mesh->dim;
+  dfloat *EXYZ[3] = {mesh->EX, mesh->EY, mesh->EZ};
+
+  double bmin[3] = {0,0,0}, bmax[3] = {0,0,0};
+  for(int d=0;d<dim;++d){ bmin[d] = 1e300; bmax[d] = -1e300; }
+  for(dlong n=0;n<mesh->Nelements*mesh->Nverts;++n){
+    for(int d=0;d<dim;++d){
+      bmin[d] = mymin(bmin[d], EXYZ[d][n]);
+      bmax[d] = mymax(bmax[d], EXYZ[d][n]);
+    }
+  }
+
+  int Nbins[3] = {1,1,1};
+  double h[3] = {1,1,1};
+  const int nb = mymax(1, (int) ceil(pow((double) mesh->Nelements, 1./dim)));
+  for(int d=0;d<dim;++d){
+    const double pad = MESH_PROBE_TOL*mymax(bmax[d]-bmin[d], 1.);
+    bmin[d] -= pad; bmax[d] += pad;
+    Nbins[d] = nb;
+    h[d] = (bmax[d]-bmin[d])/nb;
+  }
+  const dlong NbinsTotal = (dlong) Nbins[0]*Nbins[1]*Nbins[2];
+
+  double *boxes = (double*) calloc(6*mesh->Nelements+1, sizeof(double));
+  int *binRange = (int*) calloc(6*mesh->Nelements+1, sizeof(int));
+  dlong *binStarts = (dlong*) calloc(NbinsTotal+1, sizeof(dlong));
+
+  for(dlong e=0;e<mesh->Nelements;++e){
+    double *box = boxes+6*e;
+    int *range = binRange+6*e;
+    for(int d=0;d<dim;++d){
+      box[d] = 1e300; box[3+d] = -1e300;
+      for(int v=0;v<mesh->Nverts;++v){
+        box[d]   = mymin(box[d],   EXYZ[d][e*mesh->Nverts+v]);
+        box[3+d] = mymax(box[3+d], EXYZ[d][e*mesh->Nverts+v]);
+      }
+      const double pad = MESH_PROBE_TOL*mymax(box[3+d]-box[d], 1e-12);
+      box[d] -= pad; box[3+d] += pad;
+      range[d]   = mymax(0,          (int) floor((box[d]  -bmin[d])/h[d]));
+      range[3+d] = mymin(Nbins[d]-1, (int) floor((box[3+d]-bmin[d])/h[d]));
+    }
+    for(int k=range[2];k<=range[5];++k)
+      for(int j=range[1];j<=range[4];++j)
+        for(int i=range[0];i<=range[3];++i)
+          ++binStarts[i + Nbins[0]*(j + Nbins[1]*k) + 1];
+  }
+  for(dlong b=0;b<NbinsTotal;++b) binStarts[b+1] += binStarts[b];
+
+  dlong *binElements = (dlong*) calloc(binStarts[NbinsTotal]+1, sizeof(dlong));
+  dlong *binFill = (dlong*) calloc(NbinsTotal+1, sizeof(dlong));
+  for(dlong e=0;e<mesh->Nelements;++e){
+    int *range = binRange+6*e;
+    for(int k=range[2];k<=range[5];++k)
+      for(int j=range[1];j<=range[4];++j)
+        for(int i=range[0];i<=range[3];++i){
+          const dlong b = i + Nbins[0]*(j + Nbins[1]*k);
+          binElements[binStarts[b] + binFill[b]++] = e;
+        }
+  }
+  free(binFill);
+  free(binRange);
+
+  // locate every probe in the local elements
+  dlong *probeElements = (dlong*) calloc(Nprobes+1, sizeof(dlong));
+  double *probeR = (double*) calloc(3*Nprobes+1, sizeof(double));
+  int *foundRank = (int*) calloc(Nprobes+1, sizeof(int));
+  int *ownerRank = (int*) calloc(Nprobes+1, sizeof(int));
+
+  for(dlong n=0;n<Nprobes;++n){
+    foundRank[n] = mesh->size;
+    if(!elementType || !mesh->Nelements) continue;
+
+    const double p[3] = {xyz[3*n+0], xyz[3*n+1], (dim==3) ? xyz[3*n+2] : 0.};
+
+    int ijk[3] = {0,0,0}, outside = 0;
+    for(int d=0;d<dim;++d){
+      if(p[d]<bmin[d] || p[d]>bmax[d]) outside = 1;
+      ijk[d] = mymin(Nbins[d]-1, mymax(0, (int) floor((p[d]-bmin[d])/h[d])));
+    }
+    if(outside) continue;
+
+    const dlong b = ijk[0] + Nbins[0]*(ijk[1] + Nbins[1]*ijk[2]);
+    for(dlong m=binStarts[b];m<binStarts[b+1];++m){
+      const dlong e = binElements[m];
+      const double *box = boxes+6*e;
+
+      int inBox = 1;
+      for(int d=0;d<dim;++d)
+        if(p[d]<box[d] || p[d]>box[3+d]) inBox = 0;
+
+      if(inBox && meshProbeInvertMap(mesh, elementType, e, p, probeR+3*n)){
+        probeElements[n] = e;
+        foundRank[n] = mesh->rank;
+        break;
+      }
+    }
+  }
+
+  free(boxes);
+  free(binStarts);
+  free(binElements);
+
+  // probes on shared faces belong to the lowest rank that found them
+  MPI_Allreduce(foundRank, ownerRank, Nprobes, MPI_INT, MPI_MIN, mesh->comm);
+
+  dlong Nmissing = 0;
+  for(dlong n=0;n<Nprobes;++n){
+    if(ownerRank[n]==mesh->size) ++Nmissing;
+    if(ownerRank[n]==mesh->rank) ++probe->Nlocal;
+  }
+  if(Nmissing && mesh->rank==0)
+    printf("meshProbeSetup: %d of %d probes are outside the mesh and ignored\n", (int) Nmissing, (int) Nprobes);
+
+  // interpolation weights: solve V^T I = phi(r) with V the modes at the element nodes
+  const int Np = mesh->Np;
+  probe->probeIds   = (dlong*)  calloc(probe->Nlocal+1, sizeof(dlong));
+  probe->elementIds = (dlong*)  calloc(probe->Nlocal+1, sizeof(dlong));
+  probe->interp          = (dfloat*) calloc(probe->Nlocal*Np+1, sizeof(dfloat));
+
+  if(probe->Nlocal){
+    double *VT = (double*) calloc(Np*Np, sizeof(double));
+    double *phi = (double*) calloc(Np, sizeof(double));
+    int *piv = (int*) calloc(Np, sizeof(int));
+
+    for(int n=0;n<Np;++n){
+      const double rn[3] = {mesh->r[n], mesh->s[n], (dim==3) ? mesh->t[n] : 0.};
+      meshProbeModes(mesh, elementType, rn, phi);
+      for(int j=0;j<Np;++j) VT[j*Np+n] = phi[j];
+    }
+    meshProbeLU(Np, VT, piv);
+
+    dlong cnt = 0;
+    for(dlong n=0;n<Nprobes;++n){
+      if(ownerRank[n]!=mesh->rank) continue;
+      meshProbeModes(mesh, elementType, probeR+3*n, phi);
+      meshProbeLUSolve(Np, VT, piv, phi);
+
+      probe->probeIds[cnt] = n;
+      probe->elementIds[cnt] = probeElements[n];
+      for(int m=0;m<Np;++m) probe->interp[cnt*Np+m] = phi[m];
+      ++cnt;
+    }
+
+    free(VT); free(phi); free(piv);
+  }
+
+  // rank 0 output order: gather the owned probe ids of every rank
+  probe->counts        = (int*) calloc(mesh->size, sizeof(int));
+  probe->displacements = (int*) calloc(mesh->size, sizeof(int));
+
+  int Nlocal = (int) probe->Nlocal;
+  MPI_Gather(&Nlocal, 1, MPI_INT, probe->counts, 1, MPI_INT, 0, mesh->comm);
+
+  dlong *gatheredIds = NULL;
+  if(mesh->rank==0){
+    for(int r=0;r<mesh->size;++r){
+      probe->Nfound += probe->counts[r];
+      if(r) probe->displacements[r] = probe->displacements[r-1] + probe->counts[r-1];
+    }
+    gatheredIds = (dlong*) calloc(probe->Nfound+1, sizeof(dlong));
+  }
+  MPI_Gatherv(probe->probeIds, Nlocal, MPI_DLONG,
+              gatheredIds, probe->counts, probe->displacements, MPI_DLONG, 0, mesh->comm);
+
+  if(mesh->rank==0){
+    int *located = (int*) calloc(Nprobes+1, sizeof(int));
+    dlong *foundRankOf = (dlong*) calloc(Nprobes+1, sizeof(dlong));
+    dlong *foundLocalOf = (dlong*) calloc(Nprobes+1, sizeof(dlong));
+    for(int r=0;r<mesh->size;++r)
+      for(int p=0;p<probe->counts[r];++p){
+        const dlong n = gatheredIds[probe->displacements[r]+p];
+        located[n] = 1;
+        foundRankOf[n] = r;
+        foundLocalOf[n] = p;
+      }
+
+    probe->outputRanks   = (dlong*) calloc(probe->Nfound+1, sizeof(dlong));
+    probe->outputOffsets = (dlong*) calloc(probe->Nfound+1, sizeof(dlong));
+
+    FILE *fp = fopen(probe->fileName, "w");
+    if(fp) fprintf(fp, "# time, then %d fields for each probe:\n", Nfields);
+
+    dlong k = 0;
+    for(dlong n=0;n<Nprobes;++n){
+      if(!located[n]) continue;
+      probe->outputRanks[k] = foundRankOf[n];
+      probe->outputOffsets[k] = foundLocalOf[n];
+      if(fp) fprintf(fp, "# probe %d: %.8e %.8e %.8e\n", (int) n, xyz[3*n+0], xyz[3*n+1], xyz[3*n+2]);
+      ++k;
+    }
+    if(fp) fclose(fp);
+
+    free(located); free(foundRankOf); free(foundLocalOf);
+    free(gatheredIds);
+
+    // the batch buffers hold Nbuffer samples of every rank
+    for(int r=0;r<mesh->size;++r){
+      probe->counts[r] *= Nfields;
+      probe->displacements[r] *= Nfields;
+    }
+    probe->batchTimes   = (dfloat*) calloc(probe->Nbuffer, sizeof(dfloat));
+    probe->batchSamples = (dfloat*) calloc(probe->Nbuffer*probe->Nfound*Nfields+1, sizeof(dfloat));
+  }
+
+  free(xyz);
+  free(probeElements);
+  free(probeR);
+  free(foundRank);
+  free(ownerRank);
+
+  probe->times        = (dfloat*) calloc(probe->Nbuffer, sizeof(dfloat));
+  probe->localSamples = (dfloat*) calloc(probe->Nbuffer*probe->Nlocal*Nfields+1, sizeof(dfloat));
+
+  probe->o_elementIds = mesh->device.malloc((probe->Nlocal+1)*sizeof(dlong), probe->elementIds);
+  probe->o_interp          = mesh->device.malloc((probe->Nlocal*Np+1)*sizeof(dfloat), probe->interp);
+  probe->o_samples    = mesh->device.malloc((probe->Nbuffer*probe->Nlocal*Nfields+1)*sizeof(dfloat));
+
+  occa::properties probeInfo = kernelInfo;
+  probeInfo["defines/" "p_blockSize"]= 256;
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      probe->interpolateKernel = mesh->device.buildKernel(DHOLMES "/okl/meshProbe.okl",
+                                                          "meshProbeInterpolate", probeInfo);
+    }
+    occaKernelBuildDone(mesh, r);
+  }
+
+  return probe;
+}
+
+void meshProbeSample(meshProbe_t *probe, dfloat time, occa::memory &o_q,
+                     dlong elementStride, dlong nodeStride, dlong fieldStride){
+
+  const dlong Nvalues = probe->Nlocal*probe->Nfields;
+
+  if(Nvalues)
+    probe->interpolateKernel(probe->Nlocal, probe->Nfields, elementStride, nodeStride, fieldStride,
+                             probe->o_elementIds, probe->o_interp, o_q,
+                             probe->o_samples + probe->Nsamples*Nvalues*sizeof(dfloat));
+
+  probe->times[probe->Nsamples++] = time;
+
+  if(probe->Nsamples==probe->Nbuffer)
+    meshProbeFlush(probe);
+}
+
+void meshProbeFlush(meshProbe_t *probe){
+
+  mesh_t *mesh = probe->mesh;
+
+  if(!probe->Nsamples) return;
+
+  // the writer still owns the previous batch
+  if(probe->writing){
+    pthread_join(probe->thread, NULL);
+    probe->writing = 0;
+  }
+
+  const int Nvalues = probe->Nsamples*probe->Nlocal*probe->Nfields;
+  if(Nvalues)
+    probe->o_samples.copyTo(probe->localSamples, Nvalues*sizeof(dfloat));
+
+  // every rank sends Nsamples x Nlocal x Nfields values
+  int *counts = NULL, *displacements = NULL;
+  if(mesh->rank==0){
+    counts        = (int*) calloc(mesh->size, sizeof(int));
+    displacements = (int*) calloc(mesh->size, sizeof(int));
+    for(int r=0;r<mesh->size;++r){
+      counts[r] = probe->Nsamples*probe->counts[r];
+      displacements[r] = probe->Nsamples*probe->displacements[r];
+    }
+  }
+  MPI_Gatherv(probe->localSamples, Nvalues, MPI_DFLOAT,
+              probe->batchSamples, counts, displacements, MPI_DFLOAT, 0, mesh->comm);
+
+  probe->Nbatch = probe->Nsamples;
+  probe->Nsamples = 0;
+
+  if(mesh->rank==0){
+    free(counts);
+    free(displacements);
+
+    memcpy(probe->batchTimes, probe->times, probe->Nbatch*sizeof(dfloat));
+    if(pthread_create(&probe->thread, NULL, meshProbeWriteThread, probe)){
+      meshProbeWriteThread(probe); // write in place if no thread is available
+      return;
+    }
+    probe->writing = 1;
+  }
+}
+
+void meshProbeFinish(meshProbe_t *probe){
+
+  meshProbeFlush(probe);
+
+  if(probe->writing){
+    pthread_join(probe->thread, NULL);
+    probe->writing = 0;
+  }
+}
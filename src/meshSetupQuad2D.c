@@ -37,9 +37,6 @@ mesh2D *meshSetupQuad2D(char *filename, int N){
   // connect elements using parallel sort
   meshParallelConnect(mesh);
 
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
-
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
   
@@ -63,6 +60,9 @@ mesh2D *meshSetupQuad2D(char *filename, int N){
   
   // global nodes
   meshParallelConnectNodes(mesh);
+
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
   
   // initialize LSERK4 time stepping coefficients
   int Nrk = 5;
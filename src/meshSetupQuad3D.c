@@ -41,9 +41,6 @@ mesh_t *meshSetupQuad3D(char *filename, int N, dfloat sphereRadius){
   meshParallelConnect(mesh);
 
 
-  
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
 
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
@@ -86,6 +83,9 @@ mesh_t *meshSetupQuad3D(char *filename, int N, dfloat sphereRadius){
   // global nodes
   meshParallelConnectNodes(mesh);
 
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
+
   // initialize LSERK4 time stepping coefficients
   int Nrk = 5;
 
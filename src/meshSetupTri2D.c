@@ -40,9 +40,6 @@ mesh2D *meshSetupTri2D(char *filename, int N){
   // connect elements using parallel sort
   meshParallelConnect(mesh);
 
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
-
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
 
@@ -66,6 +63,9 @@ mesh2D *meshSetupTri2D(char *filename, int N){
 
   // global nodes
   meshParallelConnectNodes(mesh);
+
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
   
 
   // initialize LSERK4 time stepping coefficients
@@ -40,9 +40,6 @@ mesh3D *meshSetupTri3D(char *filename, int N, double sphereRadius){
   // connect elements using parallel sort
   meshParallelConnect(mesh);
 
-  // print out connectivity statistics
-  meshPartitionStatistics(mesh);
-
   // connect elements to boundary faces
   meshConnectBoundary(mesh);
 
@@ -68,6 +65,9 @@ mesh3D *meshSetupTri3D(char *filename, int N, double sphereRadius){
   // global nodes
   meshParallelConnectNodes(mesh);
 
+  // print out connectivity statistics
+  meshPartitionStatistics(mesh);
+
   // initialize LSERK4 time stepping coefficients
   int Nrk = 5;
 
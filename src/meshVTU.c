@@ -0,0 +1,315 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "meshVTU.h"
+
+static const char *meshVTUByteOrder(){
+  const int one = 1;
+  return (*(const char *) &one) ? "LittleEndian" : "BigEndian";
+}
+
+static const char b64Table[] =
+  "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// base64 encode bytes to fp, returns number of characters written
+static size_t meshVTUBase64(FILE *fp, const void *data, size_t bytes){
+
+  const unsigned char *c = (const unsigned char *) data;
+  char buf[4*1024];
+  size_t Nchars = 0, cnt = 0;
+
+  for (size_t n=0;n<bytes;n+=3) {
+    const unsigned int b0 = c[n];
+    const unsigned int b1 = (n+1<bytes) ? c[n+1] : 0;
+    const unsigned int b2 = (n+2<bytes) ? c[n+2] : 0;
+
+    buf[cnt++] = b64Table[b0>>2];
+    buf[cnt++] = b64Table[((b0&3)<<4)|(b1>>4)];
+    buf[cnt++] = (n+1<bytes) ? b64Table[((b1&15)<<2)|(b2>>6)] : '=';
+    buf[cnt++] = (n+2<bytes) ? b64Table[b2&63] : '=';
+
+    if (cnt==sizeof(buf)) {
+      fwrite(buf, 1, cnt, fp);
+      Nchars += cnt; cnt = 0;
+    }
+  }
+  fwrite(buf, 1, cnt, fp);
+  return Nchars + cnt;
+}
+
+// size in the appended section of a block of bytes (UInt64 length header and data)
+static size_t meshVTUBlockSize(meshVTU_t *vtu, size_t bytes){
+  if (vtu->base64)
+    return 4*((sizeof(uint64_t)+2)/3) + 4*((bytes+2)/3);
+  else
+    return sizeof(uint64_t) + bytes;
+}
+
+static void meshVTUBlock(meshVTU_t *vtu, FILE *fp, const void *data, size_t bytes){
+  const uint64_t header = bytes;
+  if (vtu->base64) {
+    meshVTUBase64(fp, &header, sizeof(uint64_t));
+    meshVTUBase64(fp, data, bytes);
+  } else {
+    fwrite(&header, sizeof(uint64_t), 1, fp);
+    fwrite(data, 1, bytes, fp);
+  }
+}
+
+// strip the directory so the .pvtu refers to pieces next to it
+static const char *meshVTUBaseName(const char *fileName){
+  const char *slash = strrchr(fileName, '/');
+  return slash ? slash+1 : fileName;
+}
+
+static void meshVTUWritePiece(meshVTU_t *vtu){
+
+  mesh_t *mesh = vtu->mesh;
+
+  char fileName[BUFSIZ];
+  sprintf(fileName, "%s_%04d_%04d.vtu", vtu->fileBase, mesh->rank, vtu->frame);
+
+  FILE *fp = fopen(fileName, "w");
+  if (fp==NULL) {
+    printf("Rank %d: could not write %s\n", mesh->rank, fileName);
+    return;
+  }
+
+  const size_t Npoints = vtu->Npoints, Ncells = vtu->Ncells;
+
+  fprintf(fp, "<?xml version=\"1.0\"?>\n");
+  fprintf(fp, "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", meshVTUByteOrder());
+  fprintf(fp, "  <UnstructuredGrid>\n");
+  fprintf(fp, "    <Piece NumberOfPoints=\"%zu\" NumberOfCells=\"%zu\">\n", Npoints, Ncells);
+
+  size_t offset = 0;
+
+  fprintf(fp, "      <PointData>\n");
+  for (int f=0;f<vtu->Nfields;f++) {
+    fprintf(fp, "        <DataArray type=\"Float32\" Name=\"%s\" NumberOfComponents=\"%d\" format=\"appended\" offset=\"%zu\"/>\n",
+            vtu->fields[f].name, vtu->fields[f].Ncomponents, offset);
+    offset += meshVTUBlockSize(vtu, vtu->fields[f].Ncomponents*Npoints*sizeof(float));
+  }
+  fprintf(fp, "      </PointData>\n");
+
+  fprintf(fp, "      <Points>\n");
+  fprintf(fp, "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" format=\"appended\" offset=\"%zu\"/>\n", offset);
+  offset += meshVTUBlockSize(vtu, 3*Npoints*sizeof(float));
+  fprintf(fp, "      </Points>\n");
+
+  fprintf(fp, "      <Cells>\n");
+  fprintf(fp, "        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"%zu\"/>\n", offset);
+  offset += meshVTUBlockSize(vtu, mesh->plotNverts*Ncells*sizeof(int));
+  fprintf(fp, "        <DataArray type=\"Int32\" Name=\"offsets\" format=\"appended\" offset=\"%zu\"/>\n", offset);
+  offset += meshVTUBlockSize(vtu, Ncells*sizeof(int));
+  fprintf(fp, "        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"%zu\"/>\n", offset);
+  fprintf(fp, "      </Cells>\n");
+
+  fprintf(fp, "    </Piece>\n");
+  fprintf(fp, "  </UnstructuredGrid>\n");
+  fprintf(fp, "  <AppendedData encoding=\"%s\">\n", vtu->base64 ? "base64" : "raw");
+  fprintf(fp, "_");
+
+  for (int f=0;f<vtu->Nfields;f++)
+    meshVTUBlock(vtu, fp, vtu->fields[f].plotq, vtu->fields[f].Ncomponents*Npoints*sizeof(float));
+  meshVTUBlock(vtu, fp, vtu->points, 3*Npoints*sizeof(float));
+  meshVTUBlock(vtu, fp, vtu->connectivity, mesh->plotNverts*Ncells*sizeof(int));
+  meshVTUBlock(vtu, fp, vtu->offsets, Ncells*sizeof(int));
+  meshVTUBlock(vtu, fp, vtu->types, Ncells*sizeof(unsigned char));
+
+  fprintf(fp, "\n  </AppendedData>\n");
+  fprintf(fp, "</VTKFile>\n");
+  fclose(fp);
+}
+
+static void meshVTUWriteIndex(meshVTU_t *vtu){
+
+  mesh_t *mesh = vtu->mesh;
+
+  char fileName[BUFSIZ];
+  sprintf(fileName, "%s_%04d.pvtu", vtu->fileBase, vtu->frame);
+
+  FILE *fp = fopen(fileName, "w");
+  if (fp==NULL) {
+    printf("Rank %d: could not write %s\n", mesh->rank, fileName);
+    return;
+  }
+
+  fprintf(fp, "<?xml version=\"1.0\"?>\n");
+  fprintf(fp, "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n", meshVTUByteOrder());
+  fprintf(fp, "  <PUnstructuredGrid GhostLevel=\"0\">\n");
+  fprintf(fp, "    <PPointData>\n");
+  for (int f=0;f<vtu->Nfields;f++)
+    fprintf(fp, "      <PDataArray type=\"Float32\" Name=\"%s\" NumberOfComponents=\"%d\"/>\n",
+            vtu->fields[f].name, vtu->fields[f].Ncomponents);
+  fprintf(fp, "    </PPointData>\n");
+  fprintf(fp, "    <PPoints>\n");
+  fprintf(fp, "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n");
+  fprintf(fp, "    </PPoints>\n");
+  for (int r=0;r<mesh->size;r++)
+    fprintf(fp, "    <Piece Source=\"%s_%04d_%04d.vtu\"/>\n", meshVTUBaseName(vtu->fileBase), r, vtu->frame);
+  fprintf(fp, "  </PUnstructuredGrid>\n");
+  fprintf(fp, "</VTKFile>\n");
+  fclose(fp);
+}
+
+static void *meshVTUWriteThread(void *args){
+
+  meshVTU_t *vtu = (meshVTU_t *) args;
+
+  meshVTUWritePiece(vtu);
+  if (vtu->mesh->rank==0) meshVTUWriteIndex(vtu);
+
+  return NULL;
+}
+
+meshVTU_t *meshVTUSetup(mesh_t *mesh, setupAide &options, occa::properties &kernelInfo){
+
+  meshVTU_t *vtu = (meshVTU_t *) calloc(1, sizeof(meshVTU_t));
+
+  vtu->mesh = mesh;
+  vtu->base64 = options.compareArgs("OUTPUT VTU FORMAT", "BASE64");
+
+  vtu->Npoints = mesh->Nelements*mesh->plotNp;
+  vtu->Ncells  = mesh->Nelements*mesh->plotNelements;
+
+  // node fastest, as in the iso-surface kernels
+  dfloat *plotInterp = (dfloat*) calloc(mesh->plotNp*mesh->Np, sizeof(dfloat));
+  for(int n=0;n<mesh->plotNp;++n){
+    for(int m=0;m<mesh->Np;++m){
+      plotInterp[n+m*mesh->plotNp] = mesh->plotInterp[n*mesh->Np+m];
+    }
+  }
+  vtu->o_plotInterp = mesh->device.malloc(mesh->plotNp*mesh->Np*sizeof(dfloat), plotInterp);
+  free(plotInterp);
+
+  if (vtu->Npoints)
+    vtu->o_plotq = mesh->device.malloc(3*vtu->Npoints*sizeof(float));
+
+  occa::properties plotInfo = kernelInfo;
+  plotInfo["defines/" "p_plotNp"]= mesh->plotNp;
+  plotInfo["defines/" "p_plotNcomponents"]= 3;
+  plotInfo["defines/" "p_plotNthreads"]= mymax(mesh->Np, mesh->plotNp);
+
+  for (int r=0;r<occaKernelBuildRounds;r++) {
+    if (occaKernelBuildTurn(mesh, r)) {
+      vtu->plotInterpKernel = mesh->device.buildKernel(DHOLMES "/okl/meshPlotInterp.okl",
+                                                       "meshPlotInterp", plotInfo);
+    }
+    occaKernelBuildDone(mesh, r);
+  }
+
+  // plot node coordinates
+  vtu->points = (float *) calloc(3*vtu->Npoints+1, sizeof(float));
+  float *xyz = (float *) calloc(vtu->Npoints+1, sizeof(float));
+  occa::memory o_xyz[3] = {mesh->o_x, mesh->o_y, mesh->o_z};
+  for (int d=0;d<mesh->dim;d++) { // z stays zero in 2D
+    if (!vtu->Npoints) break;
+    vtu->plotInterpKernel(mesh->Nelements, 0, 1, (dlong) mesh->Np, (dlong) 1, (dlong) 0, -1, (dfloat) 1.0,
+                          vtu->o_plotInterp, o_xyz[d], vtu->o_plotq);
+    vtu->o_plotq.copyTo(xyz, vtu->Npoints*sizeof(float));
+    for (dlong n=0;n<vtu->Npoints;n++)
+      vtu->points[3*n+d] = xyz[n];
+  }
+  free(xyz);
+
+  // plot cells, triangles in 2D and tets in 3D
+  vtu->connectivity = (int *) calloc(mesh->plotNverts*vtu->Ncells+1, sizeof(int));
+  vtu->offsets      = (int *) calloc(vtu->Ncells+1, sizeof(int));
+  vtu->types        = (unsigned char *) calloc(vtu->Ncells+1, sizeof(unsigned char));
+
+  dlong cnt = 0;
+  for(dlong e=0;e<mesh->Nelements;++e){
+    for(int n=0;n<mesh->plotNelements;++n){
+      const dlong c = e*mesh->plotNelements + n;
+      for(int m=0;m<mesh->plotNverts;++m)
+        vtu->connectivity[cnt++] = e*mesh->plotNp + mesh->plotEToV[n*mesh->plotNverts+m];
+      vtu->offsets[c] = cnt;
+      vtu->types[c] = (mesh->plotNverts==3) ? 5 : 10;
+    }
+  }
+
+  return vtu;
+}
+
+void meshVTUBegin(meshVTU_t *vtu, const char *fileBase, int frame){
+
+  // the staging buffers are reused
+  meshVTUFinish(vtu);
+
+  strcpy(vtu->fileBase, fileBase);
+  vtu->frame = frame;
+  vtu->Nfields = 0;
+}
+
+void meshVTUAddField(meshVTU_t *vtu, const char *name, occa::memory &o_q,
+                     int firstField, int Ncomponents,
+                     dlong elementStride, dlong nodeStride, dlong fieldStride,
+                     int denominator, dfloat scale){
+
+  mesh_t *mesh = vtu->mesh;
+
+  if ((vtu->Nfields==MESH_VTU_MAX_FIELDS)||(Ncomponents>3)) {
+    if (mesh->rank==0) printf("meshVTUAddField: cannot add field %s\n", name);
+    return;
+  }
+
+  meshVTUField_t *field = vtu->fields + vtu->Nfields++;
+
+  strcpy(field->name, name);
+  field->Ncomponents = Ncomponents;
+  if (!field->plotq)
+    field->plotq = (float *) calloc(3*vtu->Npoints+1, sizeof(float));
+
+  if (vtu->Npoints) {
+    vtu->plotInterpKernel(mesh->Nelements, firstField, Ncomponents,
+                          elementStride, nodeStride, fieldStride, denominator, scale,
+                          vtu->o_plotInterp, o_q, vtu->o_plotq);
+    vtu->o_plotq.copyTo(field->plotq, Ncomponents*vtu->Npoints*sizeof(float));
+  }
+}
+
+void meshVTUWrite(meshVTU_t *vtu){
+
+  if (pthread_create(&vtu->thread, NULL, meshVTUWriteThread, vtu)) {
+    meshVTUWriteThread(vtu); // write in place if no thread is available
+    return;
+  }
+  vtu->writing = 1;
+}
+
+void meshVTUFinish(meshVTU_t *vtu){
+
+  if (vtu->writing) {
+    pthread_join(vtu->thread, NULL);
+    vtu->writing = 0;
+  }
+}
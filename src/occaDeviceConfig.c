@@ -107,5 +107,7 @@ void occaDeviceConfig(mesh_t *mesh, setupAide &options){
   
   mesh->device.setup(deviceConfig);
 
+  occaKernelBuildSetup(mesh, options);
+
   occa::initTimer(mesh->device);
 }
@@ -0,0 +1,98 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "mpi.h"
+#include "mesh.h"
+
+// Kernels are built in two rounds. In round 0 the build ranks (rank 0, or the
+// first rank on each node when the OCCA cache is node local) compile every
+// kernel into the OCCA cache. In round 1 all other ranks build the same
+// kernels, which OCCA finds in the cache and only loads.
+
+static int    kernelBuilder = -1;   // 1 if this rank compiles in round 0
+static double kernelBuildTic = 0;
+static double kernelCompileTime = 0;
+static double kernelLoadTime = 0;
+
+void occaKernelBuildSetup(mesh_t *mesh, setupAide &options){
+
+  int localRank = mesh->rank;
+
+  if (options.compareArgs("KERNEL CACHE", "NODE")) {
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(mesh->comm, MPI_COMM_TYPE_SHARED, mesh->rank,
+                        MPI_INFO_NULL, &nodeComm);
+    MPI_Comm_rank(nodeComm, &localRank);
+    MPI_Comm_free(&nodeComm);
+  }
+
+  kernelBuilder = (localRank==0);
+}
+
+int occaKernelBuildTurn(mesh_t *mesh, int round){
+
+  if (kernelBuilder<0) kernelBuilder = (mesh->rank==0);
+
+  int turn = (round==0) ? kernelBuilder : !kernelBuilder;
+
+  if (turn) kernelBuildTic = MPI_Wtime();
+
+  return turn;
+}
+
+void occaKernelBuildDone(mesh_t *mesh, int round){
+
+  if ((round==0) == (kernelBuilder==1)) {
+    double elapsed = MPI_Wtime() - kernelBuildTic;
+    if (round==0) kernelCompileTime += elapsed;
+    else          kernelLoadTime += elapsed;
+  }
+
+  MPI_Barrier(mesh->comm);
+}
+
+void occaKernelBuildReport(mesh_t *mesh){
+
+  double compileMax, loadMax, loadSum;
+  int Nbuilders;
+
+  MPI_Reduce(&kernelCompileTime, &compileMax, 1, MPI_DOUBLE, MPI_MAX, 0, mesh->comm);
+  MPI_Reduce(&kernelLoadTime,    &loadMax,    1, MPI_DOUBLE, MPI_MAX, 0, mesh->comm);
+  MPI_Reduce(&kernelLoadTime,    &loadSum,    1, MPI_DOUBLE, MPI_SUM, 0, mesh->comm);
+
+  int builder = (kernelBuilder==1);
+  MPI_Reduce(&builder, &Nbuilders, 1, MPI_INT, MPI_SUM, 0, mesh->comm);
+
+  if (mesh->rank==0) {
+    int Nloaders = mesh->size - Nbuilders;
+    printf("Kernel build: compile %g s on %d rank(s), load %g s max / %g s avg on %d rank(s)\n",
+           compileMax, Nbuilders,
+           loadMax, (Nloaders) ? loadSum/Nloaders : 0., Nloaders);
+  }
+}
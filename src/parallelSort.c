@@ -75,8 +75,9 @@ void mergeLists(size_t sz,
   memcpy(v2, v3+sz*N1, N2*sz);
 }
 
+// odd-even merge sort, O(size) rounds of neighbor exchanges
 // assumes N is even and the same on all ranks
-void parallelSort(int size, int rank, MPI_Comm comm,
+void parallelOddEvenSort(int size, int rank, MPI_Comm comm,
 		  int N, void *vv, size_t sz,
 		  int (*compare)(const void *, const void *),
 		  void (*match)(void *, void *)
@@ -147,3 +148,148 @@ void parallelSort(int size, int rank, MPI_Comm comm,
   free(tmp);
   free(A);
 }
+
+// number of regular samples each rank contributes to the splitter selection
+#define parallelSortSamples 64
+
+// index of the first entry in the sorted list v that is greater than key
+static int upperBound(size_t sz, int N, char *v, char *key,
+		      int (*compare)(const void *, const void *)){
+
+  int lo = 0, hi = N;
+  while(lo<hi){
+    int mid = (lo+hi)/2;
+    if(compare(v+mid*sz, key)>0)
+      hi = mid;
+    else
+      lo = mid+1;
+  }
+  return lo;
+}
+
+// sample sort: splitters chosen from regular samples of the locally sorted
+// lists send every entry to its bucket in one MPI_Alltoallv. A second
+// exchange then hands each rank back exactly N consecutive entries.
+// Equal entries always share a bucket, so match sees all of them.
+// assumes N is the same on all ranks
+void parallelSort(int size, int rank, MPI_Comm comm,
+		  int N, void *vv, size_t sz,
+		  int (*compare)(const void *, const void *),
+		  void (*match)(void *, void *)
+		  ){
+
+  /* cast void * to char * */
+  char *v = (char*) vv;
+
+  /* sort local entries */
+  qsort(v, N, sz, compare);
+
+  if(size==1){
+    for(int n=0;n<N-1;++n)
+      if(!compare(v+n*sz, v+(n+1)*sz))
+	match(v+n*sz, v+(n+1)*sz);
+    return;
+  }
+
+  /* move whole capsules, counted in entries rather than bytes */
+  MPI_Datatype MPI_ENTRY_T;
+  MPI_Type_contiguous((int) sz, MPI_CHAR, &MPI_ENTRY_T);
+  MPI_Type_commit(&MPI_ENTRY_T);
+
+  /* regular samples of the local list */
+  int Nsamples = mymin(size-1, parallelSortSamples);
+  Nsamples = mymin(Nsamples, N);
+
+  char *samples = (char*) calloc(Nsamples+1, sz);
+  for(int s=0;s<Nsamples;++s)
+    memcpy(samples+s*sz, v+(((long long int)(s+1))*N/(Nsamples+1))*sz, sz);
+
+  /* rank 0 sorts all samples and picks size-1 evenly spaced splitters */
+  int *sampleCounts = (int*) calloc(size, sizeof(int));
+  int *sampleOffsets = (int*) calloc(size+1, sizeof(int));
+  MPI_Gather(&Nsamples, 1, MPI_INT, sampleCounts, 1, MPI_INT, 0, comm);
+
+  for(int r=0;r<size;++r)
+    sampleOffsets[r+1] = sampleOffsets[r] + sampleCounts[r];
+
+  int NallSamples = sampleOffsets[size];
+  char *allSamples = (rank==0) ? (char*) calloc(NallSamples+1, sz) : NULL;
+
+  MPI_Gatherv(samples, Nsamples, MPI_ENTRY_T,
+	      allSamples, sampleCounts, sampleOffsets, MPI_ENTRY_T, 0, comm);
+
+  char *splitters = (char*) calloc(size-1, sz);
+  if(rank==0 && NallSamples){
+    qsort(allSamples, NallSamples, sz, compare);
+    for(int r=0;r<size-1;++r){
+      long long int s = (((long long int)(r+1))*NallSamples)/size;
+      memcpy(splitters+r*sz, allSamples+mymin(s, NallSamples-1)*sz, sz);
+    }
+  }
+  if(rank==0) free(allSamples);
+  MPI_Bcast(splitters, size-1, MPI_ENTRY_T, 0, comm);
+
+  /* bucket r takes the entries after splitter r-1, up to and including splitter r */
+  int *sendCounts  = (int*) calloc(size, sizeof(int));
+  int *recvCounts  = (int*) calloc(size, sizeof(int));
+  int *sendOffsets = (int*) calloc(size+1, sizeof(int));
+  int *recvOffsets = (int*) calloc(size+1, sizeof(int));
+
+  for(int r=0;r<size-1;++r)
+    sendOffsets[r+1] = upperBound(sz, N, v, splitters+r*sz, compare);
+  sendOffsets[size] = N;
+
+  for(int r=0;r<size;++r)
+    sendCounts[r] = sendOffsets[r+1]-sendOffsets[r];
+
+  MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);
+
+  for(int r=0;r<size;++r)
+    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+
+  int Nbucket = recvOffsets[size];
+  char *bucket = (char*) calloc(Nbucket+1, sz);
+
+  MPI_Alltoallv(v, sendCounts, sendOffsets, MPI_ENTRY_T,
+		bucket, recvCounts, recvOffsets, MPI_ENTRY_T, comm);
+
+  /* the incoming runs are sorted, but qsort is simpler than a size-way merge */
+  qsort(bucket, Nbucket, sz, compare);
+
+  for(int n=0;n<Nbucket-1;++n)
+    if(!compare(bucket+n*sz, bucket+(n+1)*sz))
+      match(bucket+n*sz, bucket+(n+1)*sz);
+
+  /* rebalance: global entry g goes to rank g/N */
+  long long int localCount = Nbucket, start = 0;
+  MPI_Exscan(&localCount, &start, 1, MPI_LONG_LONG_INT, MPI_SUM, comm);
+  if(rank==0) start = 0;
+
+  for(int r=0;r<size;++r){
+    long long int lo = mymax(start, ((long long int) r)*N);
+    long long int hi = mymin(start+Nbucket, ((long long int) r+1)*N);
+    sendCounts[r]  = (int) mymax(hi-lo, 0);
+    sendOffsets[r] = (int) mymin(mymax(((long long int) r)*N - start, 0), Nbucket);
+  }
+
+  MPI_Alltoall(sendCounts, 1, MPI_INT, recvCounts, 1, MPI_INT, comm);
+
+  recvOffsets[0] = 0;
+  for(int r=0;r<size;++r)
+    recvOffsets[r+1] = recvOffsets[r] + recvCounts[r];
+
+  MPI_Alltoallv(bucket, sendCounts, sendOffsets, MPI_ENTRY_T,
+		v, recvCounts, recvOffsets, MPI_ENTRY_T, comm);
+
+  MPI_Type_free(&MPI_ENTRY_T);
+
+  free(samples);
+  free(sampleCounts);
+  free(sampleOffsets);
+  free(splitters);
+  free(sendCounts);
+  free(recvCounts);
+  free(sendOffsets);
+  free(recvOffsets);
+  free(bucket);
+}
@@ -26,8 +26,69 @@ SOFTWARE.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "mesh.h"
 
+typedef struct {
+  char fileName[BUFSIZ];
+  char *data;
+  long bytes;
+} referenceFile_t;
+
+static int NreferenceFiles = 0;
+static referenceFile_t *referenceFiles = NULL;
+
+// Rank 0 of comm reads each reference node file once and broadcasts it. The
+// contents stay cached, so the multigrid levels and patch setups that load the
+// same degree again never touch the file system. The first open of a file is
+// collective on comm, so every rank of comm must open the same files in the
+// same order (the meshLoadReferenceNodes* loaders pass mesh->comm).
+FILE *meshOpenReferenceFile(const char *fileName, MPI_Comm comm){
+
+  for(int n=0;n<NreferenceFiles;++n)
+    if(!strcmp(referenceFiles[n].fileName, fileName))
+      return fmemopen(referenceFiles[n].data, referenceFiles[n].bytes, "r");
+
+  int initialized;
+  MPI_Initialized(&initialized);
+
+  int rank = 0;
+  if(initialized) MPI_Comm_rank(comm, &rank);
+
+  long bytes = -1;
+  char *data = NULL;
+
+  if(rank==0){
+    FILE *fp = fopen(fileName, "r");
+    if(fp){
+      fseek(fp, 0, SEEK_END);
+      bytes = ftell(fp);
+      rewind(fp);
+      data = (char*) calloc(bytes+1, sizeof(char));
+      if(fread(data, sizeof(char), bytes, fp)!=(size_t)bytes) bytes = -1;
+      fclose(fp);
+    }
+  }
+
+  if(initialized) MPI_Bcast(&bytes, 1, MPI_LONG, 0, comm);
+
+  if(bytes<0){
+    free(data);
+    return NULL;
+  }
+
+  if(rank) data = (char*) calloc(bytes+1, sizeof(char));
+  if(initialized) MPI_Bcast(data, (int) bytes, MPI_CHAR, 0, comm);
+
+  referenceFiles = (referenceFile_t*) realloc(referenceFiles, (NreferenceFiles+1)*sizeof(referenceFile_t));
+  referenceFile_t *file = referenceFiles + NreferenceFiles++;
+  strcpy(file->fileName, fileName);
+  file->data = data;
+  file->bytes = bytes;
+
+  return fmemopen(data, bytes, "r");
+}
+
 void readDfloatArray(FILE *fp, const char *label, dfloat **A, int *Nrows, int* Ncols){
 
   char buf[BUFSIZ];
@@ -0,0 +1,221 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Exercises the hlong=64 build with global ids that do not fit in 32 bits.
+
+  ogs:       each rank owns a strip of Nlocal nodes in a periodic chain whose
+             end nodes are shared with the neighboring ranks. The global ids
+             are offset by idBase (> 2^31), so every id handed to ogsSetup
+             overflows a 32-bit integer. Gather-scattering a vector of ones
+             must reproduce the node degree (1/invDegree).
+
+  parALMOND: a shifted 1D Laplacian, distributed in rank strips, is set up
+             from hlong COO triplets and solved with the AMG-preconditioned
+             PCG (PARALMOND CYCLE = KCYCLE EXACT). The solution is checked
+             against the one used to build the right hand side.
+
+  Pass a larger AMG strip length to push the global row count past 2^31 on
+  a big enough allocation (e.g. 64 ranks x 40000000 rows).
+
+  usage: mpirun -np 4 ./ogsHlong64Test [device properties] [AMG rows per rank]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ogs.hpp"
+#include "mesh.h"
+#include "parAlmond.h"
+
+#ifndef HLONG64
+#error "ogsHlong64Test needs 64-bit global ids, build with: make hlong=64"
+#endif
+
+static const hlong idBase = 3000000000LL; // > 2^31
+
+int testOgs(dlong Nlocal, MPI_Comm comm, occa::device &device){
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  // the last node of each strip is the first node of the next rank's strip
+  dlong N = Nlocal+1;
+  hlong *ids = (hlong*) calloc(N, sizeof(hlong));
+
+  hlong Ntotal = ((hlong) Nlocal)*size;
+  for(dlong n=0;n<N;++n)
+    ids[n] = idBase + (((hlong) rank)*Nlocal + n)%Ntotal;
+
+  ogs_t *ogs = ogsSetup(N, ids, comm, 0, device);
+  free(ids);
+
+  dfloat *v = (dfloat*) calloc(N, sizeof(dfloat));
+  for(dlong n=0;n<N;++n) v[n] = 1.;
+
+  occa::memory o_v = device.malloc(N*sizeof(dfloat), v);
+  ogsGatherScatter(o_v, ogsDfloat, ogsAdd, ogs);
+  o_v.copyTo(v);
+
+  dfloat maxErr = 0;
+  for(dlong n=0;n<N;++n){
+    dfloat err = fabs(v[n]*ogs->invDegree[n] - 1.);
+    maxErr = (err>maxErr) ? err : maxErr;
+  }
+
+  dfloat globalMaxErr = 0;
+  MPI_Allreduce(&maxErr, &globalMaxErr, 1, MPI_DFLOAT, MPI_MAX, comm);
+
+  if(rank==0)
+    printf("ogs:       ids from " hlongFormat ", max degree error = %g\n", idBase, globalMaxErr);
+
+  o_v.free();
+  ogsFree(ogs);
+  free(v);
+
+  return (globalMaxErr>1e-12);
+}
+
+// exact solution used to build the right hand side
+static dfloat uExact(hlong i){ return sin(1e-3*(i%100000)); }
+
+int testAmg(dlong Nlocal, MPI_Comm comm, occa::device &device){
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const dfloat shift = 0.1;
+
+  hlong *globalStarts = (hlong*) calloc(size+1, sizeof(hlong));
+  for(int r=0;r<size;++r)
+    globalStarts[r+1] = globalStarts[r] + Nlocal;
+
+  hlong Ntotal = globalStarts[size];
+  hlong offset = globalStarts[rank];
+
+  // tridiag(-1, 2+shift, -1) with Dirichlet ends, COO row sorted
+  dlong nnz = 0;
+  hlong  *Ai = (hlong*)  calloc(3*Nlocal, sizeof(hlong));
+  hlong  *Aj = (hlong*)  calloc(3*Nlocal, sizeof(hlong));
+  dfloat *Av = (dfloat*) calloc(3*Nlocal, sizeof(dfloat));
+  dfloat *b  = (dfloat*) calloc(Nlocal, sizeof(dfloat));
+  dfloat *x  = (dfloat*) calloc(Nlocal, sizeof(dfloat));
+
+  for(dlong n=0;n<Nlocal;++n){
+    hlong i = offset + n;
+
+    b[n] = (2.+shift)*uExact(i);
+    if(i>0)        { Ai[nnz] = i; Aj[nnz] = i-1; Av[nnz++] = -1.; b[n] -= uExact(i-1); }
+                     Ai[nnz] = i; Aj[nnz] = i;   Av[nnz++] = 2.+shift;
+    if(i<Ntotal-1) { Ai[nnz] = i; Aj[nnz] = i+1; Av[nnz++] = -1.; b[n] -= uExact(i+1); }
+  }
+
+  setupAide options;
+  options.setArgs("PARALMOND CYCLE", "KCYCLE EXACT");
+  options.setArgs("PARALMOND SMOOTHER", "CHEBYSHEV");
+  options.setArgs("PARALMOND CHEBYSHEV DEGREE", "2");
+  options.setArgs("PARALMOND PARTITION", "STRONGNODES");
+  options.setArgs("PARALMOND COARSE SOLVER", "PCG");
+  options.setArgs("VERBOSE", "FALSE");
+
+  // parALMOND takes the device and streams from the mesh, and builds its
+  // kernels through occaKernelBuildTurn/Done, which read mesh->rank and
+  // mesh->comm once occaKernelBuildSetup has picked the build ranks
+  mesh_t *mesh = (mesh_t*) calloc(1, sizeof(mesh_t));
+  mesh->device = device;
+  mesh->defaultStream = device.getStream();
+  mesh->dataStream = device.createStream();
+  device.setStream(mesh->defaultStream);
+  mesh->comm = comm;
+  mesh->rank = rank;
+  mesh->size = size;
+  occaKernelBuildSetup(mesh, options);
+
+  parAlmond_t *parAlmond = parAlmondInit(mesh, options);
+  parAlmondAgmgSetup(parAlmond, globalStarts, nnz, Ai, Aj, Av, false, 0.);
+
+  // the hierarchy keeps its own copy of the operator
+  free(Ai); free(Aj); free(Av);
+
+  occa::memory o_b = device.malloc(Nlocal*sizeof(dfloat), b);
+  occa::memory o_x = device.malloc(Nlocal*sizeof(dfloat), x);
+
+  parAlmondPrecon(parAlmond, o_x, o_b);
+  o_x.copyTo(x);
+
+  dfloat maxErr = 0;
+  for(dlong n=0;n<Nlocal;++n){
+    dfloat err = fabs(x[n] - uExact(offset+n));
+    maxErr = (err>maxErr) ? err : maxErr;
+  }
+
+  dfloat globalMaxErr = 0;
+  MPI_Allreduce(&maxErr, &globalMaxErr, 1, MPI_DFLOAT, MPI_MAX, comm);
+
+  if(rank==0)
+    printf("parALMOND: " hlongFormat " rows, max solution error = %g\n", Ntotal, globalMaxErr);
+
+  o_b.free();
+  o_x.free();
+  parAlmondFree(parAlmond);
+  free(parAlmond);
+  mesh->dataStream.free();
+  free(mesh);
+  free(globalStarts);
+  free(b); free(x);
+
+  return (globalMaxErr>1e-6);
+}
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  occa::device device;
+  if(argc>1)
+    device.setup(argv[1]);
+  else
+    device.setup("mode: 'Serial'");
+
+  dlong NlocalAmg = (argc>2) ? (dlong) atoll(argv[2]) : 10000;
+
+  int fail = 0;
+  fail |= testOgs(1000, comm, device);
+  fail |= testAmg(NlocalAmg, comm, device);
+
+  if(rank==0)
+    printf("ogsHlong64Test: %s\n", fail ? "FAILED" : "PASSED");
+
+  MPI_Finalize();
+
+  return fail;
+}
@@ -0,0 +1,158 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Interleaves gatherScatter Start/Finish pairs on three ogs handles.
+
+  Each rank owns a strip of Nlocal nodes in a periodic chain whose end nodes
+  are shared with the neighboring ranks. The three handles use different
+  strip lengths and node duplication, so their halo sizes differ. Gather-
+  scattering a vector of ones must reproduce the node degree (1/invDegree)
+  no matter how the Start/Finish calls of the handles are interleaved.
+
+  usage: mpirun -np 4 ./ogsInterleaveTest [device properties]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ogs.hpp"
+
+ogs_t *setupChain(dlong Nlocal, int Ncopies, MPI_Comm comm, occa::device &device){
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  // nodes are duplicated Ncopies times locally, the last node of each strip
+  //  is the first node of the next rank's strip
+  dlong N = (Nlocal+1)*Ncopies;
+  hlong *ids = (hlong*) calloc(N, sizeof(hlong));
+
+  hlong Ntotal = ((hlong) Nlocal)*size;
+  for(int c=0;c<Ncopies;++c)
+    for(dlong n=0;n<=Nlocal;++n)
+      ids[c*(Nlocal+1)+n] = 1 + (((hlong) rank)*Nlocal + n)%Ntotal;
+
+  ogs_t *ogs = ogsSetup(N, ids, comm, 0, device);
+
+  free(ids);
+
+  return ogs;
+}
+
+dfloat checkDegree(ogs_t *ogs, occa::memory &o_v){
+
+  dfloat *v = (dfloat*) calloc(ogs->N, sizeof(dfloat));
+  o_v.copyTo(v);
+
+  dfloat maxErr = 0;
+  for(dlong n=0;n<ogs->N;++n){
+    dfloat err = fabs(v[n]*ogs->invDegree[n] - 1.);
+    maxErr = (err>maxErr) ? err : maxErr;
+  }
+  free(v);
+
+  dfloat globalMaxErr = 0;
+  MPI_Allreduce(&maxErr, &globalMaxErr, 1, MPI_DFLOAT, MPI_MAX, ogs->comm);
+
+  return globalMaxErr;
+}
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  int rank;
+  MPI_Comm_rank(comm, &rank);
+
+  occa::device device;
+  if(argc>1)
+    device.setup(argv[1]);
+  else
+    device.setup("mode: 'Serial'");
+
+  const int Nhandles = 3;
+  dlong Nlocal[Nhandles]  = {1000, 257, 31};
+  int   Ncopies[Nhandles] = {1, 2, 3};
+
+  ogs_t *ogs[Nhandles];
+  occa::memory o_v[Nhandles];
+
+  for(int h=0;h<Nhandles;++h){
+    ogs[h] = setupChain(Nlocal[h], Ncopies[h], comm, device);
+
+    dfloat *ones = (dfloat*) calloc(ogs[h]->N, sizeof(dfloat));
+    for(dlong n=0;n<ogs[h]->N;++n) ones[n] = 1.;
+    o_v[h] = device.malloc(ogs[h]->N*sizeof(dfloat), ones);
+    free(ones);
+  }
+
+  const char *modes[3] = {ogsHaloGslib, ogsHaloPinned, ogsHaloGpuAware};
+  const int Nmodes = (argc>2) ? 3 : 2; // only test GPU-aware MPI when asked
+
+  int fail = 0;
+  for(int m=0;m<Nmodes;++m){
+
+    for(int h=0;h<Nhandles;++h){
+      ogsSetHaloExchange(ogs[h], modes[m]);
+
+      dfloat *ones = (dfloat*) calloc(ogs[h]->N, sizeof(dfloat));
+      for(dlong n=0;n<ogs[h]->N;++n) ones[n] = 1.;
+      o_v[h].copyFrom(ones);
+      free(ones);
+    }
+
+    // start all three, finish in a different order
+    ogsGatherScatterStart (o_v[0], ogsDfloat, ogsAdd, ogs[0]);
+    ogsGatherScatterStart (o_v[1], ogsDfloat, ogsAdd, ogs[1]);
+    ogsGatherScatterStart (o_v[2], ogsDfloat, ogsAdd, ogs[2]);
+
+    ogsGatherScatterFinish(o_v[1], ogsDfloat, ogsAdd, ogs[1]);
+    ogsGatherScatterFinish(o_v[2], ogsDfloat, ogsAdd, ogs[2]);
+    ogsGatherScatterFinish(o_v[0], ogsDfloat, ogsAdd, ogs[0]);
+
+    for(int h=0;h<Nhandles;++h){
+      dfloat err = checkDegree(ogs[h], o_v[h]);
+      if(err>1e-12) fail = 1;
+      if(rank==0)
+        printf("halo exchange %9s, handle %d: max degree error = %g\n", modes[m], h, err);
+    }
+  }
+
+  if(rank==0)
+    printf("ogsInterleaveTest: %s\n", fail ? "FAILED" : "PASSED");
+
+  for(int h=0;h<Nhandles;++h){
+    o_v[h].free();
+    ogsFree(ogs[h]);
+  }
+
+  MPI_Finalize();
+
+  return fail;
+}
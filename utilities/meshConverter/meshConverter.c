@@ -0,0 +1,344 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Converts a gmsh mesh into the native binary format read by
+  meshParallelReaderBinary (see include/meshBinary.h).
+
+  Accepts gmsh 2.2 ASCII and gmsh 4.1 ASCII or binary files. The conversion
+  is serial: it is meant to run once per mesh, ahead of the parallel runs.
+
+  usage: ./meshConverter <Tri2D|Quad2D|Tri3D|Quad3D|Tet3D|Hex3D> input.msh output.bmsh
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <map>
+
+#include "meshBinary.h"
+
+typedef struct {
+  const char *name;
+  int dim, elementType, faceType, Nverts, NfaceVertices;
+} meshKind_t;
+
+static const meshKind_t meshKinds[] = {
+  {"Tri2D",  2, 2, 1, 3, 2},
+  {"Quad2D", 2, 3, 1, 4, 2},
+  {"Tri3D",  3, 2, 1, 3, 2},
+  {"Quad3D", 3, 3, 1, 4, 2},
+  {"Tet3D",  3, 4, 2, 4, 3},
+  {"Hex3D",  3, 5, 3, 8, 4}
+};
+
+// nodes per gmsh element type (0 if unknown)
+static int gmshNodesPerElement(int type){
+  static const int Nnodes[32] = {0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1,
+                                 8, 20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56};
+  if(type>0 && type<32) return Nnodes[type];
+  if(type==92) return 64;
+  if(type==93) return 125;
+  return 0;
+}
+
+/* gmsh input, values are either parsed (ASCII) or copied (binary) */
+typedef struct {
+  FILE *fp;
+  int binary;
+} gmshFile_t;
+
+static void gmshError(const char *message){
+  printf("meshConverter: %s\n", message);
+  exit(-1);
+}
+
+static int readInt(gmshFile_t *gf){
+  int v = 0;
+  if(gf->binary) { if(fread(&v, sizeof(int), 1, gf->fp)!=1) gmshError("unexpected end of file"); }
+  else if(fscanf(gf->fp, "%d", &v)!=1) gmshError("could not parse integer");
+  return v;
+}
+
+static long long int readSize(gmshFile_t *gf){
+  if(gf->binary){
+    size_t v = 0;
+    if(fread(&v, sizeof(size_t), 1, gf->fp)!=1) gmshError("unexpected end of file");
+    return (long long int) v;
+  }
+  long long int v = 0;
+  if(fscanf(gf->fp, "%lld", &v)!=1) gmshError("could not parse integer");
+  return v;
+}
+
+static double readDouble(gmshFile_t *gf){
+  double v = 0;
+  if(gf->binary) { if(fread(&v, sizeof(double), 1, gf->fp)!=1) gmshError("unexpected end of file"); }
+  else if(fscanf(gf->fp, "%lf", &v)!=1) gmshError("could not parse number");
+  return v;
+}
+
+// position the file just after the next line containing section
+static int findSection(FILE *fp, const char *section){
+  char buf[BUFSIZ];
+  while(fgets(buf, BUFSIZ, fp))
+    if(strstr(buf, section)) return 1;
+  return 0;
+}
+
+typedef struct {
+  std::vector<double> VX, VY, VZ;          // node coordinates
+  std::map<long long int, int64_t> index;  // gmsh node tag -> 0-based vertex id
+
+  std::vector<int64_t> elements;           // tag, v[Nverts]
+  std::vector<int64_t> faces;              // tag, v[NfaceVertices]
+} meshData_t;
+
+static int64_t vertexId(meshData_t &mesh, long long int tag){
+  std::map<long long int,int64_t>::iterator it = mesh.index.find(tag);
+  if(it==mesh.index.end()) gmshError("element references a missing node");
+  return it->second;
+}
+
+static void addNode(meshData_t &mesh, long long int tag, double x, double y, double z){
+  mesh.index[tag] = (int64_t) mesh.VX.size();
+  mesh.VX.push_back(x);
+  mesh.VY.push_back(y);
+  mesh.VZ.push_back(z);
+}
+
+static void addElement(meshData_t &mesh, const meshKind_t &kind,
+                       int type, int tag, long long int *nodes){
+  if(type==kind.elementType){
+    mesh.elements.push_back(tag);
+    for(int n=0;n<kind.Nverts;++n) mesh.elements.push_back(vertexId(mesh, nodes[n]));
+  }
+  if(type==kind.faceType){
+    mesh.faces.push_back(tag);
+    for(int n=0;n<kind.NfaceVertices;++n) mesh.faces.push_back(vertexId(mesh, nodes[n]));
+  }
+}
+
+/* gmsh 2.2 ASCII: tags are stored on each element, the first is the physical tag */
+static void readGmsh2(gmshFile_t *gf, meshData_t &mesh, const meshKind_t &kind){
+
+  if(!findSection(gf->fp, "$Nodes")) gmshError("no $Nodes section");
+  long long int Nnodes = readSize(gf);
+  for(long long int n=0;n<Nnodes;++n){
+    long long int tag = readSize(gf);
+    double x = readDouble(gf), y = readDouble(gf), z = readDouble(gf);
+    addNode(mesh, tag, x, y, z);
+  }
+
+  if(!findSection(gf->fp, "$Elements")) gmshError("no $Elements section");
+  long long int Nelements = readSize(gf);
+  long long int nodes[125];
+  for(long long int n=0;n<Nelements;++n){
+    readSize(gf); // element tag
+    int type  = readInt(gf);
+    int Ntags = readInt(gf);
+    int physical = 0;
+    for(int t=0;t<Ntags;++t){
+      int tag = readInt(gf);
+      if(t==0) physical = tag;
+    }
+    int Nn = gmshNodesPerElement(type);
+    if(!Nn) gmshError("unknown gmsh element type");
+    for(int v=0;v<Nn;++v) nodes[v] = readSize(gf);
+    addElement(mesh, kind, type, physical, nodes);
+  }
+}
+
+/* gmsh 4.1: physical tags live on the geometric entities */
+static void readGmsh4(gmshFile_t *gf, meshData_t &mesh, const meshKind_t &kind){
+
+  std::map<std::pair<int,int>,int> physical; // (dim, entity tag) -> first physical tag
+
+  if(findSection(gf->fp, "$Entities")){
+    long long int Nentities[4];
+    for(int d=0;d<4;++d) Nentities[d] = readSize(gf);
+
+    for(int d=0;d<4;++d){
+      for(long long int n=0;n<Nentities[d];++n){
+        int tag = readInt(gf);
+        int Nbox = (d==0) ? 3 : 6;
+        for(int b=0;b<Nbox;++b) readDouble(gf);
+
+        long long int Nphysical = readSize(gf);
+        int first = 0;
+        for(long long int p=0;p<Nphysical;++p){
+          int ptag = readInt(gf);
+          if(p==0) first = ptag;
+        }
+        physical[std::make_pair(d,tag)] = first;
+
+        if(d>0){ // bounding entities
+          long long int Nbounding = readSize(gf);
+          for(long long int b=0;b<Nbounding;++b) readInt(gf);
+        }
+      }
+    }
+  }
+  rewind(gf->fp);
+
+  if(!findSection(gf->fp, "$Nodes")) gmshError("no $Nodes section");
+  long long int Nblocks = readSize(gf);
+  readSize(gf); // number of nodes
+  readSize(gf); // min node tag
+  readSize(gf); // max node tag
+  for(long long int b=0;b<Nblocks;++b){
+    int entityDim = readInt(gf);
+    readInt(gf); // entity tag
+    int parametric = readInt(gf);
+    long long int Nn = readSize(gf);
+
+    std::vector<long long int> tags(Nn);
+    for(long long int n=0;n<Nn;++n) tags[n] = readSize(gf);
+    for(long long int n=0;n<Nn;++n){
+      double x = readDouble(gf), y = readDouble(gf), z = readDouble(gf);
+      if(parametric) for(int u=0;u<entityDim;++u) readDouble(gf);
+      addNode(mesh, tags[n], x, y, z);
+    }
+  }
+
+  if(!findSection(gf->fp, "$Elements")) gmshError("no $Elements section");
+  Nblocks = readSize(gf);
+  readSize(gf); // number of elements
+  readSize(gf); // min element tag
+  readSize(gf); // max element tag
+  long long int nodes[125];
+  for(long long int b=0;b<Nblocks;++b){
+    int entityDim = readInt(gf);
+    int entityTag = readInt(gf);
+    int type = readInt(gf);
+    long long int Nin = readSize(gf);
+
+    int Nn = gmshNodesPerElement(type);
+    if(!Nn) gmshError("unknown gmsh element type");
+
+    int tag = physical.count(std::make_pair(entityDim,entityTag)) ?
+      physical[std::make_pair(entityDim,entityTag)] : 0;
+
+    for(long long int e=0;e<Nin;++e){
+      readSize(gf); // element tag
+      for(int v=0;v<Nn;++v) nodes[v] = readSize(gf);
+      addElement(mesh, kind, type, tag, nodes);
+    }
+  }
+}
+
+int main(int argc, char **argv){
+
+  if(argc!=4){
+    printf("usage: ./meshConverter <Tri2D|Quad2D|Tri3D|Quad3D|Tet3D|Hex3D> input.msh output.bmsh\n");
+    exit(-1);
+  }
+
+  const meshKind_t *kind = NULL;
+  for(size_t k=0;k<sizeof(meshKinds)/sizeof(meshKind_t);++k)
+    if(!strcmp(argv[1], meshKinds[k].name)) kind = meshKinds+k;
+  if(!kind) gmshError("unknown mesh type");
+
+  gmshFile_t gf;
+  gf.fp = fopen(argv[2], "rb");
+  if(!gf.fp) gmshError("could not open input file");
+
+  /* $MeshFormat: version file-type data-size */
+  if(!findSection(gf.fp, "$MeshFormat")) gmshError("no $MeshFormat section");
+  double version;
+  int fileType, dataSize;
+  if(fscanf(gf.fp, "%lf %d %d", &version, &fileType, &dataSize)!=3)
+    gmshError("could not parse $MeshFormat");
+  fgetc(gf.fp); // end of line
+
+  gf.binary = fileType;
+  if(gf.binary){
+    if(dataSize!=sizeof(size_t)) gmshError("binary files must use 8 byte sizes");
+    int one;
+    if(fread(&one, sizeof(int), 1, gf.fp)!=1 || one!=1)
+      gmshError("binary file was written with a different byte order");
+  }
+
+  meshData_t mesh;
+  if(version>=4.1 && version<5)
+    readGmsh4(&gf, mesh, *kind);
+  else if(version>=2 && version<3 && !gf.binary)
+    readGmsh2(&gf, mesh, *kind);
+  else
+    gmshError("supported formats are gmsh 2.2 ASCII and gmsh 4.1 ASCII/binary");
+  fclose(gf.fp);
+
+  meshBinaryHeader_t header;
+  memset(&header, 0, sizeof(meshBinaryHeader_t));
+  memcpy(header.magic, MESH_BINARY_MAGIC, 8);
+  header.byteOrder      = 1;
+  header.version        = MESH_BINARY_VERSION;
+  header.dim            = kind->dim;
+  header.elementType    = kind->elementType;
+  header.faceType       = kind->faceType;
+  header.Nverts         = kind->Nverts;
+  header.NfaceVertices  = kind->NfaceVertices;
+  header.Nnodes         = (int64_t) mesh.VX.size();
+  header.Nelements      = (int64_t) (mesh.elements.size()/(1+kind->Nverts));
+  header.NboundaryFaces = (int64_t) (mesh.faces.size()/(1+kind->NfaceVertices));
+  header.elementOffset  = sizeof(meshBinaryHeader_t);
+  header.boundaryOffset = header.elementOffset + header.Nelements*meshBinaryElementBytes(kind->Nverts);
+
+  if(!header.Nelements) gmshError("no elements of the requested type");
+
+  FILE *fp = fopen(argv[3], "wb");
+  if(!fp) gmshError("could not open output file");
+
+  fwrite(&header, sizeof(meshBinaryHeader_t), 1, fp);
+
+  int Nverts = kind->Nverts;
+  std::vector<char> record(meshBinaryElementBytes(Nverts));
+  for(int64_t e=0;e<header.Nelements;++e){
+    int64_t *ids = (int64_t*) record.data();
+    double *xyz  = (double*) (record.data() + (1+Nverts)*sizeof(int64_t));
+
+    memcpy(ids, mesh.elements.data()+e*(1+Nverts), (1+Nverts)*sizeof(int64_t));
+    for(int n=0;n<Nverts;++n){
+      int64_t v = ids[1+n];
+      xyz[3*n+0] = mesh.VX[v];
+      xyz[3*n+1] = mesh.VY[v];
+      xyz[3*n+2] = mesh.VZ[v];
+    }
+    fwrite(record.data(), 1, record.size(), fp);
+  }
+
+  if(header.NboundaryFaces)
+    fwrite(mesh.faces.data(), sizeof(int64_t), mesh.faces.size(), fp);
+
+  fclose(fp);
+
+  printf("meshConverter: wrote %lld elements, %lld boundary faces, %lld nodes to %s\n",
+         (long long int) header.Nelements, (long long int) header.NboundaryFaces,
+         (long long int) header.Nnodes, argv[3]);
+
+  return 0;
+}
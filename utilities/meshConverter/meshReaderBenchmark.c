@@ -0,0 +1,138 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Compares mesh startup time of the gmsh readers against the native
+  binary reader on the same mesh:
+
+  ./meshConverter Hex3D mesh.msh mesh.bmsh
+  mpirun -np 64 ./meshReaderBenchmark Hex3D mesh.msh mesh.bmsh
+
+  Each file is read Ntrials times. The reported time is the slowest rank's,
+  since that is what every rank waits for before the setup can continue.
+  The two readers must also agree on every rank's elements.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mesh2D.h"
+#include "mesh3D.h"
+
+typedef mesh_t* (*meshReader_t)(char *fileName);
+
+static void meshFreeRead(mesh_t *mesh){
+  free(mesh->faceVertices);
+  free(mesh->EToV);
+  free(mesh->elementInfo);
+  free(mesh->boundaryInfo);
+  free(mesh->EX);
+  free(mesh->EY);
+  free(mesh->EZ);
+  free(mesh);
+}
+
+static double timeReader(meshReader_t reader, char *fileName, int Ntrials, mesh_t **mesh){
+
+  double maxElapsed = 0;
+  for(int t=0;t<Ntrials;++t){
+    if(*mesh) meshFreeRead(*mesh);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double tic = MPI_Wtime();
+
+    *mesh = reader(fileName);
+
+    double elapsed = MPI_Wtime()-tic, globalElapsed;
+    MPI_Allreduce(&elapsed, &globalElapsed, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    maxElapsed += globalElapsed;
+  }
+  return maxElapsed/Ntrials;
+}
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  int rank, size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  if(argc<4){
+    if(rank==0)
+      printf("usage: ./meshReaderBenchmark <Tri2D|Quad2D|Tri3D|Quad3D|Tet3D|Hex3D> mesh.msh mesh.bmsh [Ntrials]\n");
+    MPI_Finalize();
+    exit(-1);
+  }
+
+  meshReader_t reader = NULL;
+  if(!strcmp(argv[1], "Tri2D"))  reader = meshParallelReaderTri2D;
+  if(!strcmp(argv[1], "Quad2D")) reader = meshParallelReaderQuad2D;
+  if(!strcmp(argv[1], "Tri3D"))  reader = meshParallelReaderTri3D;
+  if(!strcmp(argv[1], "Quad3D")) reader = meshParallelReaderQuad3D;
+  if(!strcmp(argv[1], "Tet3D"))  reader = meshParallelReaderTet3D;
+  if(!strcmp(argv[1], "Hex3D"))  reader = meshParallelReaderHex3D;
+  if(!reader){
+    if(rank==0) printf("meshReaderBenchmark: unknown mesh type %s\n", argv[1]);
+    MPI_Finalize();
+    exit(-1);
+  }
+
+  int Ntrials = (argc>4) ? atoi(argv[4]) : 3;
+
+  mesh_t *gmshMesh = NULL, *binaryMesh = NULL;
+  double gmshTime   = timeReader(reader, argv[2], Ntrials, &gmshMesh);
+  double binaryTime = timeReader(reader, argv[3], Ntrials, &binaryMesh);
+
+  /* both readers must hand out the same elements */
+  int mismatch = (gmshMesh->Nelements!=binaryMesh->Nelements)
+    || (gmshMesh->NboundaryFaces!=binaryMesh->NboundaryFaces);
+  for(dlong n=0;!mismatch && n<gmshMesh->Nelements*gmshMesh->Nverts;++n)
+    mismatch = (gmshMesh->EToV[n]!=binaryMesh->EToV[n])
+      || (gmshMesh->EX[n]!=binaryMesh->EX[n])
+      || (gmshMesh->EY[n]!=binaryMesh->EY[n]);
+
+  int globalMismatch;
+  MPI_Allreduce(&mismatch, &globalMismatch, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+  hlong Nelements = gmshMesh->Nelements, globalNelements;
+  MPI_Allreduce(&Nelements, &globalNelements, 1, MPI_HLONG, MPI_SUM, MPI_COMM_WORLD);
+
+  if(rank==0){
+    printf("%d ranks, " hlongFormat " elements, %d trials\n", size, globalNelements, Ntrials);
+    printf("gmsh   reader: %8.4f s\n", gmshTime);
+    printf("binary reader: %8.4f s (%.1fx)\n", binaryTime, gmshTime/binaryTime);
+    printf("meshReaderBenchmark: %s\n", globalMismatch ? "MISMATCH" : "readers agree");
+  }
+
+  meshFreeRead(gmshMesh);
+  meshFreeRead(binaryMesh);
+
+  MPI_Finalize();
+
+  return globalMismatch;
+}
@@ -0,0 +1,175 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Weak scaling benchmark for parallelSort (sample sort) against the
+  odd-even merge sort it replaced.
+
+  Each rank sorts N capsules laid out like the hex element_t used by
+  meshGeometricPartition3D (240 bytes) with random Morton-like keys.
+  Run it at a growing number of ranks to see the scaling:
+
+  mpirun -np 16   ./parallelSortBenchmark 20000
+  mpirun -np 256  ./parallelSortBenchmark 20000
+
+  The odd-even sort needs O(size) exchange rounds, so it is skipped above
+  maxOddEvenRanks ranks unless asked for: ./parallelSortBenchmark N 1
+*/
+
+#include "partition.h"
+
+#define maxOddEvenRanks 512
+
+typedef struct {
+
+  unsigned long long int index;
+
+  dlong element;
+  int type;
+
+  hlong v[8];
+  dfloat EX[8], EY[8], EZ[8];
+
+}benchElement_t;
+
+static int compareBenchElements(const void *a, const void *b){
+
+  benchElement_t *ea = (benchElement_t*) a;
+  benchElement_t *eb = (benchElement_t*) b;
+
+  if(ea->index < eb->index) return -1;
+  if(ea->index > eb->index) return  1;
+
+  return 0;
+}
+
+static void bogusMatchBench(void *a, void *b){ }
+
+static void fillElements(int rank, int N, benchElement_t *elements){
+
+  srand48(12345+rank);
+  for(int n=0;n<N;++n){
+    elements[n].index = (unsigned long long int) (drand48()*(1ULL<<62));
+    elements[n].element = n;
+    elements[n].type = rank;
+  }
+}
+
+// returns 1 if the capsules are sorted within and across ranks and none were lost
+static int checkSorted(int size, int rank, MPI_Comm comm, int N, benchElement_t *elements,
+                       unsigned long long int checksum){
+
+  int fail = 0;
+  unsigned long long int sum = 0;
+  for(int n=0;n<N;++n){
+    sum += elements[n].index;
+    if(n && elements[n-1].index>elements[n].index) fail = 1;
+  }
+
+  // last key of the previous rank must not exceed our first key
+  unsigned long long int last = N ? elements[N-1].index : 0, prevLast = 0;
+  MPI_Sendrecv(&last, 1, MPI_UNSIGNED_LONG_LONG, (rank+1)%size, 0,
+               &prevLast, 1, MPI_UNSIGNED_LONG_LONG, (rank+size-1)%size, 0,
+               comm, MPI_STATUS_IGNORE);
+  if(rank>0 && N && prevLast>elements[0].index) fail = 1;
+
+  unsigned long long int globalSum = 0;
+  MPI_Allreduce(&sum, &globalSum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+  if(globalSum!=checksum) fail = 1;
+
+  int globalFail = 0;
+  MPI_Allreduce(&fail, &globalFail, 1, MPI_INT, MPI_MAX, comm);
+
+  return !globalFail;
+}
+
+typedef void (*sorter_t)(int, int, MPI_Comm, int, void*, size_t,
+                         int (*)(const void *, const void *),
+                         void (*)(void *, void *));
+
+static double timeSort(sorter_t sorter, int size, int rank, MPI_Comm comm, int N,
+                       benchElement_t *elements, int *sorted){
+
+  fillElements(rank, N, elements);
+
+  unsigned long long int sum = 0, checksum = 0;
+  for(int n=0;n<N;++n) sum += elements[n].index;
+  MPI_Allreduce(&sum, &checksum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+
+  MPI_Barrier(comm);
+  double tic = MPI_Wtime();
+
+  sorter(size, rank, comm, N, elements, sizeof(benchElement_t),
+         compareBenchElements, bogusMatchBench);
+
+  double elapsed = MPI_Wtime()-tic, maxElapsed;
+  MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+  *sorted = checkSorted(size, rank, comm, N, elements, checksum);
+
+  return maxElapsed;
+}
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  // the odd-even sort assumes N is even
+  int N = (argc>1) ? atoi(argv[1]) : 20000;
+  N += N%2;
+
+  int forceOddEven = (argc>2) ? atoi(argv[2]) : 0;
+
+  benchElement_t *elements = (benchElement_t*) calloc(N, sizeof(benchElement_t));
+
+  int sampleSorted = 0, oddEvenSorted = 1;
+  double sampleTime = timeSort(parallelSort, size, rank, comm, N, elements, &sampleSorted);
+
+  double oddEvenTime = -1;
+  if(size<=maxOddEvenRanks || forceOddEven)
+    oddEvenTime = timeSort(parallelOddEvenSort, size, rank, comm, N, elements, &oddEvenSorted);
+
+  if(rank==0){
+    printf("%d ranks, %d capsules of %d bytes per rank\n", size, N, (int) sizeof(benchElement_t));
+    printf("sample sort:   %8.4f s %s\n", sampleTime, sampleSorted ? "" : "(NOT SORTED)");
+    if(oddEvenTime>=0)
+      printf("odd-even sort: %8.4f s %s\n", oddEvenTime, oddEvenSorted ? "" : "(NOT SORTED)");
+    else
+      printf("odd-even sort: skipped above %d ranks\n", maxOddEvenRanks);
+  }
+
+  free(elements);
+
+  MPI_Finalize();
+
+  return !(sampleSorted && oddEvenSorted);
+}
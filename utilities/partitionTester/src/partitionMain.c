@@ -64,6 +64,24 @@ int main(int argc, char **argv){
 
   // set up
   partitionSetup(mesh);
+
+  // rerun global node numbering with the halo variant and compare
+  dlong Ntotal = mesh->Np*mesh->Nelements;
+  hlong *sortIds = (hlong*) calloc(Ntotal, sizeof(hlong));
+  memcpy(sortIds, mesh->globalIds, Ntotal*sizeof(hlong));
+  free(mesh->globalIds);
+
+  meshParallelConnectNodesHalo(mesh);
+
+  hlong Nmismatch = 0, NmismatchTotal = 0;
+  for(dlong n=0;n<Ntotal;++n)
+    Nmismatch += (sortIds[n]!=mesh->globalIds[n]);
+  MPI_Allreduce(&Nmismatch, &NmismatchTotal, 1, MPI_HLONG, MPI_SUM, mesh->comm);
+  if(mesh->rank==0)
+    printf("global node numbering: " hlongFormat " mismatched ids between variants\n", NmismatchTotal);
+
+  meshPartitionStatistics(mesh);
+  free(sortIds);
   
   // plot mesh file
   int rank;
@@ -0,0 +1,118 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+/*
+  Start up cost of loading the reference node files, as the multigrid
+  setup does for degrees N down to 1, with every rank opening and parsing
+  the ASCII files itself against rank 0 reading them once and broadcasting
+  (meshOpenReferenceFile). The last column reloads the same degrees,
+  which then come from the in memory copy.
+
+  mpirun -np 1024 ./referenceNodesBenchmark tet 5
+*/
+
+#include "partition.h"
+
+// parse every labelled array in the file, like the meshLoadReferenceNodes* routines
+static void parseReferenceFile(FILE *fp){
+
+  char buf[BUFSIZ];
+  char labels[256][BUFSIZ];
+  int Nlabels = 0;
+
+  rewind(fp);
+  while(fgets(buf, BUFSIZ, fp) && Nlabels<256){
+    if(('A'<=buf[0] && buf[0]<='Z') || ('a'<=buf[0] && buf[0]<='z')){
+      buf[strcspn(buf, "\r\n")] = 0;
+      strcpy(labels[Nlabels++], buf);
+    }
+  }
+
+  for(int n=0;n<Nlabels;++n){
+    dfloat *A;
+    int Nrows, Ncols;
+    readDfloatArray(fp, labels[n], &A, &Nrows, &Ncols);
+    free(A);
+  }
+}
+
+static double timeLoad(const char *type, int N, int broadcast, MPI_Comm comm){
+
+  MPI_Barrier(comm);
+  double tic = MPI_Wtime();
+
+  for(int n=N;n>=1;--n){
+    char fname[BUFSIZ];
+    sprintf(fname, DHOLMES "/nodes/%sN%02d.dat", type, n);
+
+    FILE *fp = broadcast ? meshOpenReferenceFile(fname, comm) : fopen(fname, "r");
+    if(!fp){
+      printf("ERROR: Cannot open file: '%s'\n", fname);
+      MPI_Abort(comm, -1);
+    }
+    parseReferenceFile(fp);
+    fclose(fp);
+  }
+
+  double elapsed = MPI_Wtime()-tic, maxElapsed;
+  MPI_Allreduce(&elapsed, &maxElapsed, 1, MPI_DOUBLE, MPI_MAX, comm);
+
+  return maxElapsed;
+}
+
+int main(int argc, char **argv){
+
+  MPI_Init(&argc, &argv);
+
+  MPI_Comm comm = MPI_COMM_WORLD;
+
+  int rank, size;
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &size);
+
+  const char *elementType = (argc>1) ? argv[1] : "tri";
+  int N = (argc>2) ? atoi(argv[2]) : 8;
+
+  const char *type = "triangle";
+  if(!strcmp(elementType, "quad")) type = "quadrilateral";
+  if(!strcmp(elementType, "tet"))  type = "tet";
+  if(!strcmp(elementType, "hex"))  type = "hex";
+
+  double perRankTime   = timeLoad(type, N, 0, comm);
+  double broadcastTime = timeLoad(type, N, 1, comm);
+  double cachedTime    = timeLoad(type, N, 1, comm);
+
+  if(rank==0){
+    printf("%d ranks, %s nodes for degrees %d..1\n", size, type, N);
+    printf("every rank reads:    %8.4f s\n", perRankTime);
+    printf("rank 0 + broadcast:  %8.4f s\n", broadcastTime);
+    printf("cached reload:       %8.4f s\n", cachedTime);
+  }
+
+  MPI_Finalize();
+
+  return 0;
+}